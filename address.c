@@ -79,15 +79,23 @@ mk_address(ds_addr_t *pAddr, int nColumn)
 		nRegion;
 	char *szZipPrefix,
 		szAddr[100];
-	static int nMaxCities,
+	static THREAD int nMaxCities,
       nMaxCounties,
 		bInit = 0;
+	static THREAD d_idx_t *pStreetNames,
+		*pStreetType,
+		*pCities,
+		*pCounties;
    tdef *pTdef;
 		
 	if (!bInit)
 	{
       nMaxCities = (int)get_rowcount(ACTIVE_CITIES);
       nMaxCounties = (int)get_rowcount(ACTIVE_COUNTIES);
+		pStreetNames = find_dist("street_names");
+		pStreetType = find_dist("street_type");
+		pCities = find_dist("cities");
+		pCounties = find_dist("fips_county");
 		bInit = 1;
 	}
 	
@@ -95,11 +103,11 @@ mk_address(ds_addr_t *pAddr, int nColumn)
 	genrand_integer(&pAddr->street_num, DIST_UNIFORM, 1, 1000, 0, nColumn);
 
 	/* street names are picked from a distribution */
-	pick_distribution(&pAddr->street_name1, "street_names",1, 1, nColumn);
-	pick_distribution(&pAddr->street_name2, "street_names", 1, 2, nColumn);
+	pick_distribution_idx(&pAddr->street_name1, pStreetNames, 1, 1, nColumn);
+	pick_distribution_idx(&pAddr->street_name2, pStreetNames, 1, 2, nColumn);
 
 	/* street type is picked from a distribution */
-	pick_distribution(&pAddr->street_type, "street_type", 1, 1, nColumn);
+	pick_distribution_idx(&pAddr->street_type, pStreetType, 1, 1, nColumn);
 
 	/* suite number is alphabetic 50% of the time */
 	genrand_integer(&i, DIST_UNIFORM, 1, 100, 0, nColumn);
@@ -119,10 +127,10 @@ mk_address(ds_addr_t *pAddr, int nColumn)
    {
       i = (int)get_rowcount(getTableFromColumn(nColumn));
       genrand_integer(&i, DIST_UNIFORM, 1, (nMaxCities > i)?i:nMaxCities, 0, nColumn);
-		dist_member(&pAddr->city, "cities", i, 1);	
+		dist_member_idx(&pAddr->city, pCities, i, 1);	
    }
 	else
-		pick_distribution(&pAddr->city, "cities", 1, 6, nColumn);
+		pick_distribution_idx(&pAddr->city, pCities, 1, 6, nColumn);
 	
 
 	/* county is picked from a distribution, based on population and keys the rest */
@@ -130,18 +138,18 @@ mk_address(ds_addr_t *pAddr, int nColumn)
    {
       i = (int)get_rowcount(getTableFromColumn(nColumn));
       genrand_integer(&nRegion, DIST_UNIFORM, 1, (nMaxCounties > i)?i:nMaxCounties, 0, nColumn);
-		dist_member(&pAddr->county, "fips_county", nRegion, 2);	
+		dist_member_idx(&pAddr->county, pCounties, nRegion, 2);	
    }
    else
-      nRegion = pick_distribution(&pAddr->county, "fips_county", 2, 1, nColumn);
+      nRegion = pick_distribution_idx(&pAddr->county, pCounties, 2, 1, nColumn);
 
    /* match state with the selected region/county */
-   dist_member(&pAddr->state, "fips_county", nRegion, 3);
+   dist_member_idx(&pAddr->state, pCounties, nRegion, 3);
 	
    /* match the zip prefix with the selected region/county */
 	pAddr->zip = city_hash(0, pAddr->city);
    /* 00000 - 00600 are unused. Avoid them */
-   dist_member((void *)&szZipPrefix, "fips_county", nRegion, 5);
+   dist_member_idx((void *)&szZipPrefix, pCounties, nRegion, 5);
    if (!(szZipPrefix[0] - '0') && (pAddr->zip < 9400))
       pAddr->zip += 600;      
 	pAddr->zip += (szZipPrefix[0] - '0') * 10000;
@@ -149,7 +157,7 @@ mk_address(ds_addr_t *pAddr, int nColumn)
 	sprintf(szAddr, "%d %s %s %s", 
 		pAddr->street_num, pAddr->street_name1, pAddr->street_name2, pAddr->street_type);
 	pAddr->plus4 = city_hash(0, szAddr);
-	dist_member (&pAddr->gmt_offset, "fips_county", nRegion, 6);
+	dist_member_idx(&pAddr->gmt_offset, pCounties, nRegion, 6);
 	strcpy(pAddr->country, "United States");
 
 	return(0);
@@ -0,0 +1,942 @@
+/* 
+ * Legal Notice 
+ * 
+ * This document and associated source code (the "Work") is a part of a 
+ * benchmark specification maintained by the TPC. 
+ * 
+ * The TPC reserves all right, title, and interest to the Work as provided 
+ * under U.S. and international laws, including without limitation all patent 
+ * and trademark rights therein. 
+ * 
+ * No Warranty 
+ * 
+ * 1.1 TO THE MAXIMUM EXTENT PERMITTED BY APPLICABLE LAW, THE INFORMATION 
+ *     CONTAINED HEREIN IS PROVIDED "AS IS" AND WITH ALL FAULTS, AND THE 
+ *     AUTHORS AND DEVELOPERS OF THE WORK HEREBY DISCLAIM ALL OTHER 
+ *     WARRANTIES AND CONDITIONS, EITHER EXPRESS, IMPLIED OR STATUTORY, 
+ *     INCLUDING, BUT NOT LIMITED TO, ANY (IF ANY) IMPLIED WARRANTIES, 
+ *     DUTIES OR CONDITIONS OF MERCHANTABILITY, OF FITNESS FOR A PARTICULAR 
+ *     PURPOSE, OF ACCURACY OR COMPLETENESS OF RESPONSES, OF RESULTS, OF 
+ *     WORKMANLIKE EFFORT, OF LACK OF VIRUSES, AND OF LACK OF NEGLIGENCE. 
+ *     ALSO, THERE IS NO WARRANTY OR CONDITION OF TITLE, QUIET ENJOYMENT, 
+ *     QUIET POSSESSION, CORRESPONDENCE TO DESCRIPTION OR NON-INFRINGEMENT 
+ *     WITH REGARD TO THE WORK. 
+ * 1.2 IN NO EVENT WILL ANY AUTHOR OR DEVELOPER OF THE WORK BE LIABLE TO 
+ *     ANY OTHER PARTY FOR ANY DAMAGES, INCLUDING BUT NOT LIMITED TO THE 
+ *     COST OF PROCURING SUBSTITUTE GOODS OR SERVICES, LOST PROFITS, LOSS 
+ *     OF USE, LOSS OF DATA, OR ANY INCIDENTAL, CONSEQUENTIAL, DIRECT, 
+ *     INDIRECT, OR SPECIAL DAMAGES WHETHER UNDER CONTRACT, TORT, WARRANTY,
+ *     OR OTHERWISE, ARISING IN ANY WAY OUT OF THIS OR ANY OTHER AGREEMENT 
+ *     RELATING TO THE WORK, WHETHER OR NOT SUCH AUTHOR OR DEVELOPER HAD 
+ *     ADVANCE NOTICE OF THE POSSIBILITY OF SUCH DAMAGES. 
+ * 
+ * Contributors:
+ * Gradient Systems
+ */ 
+#include "config.h"
+#include "porting.h"
+#include <stdio.h>
+#ifndef USE_STDLIB_H
+#include <malloc.h>
+#endif
+#include "r_params.h"
+#include "tdefs.h"
+#include "decimal.h"
+#include "arrow.h"
+#include "parquet.h"
+
+/*
+ * Apache Arrow IPC stream format. Each message is a 0xFFFFFFFF continuation
+ * marker, the length of its metadata, a flatbuffer holding a Message table
+ * (padded to 8 bytes), and then the message body. The stream is a Schema 
+ * message, any number of RecordBatch messages and an 8 byte end of stream 
+ * marker. Flatbuffers are laid out front to back here: vtables precede their
+ * tables, and every object is placed after anything that refers to it, since
+ * flatbuffer offsets are unsigned.
+ */
+#define ARROW_CONTINUATION	0xFFFFFFFF
+#define ARROW_METADATA_V5	4
+#define ARROW_HEADER_SCHEMA	1
+#define ARROW_HEADER_BATCH	3
+#define ARROW_TYPE_INT		2
+#define ARROW_TYPE_UTF8		5
+#define ARROW_TYPE_DECIMAL	7
+#define ARROW_TYPE_DATE		8
+#define ARROW_TYPE_TIME		9
+#define JULIAN_1970			2440588	/* julian day of the Arrow date epoch */
+#define PAD8(n)	(((n) + 7) & ~7)
+
+static ds_key_t arPowers[MAX_DECIMAL_PRECISION + 1] = {
+	1, 10, 100, 1000, 10000, 100000, 1000000, 10000000, 100000000,
+	1000000000, 10000000000LL, 100000000000LL, 1000000000000LL,
+	10000000000000LL, 100000000000000LL, 1000000000000000LL,
+	10000000000000000LL, 100000000000000000LL, 1000000000000000000LL};
+
+/*
+* Routine: arrow_reserve(arrow_buf_t *pBuf, int nBytes, int nAlign)
+* Purpose: add nBytes of zeroes to a buffer, starting at a multiple of nAlign
+* Algorithm:
+* Data Structures:
+*
+* Params:
+* Returns: the position of the new bytes
+* Called By: 
+* Calls: 
+* Assumptions: nAlign is a power of 2
+* Side Effects:
+* TODO: None
+*/
+int
+arrow_reserve(arrow_buf_t *pBuf, int nBytes, int nAlign)
+{
+	int nPos;
+
+	nPos = (pBuf->nUsed + nAlign - 1) & ~(nAlign - 1);
+	if (nPos + nBytes > pBuf->nSize)
+	{
+		if (pBuf->nSize == 0)
+			pBuf->nSize = 64 * 1024;
+		while (nPos + nBytes > pBuf->nSize)
+			pBuf->nSize *= 2;
+		pBuf->pData = (char *)realloc(pBuf->pData, pBuf->nSize);
+		MALLOC_CHECK(pBuf->pData);
+	}
+	memset(pBuf->pData + pBuf->nUsed, 0, nPos + nBytes - pBuf->nUsed);
+	pBuf->nUsed = nPos + nBytes;
+
+	return(nPos);
+}
+
+/*
+ * little endian stores, whatever the byte order of the host
+ */
+void
+arrow_put_le(char *pDest, ds_key_t kValue, int nBytes)
+{
+	int i;
+
+	for (i=0; i < nBytes; i++)
+	{
+		pDest[i] = (char)(kValue & 0xFF);
+		kValue >>= 8;
+	}
+
+	return;
+}
+
+#define put8(b, p, v)	((b)->pData[p] = (char)(v))
+#define put16(b, p, v)	arrow_put_le((b)->pData + (p), (ds_key_t)(v), 2)
+#define put32(b, p, v)	arrow_put_le((b)->pData + (p), (ds_key_t)(v), 4)
+#define put64(b, p, v)	arrow_put_le((b)->pData + (p), (ds_key_t)(v), 8)
+/* point the offset field at nField to the object at nTarget */
+#define fb_offset(b, nField, nTarget)	put32(b, nField, (nTarget) - (nField))
+
+/*
+* Routine: fb_table(arrow_buf_t *pBuf, int nFields, int *arSize, int *arPos)
+* Purpose: lay out a flatbuffer table and its vtable
+* Algorithm: the vtable comes first, then the table; the 4 byte vtable
+*	offset that starts the table is followed by the fields in decreasing
+*	order of size, so that each is naturally aligned
+* Data Structures:
+*
+* Params: arSize: size of each field, 1, 2, 4 or 8; 0 for an absent field
+*	arPos: set to the position of each field, for the caller to fill in
+* Returns: the position of the table
+* Called By: 
+* Calls: 
+* Assumptions:
+* Side Effects:
+* TODO: None
+*/
+static int
+fb_table(arrow_buf_t *pBuf, int nFields, int *arSize, int *arPos)
+{
+	int i,
+		nWidth,
+		nVTable,
+		nTable,
+		nInline = 4,
+		bWide = 0;
+
+	for (i=0; i < nFields; i++)
+	{
+		nInline += arSize[i];
+		if (arSize[i] == 8)
+			bWide = 1;
+	}
+
+	nVTable = arrow_reserve(pBuf, 4 + 2 * nFields, 2);
+	nTable = (pBuf->nUsed + 3) & ~3;
+	if (bWide && (nTable % 8) == 0)
+		nTable += 4;
+	arrow_reserve(pBuf, nTable + nInline - pBuf->nUsed, 1);
+
+	put16(pBuf, nVTable, 4 + 2 * nFields);
+	put16(pBuf, nVTable + 2, nInline);
+	put32(pBuf, nTable, nTable - nVTable);
+	nInline = 4;
+	for (nWidth = 8; nWidth; nWidth /= 2)
+		for (i=0; i < nFields; i++)
+			if (arSize[i] == nWidth)
+			{
+				put16(pBuf, nVTable + 4 + 2 * i, nInline);
+				arPos[i] = nTable + nInline;
+				nInline += nWidth;
+			}
+
+	return(nTable);
+}
+
+/*
+* Routine: fb_vector(arrow_buf_t *pBuf, int nCount, int nElement, int nAlign)
+* Purpose: lay out a flatbuffer vector
+* Algorithm:
+* Data Structures:
+*
+* Params:
+* Returns: the position of the first element; offsets to the vector point
+*	at its length, 4 bytes before
+* Called By: 
+* Calls: 
+* Assumptions: nAlign is at least 4
+* Side Effects:
+* TODO: None
+*/
+static int
+fb_vector(arrow_buf_t *pBuf, int nCount, int nElement, int nAlign)
+{
+	int nStart;
+
+	nStart = (pBuf->nUsed + 4 + nAlign - 1) & ~(nAlign - 1);
+	arrow_reserve(pBuf, nStart + nCount * nElement - pBuf->nUsed, 1);
+	put32(pBuf, nStart - 4, nCount);
+
+	return(nStart);
+}
+
+/*
+* Routine: fb_string(arrow_buf_t *pBuf, char *szValue)
+* Purpose: lay out a flatbuffer string
+* Algorithm:
+* Data Structures:
+*
+* Params:
+* Returns: the position to point an offset at
+* Called By: 
+* Calls: 
+* Assumptions:
+* Side Effects:
+* TODO: None
+*/
+static int
+fb_string(arrow_buf_t *pBuf, char *szValue)
+{
+	int nLength = strlen(szValue),
+		nStart;
+
+	/* the terminating NUL is not counted in the length */
+	nStart = fb_vector(pBuf, nLength + 1, 1, 4);
+	put32(pBuf, nStart - 4, nLength);
+	memcpy(pBuf->pData + nStart, szValue, nLength);
+
+	return(nStart - 4);
+}
+
+/*
+* Routine: fb_message(arrow_buf_t *pBuf, int nType, ds_key_t kBody, int *pHeader)
+* Purpose: start an IPC message, and lay out its Message table
+* Algorithm:
+* Data Structures:
+*
+* Params: pHeader: set to the position of the offset to the message header
+* Returns: the position of the message
+* Called By: 
+* Calls: 
+* Assumptions: the buffer holds a multiple of 8 bytes
+* Side Effects:
+* TODO: None
+*/
+static int
+fb_message(arrow_buf_t *pBuf, int nType, ds_key_t kBody, int *pHeader)
+{
+	int nStart,
+		nMessage,
+		arSize[4] = {2, 1, 4, 8},	/* version, header_type, header, bodyLength */
+		arPos[4];
+
+	nStart = arrow_reserve(pBuf, 12, 8);
+	put32(pBuf, nStart, ARROW_CONTINUATION);
+	nMessage = fb_table(pBuf, 4, arSize, arPos);
+	fb_offset(pBuf, nStart + 8, nMessage);	/* the flatbuffer root */
+	put16(pBuf, arPos[0], ARROW_METADATA_V5);
+	put8(pBuf, arPos[1], nType);
+	put64(pBuf, arPos[3], kBody);
+	*pHeader = arPos[2];
+
+	return(nStart);
+}
+
+/*
+* Routine: fb_message_end(arrow_buf_t *pBuf, int nStart)
+* Purpose: pad the metadata of a message and record its length
+* Algorithm:
+* Data Structures:
+*
+* Params:
+* Returns:
+* Called By: 
+* Calls: 
+* Assumptions:
+* Side Effects:
+* TODO: None
+*/
+static void
+fb_message_end(arrow_buf_t *pBuf, int nStart)
+{
+	arrow_reserve(pBuf, 0, 8);
+	put32(pBuf, nStart + 4, pBuf->nUsed - nStart - 8);
+
+	return;
+}
+
+/*
+* Routine: arrow_ddl(arrow_batch_t *pBatch, char *szFile)
+* Purpose: name and type the columns of a table from its create table statement
+* Algorithm: the DDL files are looked for next to the distributions file
+* Data Structures:
+*
+* Params:
+* Returns: the number of columns found
+* Called By: arrow_new()
+* Calls: 
+* Assumptions:
+* Side Effects:
+* TODO: None
+*/
+static int
+arrow_ddl(arrow_batch_t *pBatch, char *szFile)
+{
+	char szPath[256],
+		szLine[256],
+		szName[64],
+		szType[64],
+		szTable[64],
+		*cp;
+	int bInTable = 0;
+	FILE *pFile;
+	arrow_column_t *pColumn;
+
+	strncpy(szPath, get_str("DISTRIBUTIONS"), sizeof(szPath) - 32);
+	szPath[sizeof(szPath) - 32] = '\0';
+	if ((cp = strrchr(szPath, PATH_SEP)) != NULL)
+		*(cp + 1) = '\0';
+	else
+		szPath[0] = '\0';
+	strcat(szPath, szFile);
+	if ((pFile = fopen(szPath, "r")) == NULL)
+		return(0);
+
+	while (fgets(szLine, sizeof(szLine), pFile) != NULL)
+	{
+		if (sscanf(szLine, "%63s %63s %63s", szName, szType, szTable) < 1)
+			continue;
+		if (!strcasecmp(szName, "create") && !strcasecmp(szType, "table"))
+		{
+			bInTable = !strcasecmp(szTable, getTableNameByID(pBatch->nTable));
+			continue;
+		}
+		if (!bInTable || (*szName == '('))
+			continue;
+		if ((*szName == ')') || !strcasecmp(szName, "primary"))
+			break;
+
+		if (pBatch->nNamed == pBatch->nAllocated)
+		{
+			pBatch->nAllocated += 32;
+			pBatch->arColumns = (arrow_column_t *)realloc(pBatch->arColumns, pBatch->nAllocated * sizeof(arrow_column_t));
+			MALLOC_CHECK(pBatch->arColumns);
+		}
+		pColumn = &pBatch->arColumns[pBatch->nNamed++];
+		memset(pColumn, 0, sizeof(arrow_column_t));
+		szName[sizeof(pColumn->szName) - 1] = '\0';
+		strcpy(pColumn->szName, szName);
+		if (sscanf(szType, "decimal(%d,%d)", &pColumn->nPrecision, &pColumn->nScale) != 2)
+		{
+			pColumn->nPrecision = DEFAULT_PRECISION;
+			pColumn->nScale = DEFAULT_SCALE;
+		}
+		else
+			pColumn->nSqlType = SQL_DECIMAL;
+		if (!strcasecmp(szType, "integer"))
+			pColumn->nSqlType = SQL_INTEGER;
+		else if (!strcasecmp(szType, "bigint"))
+			pColumn->nSqlType = SQL_BIGINT;
+		else if (!strcasecmp(szType, "date"))
+			pColumn->nSqlType = SQL_DATE;
+		else if (!strcasecmp(szType, "time"))
+			pColumn->nSqlType = SQL_TIME;
+		else if (!strncasecmp(szType, "char", 4) || !strncasecmp(szType, "varchar", 7))
+			pColumn->nSqlType = SQL_TEXT;
+	}
+	fclose(pFile);
+
+	return(pBatch->nNamed);
+}
+
+/*
+* Routine: arrow_new(int nTable, int nMaxRows)
+* Purpose: set up the column batch for a table
+* Algorithm:
+* Data Structures:
+*
+* Params:
+* Returns:
+* Called By: print_start(), load_open()
+* Calls: 
+* Assumptions:
+* Side Effects:
+* TODO: None
+*/
+arrow_batch_t *
+arrow_new(int nTable, int nMaxRows)
+{
+	arrow_batch_t *pBatch;
+
+	pBatch = (arrow_batch_t *)malloc(sizeof(arrow_batch_t));
+	MALLOC_CHECK(pBatch);
+	memset(pBatch, 0, sizeof(arrow_batch_t));
+	pBatch->nTable = nTable;
+	pBatch->nMaxRows = nMaxRows;
+
+	if (!arrow_ddl(pBatch, "tpcds.sql"))
+		arrow_ddl(pBatch, "tpcds_source.sql");
+
+	return(pBatch);
+}
+
+/*
+* Routine: arrow_free(arrow_batch_t *pBatch)
+* Purpose: release a column batch
+* Algorithm:
+* Data Structures:
+*
+* Params:
+* Returns:
+* Called By: print_close()
+* Calls: 
+* Assumptions:
+* Side Effects:
+* TODO: None
+*/
+void
+arrow_free(arrow_batch_t *pBatch)
+{
+	int i;
+
+	for (i=0; i < pBatch->nColumns; i++)
+	{
+		free(pBatch->arColumns[i].pValidity);
+		free(pBatch->arColumns[i].pValues);
+		free(pBatch->arColumns[i].pData);
+		if (pBatch->arColumns[i].pDictionary)
+			parquet_free_dictionary(pBatch->arColumns[i].pDictionary);
+	}
+	free(pBatch->arColumns);
+	free(pBatch->Message.pData);
+	free(pBatch);
+
+	return;
+}
+
+/*
+* Routine: arrow_width(int nType)
+* Purpose: size of a value in the values buffer of a column
+* Algorithm:
+* Data Structures:
+*
+* Params:
+* Returns:
+* Called By: 
+* Calls: 
+* Assumptions:
+* Side Effects:
+* TODO: None
+*/
+static int
+arrow_width(int nType)
+{
+	switch(nType)
+	{
+	case ARROW_INT64: return(8);
+	case ARROW_DECIMAL: return(16);
+	default: return(4);	/* strings keep 4 byte offsets */
+	}
+}
+
+/*
+* Routine: arrow_column(arrow_batch_t *pBatch, int nType, int bNull)
+* Purpose: find the next column of the current row, and mark its validity
+* Algorithm: the first row defines the columns; later rows must match it
+* Data Structures:
+*
+* Params:
+* Returns:
+* Called By: 
+* Calls: 
+* Assumptions:
+* Side Effects:
+* TODO: None
+*/
+static arrow_column_t *
+arrow_column(arrow_batch_t *pBatch, int nType, int bNull)
+{
+	arrow_column_t *pColumn;
+
+	if (!pBatch->bTyped)
+	{
+		if (pBatch->nColumn == pBatch->nAllocated)
+		{
+			pBatch->nAllocated += 32;
+			pBatch->arColumns = (arrow_column_t *)realloc(pBatch->arColumns, pBatch->nAllocated * sizeof(arrow_column_t));
+			MALLOC_CHECK(pBatch->arColumns);
+		}
+		pColumn = &pBatch->arColumns[pBatch->nColumn];
+		if (pBatch->nColumn >= pBatch->nNamed)
+		{
+			memset(pColumn, 0, sizeof(arrow_column_t));
+			sprintf(pColumn->szName, "column%d", pBatch->nColumn + 1);
+			pColumn->nPrecision = DEFAULT_PRECISION;
+			pColumn->nScale = DEFAULT_SCALE;
+		}
+		pColumn->nType = nType;
+		pColumn->pValidity = (unsigned char *)malloc((pBatch->nMaxRows + 7) / 8);
+		MALLOC_CHECK(pColumn->pValidity);
+		memset(pColumn->pValidity, 0, (pBatch->nMaxRows + 7) / 8);
+		pColumn->pValues = (char *)malloc((pBatch->nMaxRows + 1) * arrow_width(nType));
+		MALLOC_CHECK(pColumn->pValues);
+		memset(pColumn->pValues, 0, arrow_width(nType));
+		pBatch->nColumns += 1;
+	}
+	else if ((pBatch->nColumn >= pBatch->nColumns) || (pBatch->arColumns[pBatch->nColumn].nType != nType))
+	{
+		INTERNAL("Row does not match the columns of its table");
+		exit(-1);
+	}
+	pColumn = &pBatch->arColumns[pBatch->nColumn++];
+
+	if (bNull)
+		pColumn->nNulls += 1;
+	else
+		pColumn->pValidity[pBatch->nRows >> 3] |= (unsigned char)(1 << (pBatch->nRows & 7));
+
+	return(pColumn);
+}
+
+/*
+* Routine: arrow_integer(arrow_batch_t *pBatch, int nType, ds_key_t kValue, int bNull)
+* Purpose: add a fixed width value to the current row
+* Algorithm:
+* Data Structures:
+*
+* Params: kValue is a julian day for ARROW_DATE32
+* Returns:
+* Called By: print_integer(), print_key(), print_date(), print_time()
+* Calls: 
+* Assumptions:
+* Side Effects:
+* TODO: None
+*/
+void
+arrow_integer(arrow_batch_t *pBatch, int nType, ds_key_t kValue, int bNull)
+{
+	arrow_column_t *pColumn = arrow_column(pBatch, nType, bNull);
+	int nWidth = arrow_width(nType);
+
+	if (bNull)
+		kValue = 0;
+	else if (nType == ARROW_DATE32)
+		kValue -= JULIAN_1970;
+	arrow_put_le(pColumn->pValues + pBatch->nRows * nWidth, kValue, nWidth);
+
+	return;
+}
+
+/*
+* Routine: arrow_decimal(arrow_batch_t *pBatch, decimal_t *pValue, int bNull)
+* Purpose: add a decimal to the current row, at the scale of its column
+* Algorithm: decimal_t keeps its fractional digits in precision
+* Data Structures:
+*
+* Params:
+* Returns:
+* Called By: print_decimal()
+* Calls: 
+* Assumptions:
+* Side Effects:
+* TODO: None
+*/
+void
+arrow_decimal(arrow_batch_t *pBatch, decimal_t *pValue, int bNull)
+{
+	arrow_column_t *pColumn = arrow_column(pBatch, ARROW_DECIMAL, bNull);
+	char *pDest = pColumn->pValues + pBatch->nRows * 16;
+	ds_key_t kValue = 0;
+	int nDigits;
+
+	if (!bNull)
+	{
+		kValue = pValue->number;
+		nDigits = pColumn->nScale - pValue->precision;
+		if ((nDigits > 0) && (nDigits <= MAX_DECIMAL_PRECISION))
+			kValue *= arPowers[nDigits];
+		else if ((nDigits < 0) && (-nDigits <= MAX_DECIMAL_PRECISION))
+			kValue /= arPowers[-nDigits];
+	}
+	arrow_put_le(pDest, kValue, 8);
+	arrow_put_le(pDest + 8, (kValue < 0)?-1:0, 8);
+
+	return;
+}
+
+/*
+* Routine: arrow_string(arrow_batch_t *pBatch, char *szValue, int nLength, int bNull)
+* Purpose: add a string to the current row
+* Algorithm:
+* Data Structures:
+*
+* Params:
+* Returns:
+* Called By: print_varchar(), print_char(), print_id(), print_boolean()
+* Calls: 
+* Assumptions:
+* Side Effects:
+* TODO: None
+*/
+void
+arrow_string(arrow_batch_t *pBatch, char *szValue, int nLength, int bNull)
+{
+	arrow_column_t *pColumn = arrow_column(pBatch, ARROW_UTF8, bNull);
+
+	if (bNull)
+		nLength = 0;
+	if (pColumn->nDataUsed + nLength > pColumn->nDataSize)
+	{
+		pColumn->nDataSize = 2 * pColumn->nDataSize + nLength + 64 * 1024;
+		pColumn->pData = (char *)realloc(pColumn->pData, pColumn->nDataSize);
+		MALLOC_CHECK(pColumn->pData);
+	}
+	memcpy(pColumn->pData + pColumn->nDataUsed, szValue, nLength);
+	pColumn->nDataUsed += nLength;
+	arrow_put_le(pColumn->pValues + (pBatch->nRows + 1) * 4, pColumn->nDataUsed, 4);
+	if (pBatch->bDictionary && !bNull)
+		parquet_dictionary(pBatch, pColumn, szValue, nLength);
+
+	return;
+}
+
+/*
+* Routine: arrow_end_row(arrow_batch_t *pBatch)
+* Purpose: finish the current row
+* Algorithm:
+* Data Structures:
+*
+* Params:
+* Returns: 1 when the batch is full, and should be passed to arrow_encode()
+* Called By: print_end()
+* Calls: 
+* Assumptions:
+* Side Effects:
+* TODO: None
+*/
+int
+arrow_end_row(arrow_batch_t *pBatch)
+{
+	int i;
+
+	if (!pBatch->bTyped)
+	{
+		pBatch->bTyped = 1;
+		/* a DDL that does not describe the row is no help */
+		if (pBatch->nNamed && (pBatch->nNamed != pBatch->nColumns))
+		{
+			fprintf(stderr, "WARNING: DDL for %s does not match its rows; columns are numbered\n", 
+				getTableNameByID(pBatch->nTable));
+			for (i=0; i < pBatch->nColumns; i++)
+				sprintf(pBatch->arColumns[i].szName, "column%d", i + 1);
+		}
+	}
+	if (pBatch->nColumn != pBatch->nColumns)
+	{
+		INTERNAL("Row does not match the columns of its table");
+		exit(-1);
+	}
+	pBatch->nColumn = 0;
+	pBatch->nRows += 1;
+
+	return(pBatch->nRows == pBatch->nMaxRows);
+}
+
+/*
+* Routine: arrow_schema(arrow_batch_t *pBatch)
+* Purpose: encode the Schema message for a batch
+* Algorithm:
+* Data Structures:
+*
+* Params:
+* Returns:
+* Called By: arrow_encode()
+* Calls: 
+* Assumptions:
+* Side Effects:
+* TODO: None
+*/
+static void
+arrow_schema(arrow_batch_t *pBatch)
+{
+	arrow_buf_t *pBuf = &pBatch->Message;
+	arrow_column_t *pColumn;
+	int i,
+		nStart,
+		nHeader,
+		nFields,
+		nType,
+		arSchema[2] = {2, 4},	/* endianness, fields */
+		arField[6] = {4, 1, 1, 4, 0, 4},	/* name, nullable, type_type, type, dictionary, children */
+		arInt[2] = {4, 1},	/* bitWidth, is_signed */
+		arDate[1] = {2},	/* unit */
+		arTime[2] = {2, 4},	/* unit, bitWidth */
+		arDecimal[3] = {4, 4, 4},	/* precision, scale, bitWidth */
+		arPos[6],
+		arFieldPos[6];
+
+	nStart = fb_message(pBuf, ARROW_HEADER_SCHEMA, 0, &nHeader);
+	fb_offset(pBuf, nHeader, fb_table(pBuf, 2, arSchema, arPos));
+	nFields = fb_vector(pBuf, pBatch->nColumns, 4, 4);
+	fb_offset(pBuf, arPos[1], nFields - 4);
+
+	for (i=0; i < pBatch->nColumns; i++)
+	{
+		pColumn = &pBatch->arColumns[i];
+		fb_offset(pBuf, nFields + 4 * i, fb_table(pBuf, 6, arField, arFieldPos));
+		put8(pBuf, arFieldPos[1], 1);
+		switch(pColumn->nType)
+		{
+		case ARROW_INT32:
+		case ARROW_INT64:
+			put8(pBuf, arFieldPos[2], ARROW_TYPE_INT);
+			nType = fb_table(pBuf, 2, arInt, arPos);
+			put32(pBuf, arPos[0], (pColumn->nType == ARROW_INT64)?64:32);
+			put8(pBuf, arPos[1], 1);
+			break;
+		case ARROW_DATE32:
+			put8(pBuf, arFieldPos[2], ARROW_TYPE_DATE);
+			nType = fb_table(pBuf, 1, arDate, arPos);
+			put16(pBuf, arPos[0], 0);	/* DAY */
+			break;
+		case ARROW_TIME32:
+			put8(pBuf, arFieldPos[2], ARROW_TYPE_TIME);
+			nType = fb_table(pBuf, 2, arTime, arPos);
+			put16(pBuf, arPos[0], 0);	/* SECOND */
+			put32(pBuf, arPos[1], 32);
+			break;
+		case ARROW_DECIMAL:
+			put8(pBuf, arFieldPos[2], ARROW_TYPE_DECIMAL);
+			nType = fb_table(pBuf, 3, arDecimal, arPos);
+			put32(pBuf, arPos[0], pColumn->nPrecision);
+			put32(pBuf, arPos[1], pColumn->nScale);
+			put32(pBuf, arPos[2], 128);
+			break;
+		default:
+			put8(pBuf, arFieldPos[2], ARROW_TYPE_UTF8);
+			nType = fb_table(pBuf, 0, NULL, NULL);
+			break;
+		}
+		fb_offset(pBuf, arFieldPos[3], nType);
+		fb_offset(pBuf, arFieldPos[0], fb_string(pBuf, pColumn->szName));
+		fb_offset(pBuf, arFieldPos[5], fb_vector(pBuf, 0, 4, 4) - 4);
+	}
+	fb_message_end(pBuf, nStart);
+
+	return;
+}
+
+/*
+* Routine: arrow_batch(arrow_batch_t *pBatch)
+* Purpose: encode the RecordBatch message for the rows in a batch
+* Algorithm: every column has a validity buffer (empty when there are no 
+*	NULLs) and a values buffer; strings add a data buffer. Buffers are
+*	padded to 8 bytes within the body.
+* Data Structures:
+*
+* Params:
+* Returns:
+* Called By: arrow_encode()
+* Calls: 
+* Assumptions:
+* Side Effects:
+* TODO: None
+*/
+static void
+arrow_batch(arrow_batch_t *pBatch)
+{
+	arrow_buf_t *pBuf = &pBatch->Message;
+	arrow_column_t *pColumn;
+	int i,
+		j,
+		nStart,
+		nHeader,
+		nNodes,
+		nBuffers,
+		nBufferCount = 0,
+		arRecord[3] = {8, 4, 4},	/* length, nodes, buffers */
+		arPos[3],
+		arLength[3],
+		nPos;
+	char *arData[3];
+	ds_key_t kBody = 0;
+
+	for (i=0; i < pBatch->nColumns; i++)
+		nBufferCount += (pBatch->arColumns[i].nType == ARROW_UTF8)?3:2;
+
+	/* the body length is needed up front, so the buffers are sized twice */
+	for (i=0; i < pBatch->nColumns; i++)
+	{
+		pColumn = &pBatch->arColumns[i];
+		kBody += PAD8((pColumn->nNulls)?(pBatch->nRows + 7) / 8:0);
+		if (pColumn->nType == ARROW_UTF8)
+			kBody += PAD8((pBatch->nRows + 1) * 4) + PAD8(pColumn->nDataUsed);
+		else
+			kBody += PAD8(pBatch->nRows * arrow_width(pColumn->nType));
+	}
+
+	nStart = fb_message(pBuf, ARROW_HEADER_BATCH, kBody, &nHeader);
+	fb_offset(pBuf, nHeader, fb_table(pBuf, 3, arRecord, arPos));
+	put64(pBuf, arPos[0], pBatch->nRows);
+	nNodes = fb_vector(pBuf, pBatch->nColumns, 16, 8);
+	fb_offset(pBuf, arPos[1], nNodes - 4);
+	nBuffers = fb_vector(pBuf, nBufferCount, 16, 8);
+	fb_offset(pBuf, arPos[2], nBuffers - 4);
+	fb_message_end(pBuf, nStart);
+
+	kBody = 0;
+	for (i=0; i < pBatch->nColumns; i++)
+	{
+		pColumn = &pBatch->arColumns[i];
+		put64(pBuf, nNodes + 16 * i, pBatch->nRows);
+		put64(pBuf, nNodes + 16 * i + 8, pColumn->nNulls);
+
+		arData[0] = (char *)pColumn->pValidity;
+		arLength[0] = (pColumn->nNulls)?(pBatch->nRows + 7) / 8:0;
+		arData[1] = pColumn->pValues;
+		if (pColumn->nType == ARROW_UTF8)
+		{
+			arLength[1] = (pBatch->nRows + 1) * 4;
+			arData[2] = pColumn->pData;
+			arLength[2] = pColumn->nDataUsed;
+		}
+		else
+			arLength[1] = pBatch->nRows * arrow_width(pColumn->nType);
+
+		for (j=0; j < ((pColumn->nType == ARROW_UTF8)?3:2); j++)
+		{
+			put64(pBuf, nBuffers, kBody);
+			put64(pBuf, nBuffers + 8, arLength[j]);
+			nBuffers += 16;
+			nPos = arrow_reserve(pBuf, PAD8(arLength[j]), 8);
+			if (arLength[j])
+				memcpy(pBuf->pData + nPos, arData[j], arLength[j]);
+			kBody += PAD8(arLength[j]);
+		}
+	}
+
+	return;
+}
+
+/*
+* Routine: arrow_encode(arrow_batch_t *pBatch, char **ppData)
+* Purpose: encode the rows collected so far, preceded by the schema if it
+*	has not been written yet, and empty the batch
+* Algorithm:
+* Data Structures:
+*
+* Params:
+* Returns: the number of bytes at *ppData
+* Called By: print_end(), print_close()
+* Calls: 
+* Assumptions:
+* Side Effects:
+* TODO: None
+*/
+int
+arrow_encode(arrow_batch_t *pBatch, char **ppData)
+{
+	pBatch->Message.nUsed = 0;
+	if (!pBatch->bSchema && pBatch->bTyped)
+	{
+		arrow_schema(pBatch);
+		pBatch->bSchema = 1;
+	}
+	if (pBatch->nRows)
+	{
+		arrow_batch(pBatch);
+		arrow_clear(pBatch);
+	}
+
+	*ppData = pBatch->Message.pData;
+	return(pBatch->Message.nUsed);
+}
+
+/*
+* Routine: arrow_clear(arrow_batch_t *pBatch)
+* Purpose: empty a batch once its rows have been encoded
+* Algorithm:
+* Data Structures:
+*
+* Params:
+* Returns:
+* Called By: arrow_encode(), parquet_encode()
+* Calls: 
+* Assumptions:
+* Side Effects:
+* TODO: None
+*/
+void
+arrow_clear(arrow_batch_t *pBatch)
+{
+	int i;
+	arrow_column_t *pColumn;
+
+	for (i=0; i < pBatch->nColumns; i++)
+	{
+		pColumn = &pBatch->arColumns[i];
+		pColumn->nNulls = 0;
+		pColumn->nDataUsed = 0;
+		memset(pColumn->pValidity, 0, (pBatch->nRows + 7) / 8);
+	}
+	pBatch->nRows = 0;
+
+	return;
+}
+
+/*
+* Routine: arrow_eos(char **ppData)
+* Purpose: provide the end of stream marker
+* Algorithm:
+* Data Structures:
+*
+* Params:
+* Returns: the number of bytes at *ppData
+* Called By: print_close(), print_merge()
+* Calls: 
+* Assumptions:
+* Side Effects:
+* TODO: None
+*/
+int
+arrow_eos(char **ppData)
+{
+	static char arEOS[8] = {(char)0xFF, (char)0xFF, (char)0xFF, (char)0xFF, 0, 0, 0, 0};
+
+	*ppData = arEOS;
+	return(8);
+}
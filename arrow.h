@@ -0,0 +1,115 @@
+/* 
+ * Legal Notice 
+ * 
+ * This document and associated source code (the "Work") is a part of a 
+ * benchmark specification maintained by the TPC. 
+ * 
+ * The TPC reserves all right, title, and interest to the Work as provided 
+ * under U.S. and international laws, including without limitation all patent 
+ * and trademark rights therein. 
+ * 
+ * No Warranty 
+ * 
+ * 1.1 TO THE MAXIMUM EXTENT PERMITTED BY APPLICABLE LAW, THE INFORMATION 
+ *     CONTAINED HEREIN IS PROVIDED "AS IS" AND WITH ALL FAULTS, AND THE 
+ *     AUTHORS AND DEVELOPERS OF THE WORK HEREBY DISCLAIM ALL OTHER 
+ *     WARRANTIES AND CONDITIONS, EITHER EXPRESS, IMPLIED OR STATUTORY, 
+ *     INCLUDING, BUT NOT LIMITED TO, ANY (IF ANY) IMPLIED WARRANTIES, 
+ *     DUTIES OR CONDITIONS OF MERCHANTABILITY, OF FITNESS FOR A PARTICULAR 
+ *     PURPOSE, OF ACCURACY OR COMPLETENESS OF RESPONSES, OF RESULTS, OF 
+ *     WORKMANLIKE EFFORT, OF LACK OF VIRUSES, AND OF LACK OF NEGLIGENCE. 
+ *     ALSO, THERE IS NO WARRANTY OR CONDITION OF TITLE, QUIET ENJOYMENT, 
+ *     QUIET POSSESSION, CORRESPONDENCE TO DESCRIPTION OR NON-INFRINGEMENT 
+ *     WITH REGARD TO THE WORK. 
+ * 1.2 IN NO EVENT WILL ANY AUTHOR OR DEVELOPER OF THE WORK BE LIABLE TO 
+ *     ANY OTHER PARTY FOR ANY DAMAGES, INCLUDING BUT NOT LIMITED TO THE 
+ *     COST OF PROCURING SUBSTITUTE GOODS OR SERVICES, LOST PROFITS, LOSS 
+ *     OF USE, LOSS OF DATA, OR ANY INCIDENTAL, CONSEQUENTIAL, DIRECT, 
+ *     INDIRECT, OR SPECIAL DAMAGES WHETHER UNDER CONTRACT, TORT, WARRANTY,
+ *     OR OTHERWISE, ARISING IN ANY WAY OUT OF THIS OR ANY OTHER AGREEMENT 
+ *     RELATING TO THE WORK, WHETHER OR NOT SUCH AUTHOR OR DEVELOPER HAD 
+ *     ADVANCE NOTICE OF THE POSSIBILITY OF SUCH DAMAGES. 
+ * 
+ * Contributors:
+ * Gradient Systems
+ */ 
+#ifndef ARROW_H
+#define ARROW_H
+
+#include "decimal.h"
+
+/*
+ * -FORMAT arrow: rows are collected into columns and written as Apache Arrow
+ * IPC stream messages; see arrow.c for the layout
+ */
+#define ARROW_BATCH_ROWS	65536
+#define DEFAULT_PRECISION	15	/* decimal columns without a DDL */
+#define DEFAULT_SCALE		2
+
+/* column types; each is chosen by the print routine that fills the column */
+#define ARROW_INT32		1	/* print_integer() */
+#define ARROW_INT64		2	/* print_key(); -1 is NULL */
+#define ARROW_DATE32	3	/* print_date(); days since 1970-01-01 */
+#define ARROW_TIME32	4	/* print_time(); seconds since midnight */
+#define ARROW_DECIMAL	5	/* print_decimal(); decimal128 */
+#define ARROW_UTF8		6	/* print_varchar(), print_char(), print_id(), print_boolean() */
+
+/* SQL types of the DDL columns */
+#define SQL_OTHER		0
+#define SQL_INTEGER		1
+#define SQL_BIGINT		2
+#define SQL_DECIMAL		3
+#define SQL_DATE		4
+#define SQL_TIME		5
+#define SQL_TEXT		6	/* char and varchar */
+
+/* a growable byte buffer */
+typedef struct ARROW_BUF_T {
+	char *pData;
+	int nUsed;
+	int nSize;
+} arrow_buf_t;
+
+typedef struct ARROW_COLUMN_T {
+	int nType;
+	char szName[32];
+	int nSqlType;	/* from the DDL, or SQL_OTHER */
+	int nPrecision;	/* decimal columns */
+	int nScale;
+	int nNulls;
+	unsigned char *pValidity;
+	char *pValues;	/* fixed width values, or string offsets */
+	char *pData;	/* string bytes */
+	int nDataUsed;
+	int nDataSize;
+	struct PARQUET_DICT_T *pDictionary;	/* -FORMAT parquet: see parquet_dictionary() */
+} arrow_column_t;
+
+typedef struct ARROW_BATCH_T {
+	int nTable;
+	int nColumns;
+	int nAllocated;
+	int nColumn;	/* next column of the current row */
+	int nRows;
+	int nMaxRows;
+	int nNamed;	/* columns named from the DDL */
+	int bTyped;	/* column types have been set by the first row */
+	int bSchema;	/* the schema message has been written */
+	int bDictionary;	/* strings are dictionary encoded as they arrive */
+	arrow_column_t *arColumns;
+	arrow_buf_t Message;	/* encoded messages */
+} arrow_batch_t;
+
+arrow_batch_t *arrow_new(int nTable, int nMaxRows);
+void arrow_free(arrow_batch_t *pBatch);
+void arrow_integer(arrow_batch_t *pBatch, int nType, ds_key_t kValue, int bNull);
+void arrow_decimal(arrow_batch_t *pBatch, decimal_t *pValue, int bNull);
+void arrow_string(arrow_batch_t *pBatch, char *szValue, int nLength, int bNull);
+int arrow_end_row(arrow_batch_t *pBatch);
+int arrow_encode(arrow_batch_t *pBatch, char **ppData);
+void arrow_clear(arrow_batch_t *pBatch);
+int arrow_eos(char **ppData);
+int arrow_reserve(arrow_buf_t *pBuf, int nBytes, int nAlign);
+void arrow_put_le(char *pDest, ds_key_t kValue, int nBytes);
+
+#endif /* ARROW_H */
@@ -72,12 +72,12 @@
 void
 hierarchy_item(int h_level, ds_key_t *id, char **name, ds_key_t kIndex)
 {
-	static int bInit = 0,
+	static THREAD int bInit = 0,
 		nLastCategory = -1,
 		nLastClass = -1,
 		nBrandBase;
 	int nBrandCount;
-	static char *szClassDistName = NULL;
+	static THREAD char *szClassDistName = NULL;
 	char sTemp[6];
 
 	if (!bInit)
@@ -167,8 +167,8 @@ int mk_companyname(char *dest, int nTable, int nCompany)
 */
 int set_locale(int nRegion, decimal_t *longitude, decimal_t *latitude)
 {
-	static int init = 0;
-	static decimal_t dZero;
+	static THREAD int init = 0;
+	static THREAD decimal_t dZero;
 	
 	if (!init)
 	{
@@ -107,6 +107,7 @@
 #define USE_VALUES_H
 #define USE_STDLIB_H
 #define FLEX
+#define USE_THREADS
 #endif /* LINUX */
 
 #ifdef MACOS
@@ -118,6 +119,7 @@
 #define USE_LIMITS_H
 #define USE_STDLIB_H
 #define FLEX
+#define USE_THREADS
 #endif /* MACOS */
 
 #ifdef SOLARIS
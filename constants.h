@@ -76,6 +76,8 @@
 #define CS_MAX_SHIP_DELAY	90		/* maximum days from order to ship */
 #define CS_ITEMS_PER_ORDER	10		/* number of items in each order */
 #define CS_GIFT_PCT			10		/* ship-to != bill-to */
+#define CS_MIN_LINEITEMS	4		/* range of lineitems in each order */
+#define CS_MAX_LINEITEMS	14
 
  /*
  * DATE SETTINGS
@@ -136,6 +138,8 @@
 #define SS_DISCOUNT_MAX		"1.00"
 #define SS_WHOLESALE_MAX	"100.00"
 #define SS_COUPON_MAX		"0.50"
+#define SS_MIN_LINEITEMS	8		/* range of lineitems in each ticket */
+#define SS_MAX_LINEITEMS	16
 
  /***
  *** WP_xxx Web Page Defines
@@ -165,6 +169,12 @@
 #define WR_SHIP_LAG_MIN	2	/* lag time between receiving and returning */
 #define WR_SHIP_LAG_MAX	12
 
+ /***
+ *** WS_xxx Web Sales Defines
+ ***/
+#define WS_MIN_LINEITEMS	8	/* range of lineitems in each order */
+#define WS_MAX_LINEITEMS	16
+
  /***
  *** WEB_xxx Web Site Defines
  ***/
@@ -0,0 +1,129 @@
+/* 
+ * Legal Notice 
+ * 
+ * This document and associated source code (the "Work") is a part of a 
+ * benchmark specification maintained by the TPC. 
+ * 
+ * The TPC reserves all right, title, and interest to the Work as provided 
+ * under U.S. and international laws, including without limitation all patent 
+ * and trademark rights therein. 
+ * 
+ * No Warranty 
+ * 
+ * 1.1 TO THE MAXIMUM EXTENT PERMITTED BY APPLICABLE LAW, THE INFORMATION 
+ *     CONTAINED HEREIN IS PROVIDED "AS IS" AND WITH ALL FAULTS, AND THE 
+ *     AUTHORS AND DEVELOPERS OF THE WORK HEREBY DISCLAIM ALL OTHER 
+ *     WARRANTIES AND CONDITIONS, EITHER EXPRESS, IMPLIED OR STATUTORY, 
+ *     INCLUDING, BUT NOT LIMITED TO, ANY (IF ANY) IMPLIED WARRANTIES, 
+ *     DUTIES OR CONDITIONS OF MERCHANTABILITY, OF FITNESS FOR A PARTICULAR 
+ *     PURPOSE, OF ACCURACY OR COMPLETENESS OF RESPONSES, OF RESULTS, OF 
+ *     WORKMANLIKE EFFORT, OF LACK OF VIRUSES, AND OF LACK OF NEGLIGENCE. 
+ *     ALSO, THERE IS NO WARRANTY OR CONDITION OF TITLE, QUIET ENJOYMENT, 
+ *     QUIET POSSESSION, CORRESPONDENCE TO DESCRIPTION OR NON-INFRINGEMENT 
+ *     WITH REGARD TO THE WORK. 
+ * 1.2 IN NO EVENT WILL ANY AUTHOR OR DEVELOPER OF THE WORK BE LIABLE TO 
+ *     ANY OTHER PARTY FOR ANY DAMAGES, INCLUDING BUT NOT LIMITED TO THE 
+ *     COST OF PROCURING SUBSTITUTE GOODS OR SERVICES, LOST PROFITS, LOSS 
+ *     OF USE, LOSS OF DATA, OR ANY INCIDENTAL, CONSEQUENTIAL, DIRECT, 
+ *     INDIRECT, OR SPECIAL DAMAGES WHETHER UNDER CONTRACT, TORT, WARRANTY,
+ *     OR OTHERWISE, ARISING IN ANY WAY OUT OF THIS OR ANY OTHER AGREEMENT 
+ *     RELATING TO THE WORK, WHETHER OR NOT SUCH AUTHOR OR DEVELOPER HAD 
+ *     ADVANCE NOTICE OF THE POSSIBILITY OF SUCH DAMAGES. 
+ * 
+ * Contributors:
+ * Gradient Systems
+ */ 
+#include "config.h"
+#include "porting.h"
+#include <stdio.h>
+#ifdef USE_STRING_H
+#include <string.h>
+#else
+#include <strings.h>
+#endif
+#ifdef USE_STDLIB_H
+#include <stdlib.h>
+#else
+#include <malloc.h>
+#endif
+#include "context.h"
+#include "w_call_center.h"
+#include "w_item.h"
+#include "w_store.h"
+#include "w_web_page.h"
+#include "w_web_site.h"
+
+/*
+* Routine: ctx_new(void)
+* Purpose: create the builder state of a generator
+* Algorithm: every member starts at zero; each builder sets up its own state 
+*	on its first call. The previous revisions of the slowly changing 
+*	dimensions are allocated here, since their structures are only known
+*	to the builders.
+* Data Structures:
+*
+* Params:
+* Returns:
+* Called By: main(), gen_chunk(), lib_load()
+* Calls: 
+* Assumptions:
+* Side Effects:
+* TODO: None
+*/
+gen_ctx_t *
+ctx_new(void)
+{
+	gen_ctx_t *pCtx;
+
+	pCtx = (gen_ctx_t *)malloc(sizeof(struct GEN_CTX_T));
+	MALLOC_CHECK(pCtx);
+	memset(pCtx, 0, sizeof(struct GEN_CTX_T));
+	pCtx->StoreKeys.kBlock = -1;
+
+	pCtx->Scd.pCallCenter = (struct CALL_CENTER_TBL *)malloc(sizeof(struct CALL_CENTER_TBL));
+	MALLOC_CHECK(pCtx->Scd.pCallCenter);
+	memset(pCtx->Scd.pCallCenter, 0, sizeof(struct CALL_CENTER_TBL));
+	pCtx->Scd.pItem = (struct W_ITEM_TBL *)malloc(sizeof(struct W_ITEM_TBL));
+	MALLOC_CHECK(pCtx->Scd.pItem);
+	memset(pCtx->Scd.pItem, 0, sizeof(struct W_ITEM_TBL));
+	pCtx->Scd.pStore = (struct W_STORE_TBL *)malloc(sizeof(struct W_STORE_TBL));
+	MALLOC_CHECK(pCtx->Scd.pStore);
+	memset(pCtx->Scd.pStore, 0, sizeof(struct W_STORE_TBL));
+	pCtx->Scd.pWebPage = (struct W_WEB_PAGE_TBL *)malloc(sizeof(struct W_WEB_PAGE_TBL));
+	MALLOC_CHECK(pCtx->Scd.pWebPage);
+	memset(pCtx->Scd.pWebPage, 0, sizeof(struct W_WEB_PAGE_TBL));
+	pCtx->Scd.pWebSite = (struct W_WEB_SITE_TBL *)malloc(sizeof(struct W_WEB_SITE_TBL));
+	MALLOC_CHECK(pCtx->Scd.pWebSite);
+	memset(pCtx->Scd.pWebSite, 0, sizeof(struct W_WEB_SITE_TBL));
+
+	return(pCtx);
+}
+
+/*
+* Routine: ctx_free(gen_ctx_t *pCtx)
+* Purpose: release the builder state of a generator
+* Algorithm:
+* Data Structures:
+*
+* Params:
+* Returns:
+* Called By: 
+* Calls: 
+* Assumptions:
+* Side Effects:
+* TODO: None
+*/
+void
+ctx_free(gen_ctx_t *pCtx)
+{
+	if (pCtx->Text.szVerbiage)
+		free(pCtx->Text.szVerbiage);
+	free(pCtx->Scd.pCallCenter);
+	free(pCtx->Scd.pItem);
+	free(pCtx->Scd.pStore);
+	free(pCtx->Scd.pWebPage);
+	free(pCtx->Scd.pWebSite);
+	free(pCtx);
+
+	return;
+}
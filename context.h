@@ -0,0 +1,128 @@
+/* 
+ * Legal Notice 
+ * 
+ * This document and associated source code (the "Work") is a part of a 
+ * benchmark specification maintained by the TPC. 
+ * 
+ * The TPC reserves all right, title, and interest to the Work as provided 
+ * under U.S. and international laws, including without limitation all patent 
+ * and trademark rights therein. 
+ * 
+ * No Warranty 
+ * 
+ * 1.1 TO THE MAXIMUM EXTENT PERMITTED BY APPLICABLE LAW, THE INFORMATION 
+ *     CONTAINED HEREIN IS PROVIDED "AS IS" AND WITH ALL FAULTS, AND THE 
+ *     AUTHORS AND DEVELOPERS OF THE WORK HEREBY DISCLAIM ALL OTHER 
+ *     WARRANTIES AND CONDITIONS, EITHER EXPRESS, IMPLIED OR STATUTORY, 
+ *     INCLUDING, BUT NOT LIMITED TO, ANY (IF ANY) IMPLIED WARRANTIES, 
+ *     DUTIES OR CONDITIONS OF MERCHANTABILITY, OF FITNESS FOR A PARTICULAR 
+ *     PURPOSE, OF ACCURACY OR COMPLETENESS OF RESPONSES, OF RESULTS, OF 
+ *     WORKMANLIKE EFFORT, OF LACK OF VIRUSES, AND OF LACK OF NEGLIGENCE. 
+ *     ALSO, THERE IS NO WARRANTY OR CONDITION OF TITLE, QUIET ENJOYMENT, 
+ *     QUIET POSSESSION, CORRESPONDENCE TO DESCRIPTION OR NON-INFRINGEMENT 
+ *     WITH REGARD TO THE WORK. 
+ * 1.2 IN NO EVENT WILL ANY AUTHOR OR DEVELOPER OF THE WORK BE LIABLE TO 
+ *     ANY OTHER PARTY FOR ANY DAMAGES, INCLUDING BUT NOT LIMITED TO THE 
+ *     COST OF PROCURING SUBSTITUTE GOODS OR SERVICES, LOST PROFITS, LOSS 
+ *     OF USE, LOSS OF DATA, OR ANY INCIDENTAL, CONSEQUENTIAL, DIRECT, 
+ *     INDIRECT, OR SPECIAL DAMAGES WHETHER UNDER CONTRACT, TORT, WARRANTY,
+ *     OR OTHERWISE, ARISING IN ANY WAY OUT OF THIS OR ANY OTHER AGREEMENT 
+ *     RELATING TO THE WORK, WHETHER OR NOT SUCH AUTHOR OR DEVELOPER HAD 
+ *     ADVANCE NOTICE OF THE POSSIBILITY OF SUCH DAMAGES. 
+ * 
+ * Contributors:
+ * Gradient Systems
+ */ 
+#ifndef CONTEXT_H
+#define CONTEXT_H
+
+#include "decimal.h"
+#include "stable_rng.h"
+
+/*
+ * the state that the builders carry from one row to the next. Every
+ * generator -- the main thread, a -THREADS worker, a libdsdgen thread --
+ * has a context of its own, which is passed to the builders through
+ * table_func_t; state that is read only once it is set up (distributions,
+ * item permutations) is shared by all of them.
+ */
+
+struct CALL_CENTER_TBL;
+struct W_ITEM_TBL;
+struct W_STORE_TBL;
+struct W_WEB_PAGE_TBL;
+struct W_WEB_SITE_TBL;
+
+/* a sales table: the date and the item sequence of the current order */
+typedef struct SALES_STATE_T {
+	int bInit;
+	int bDetailInit;	/* web_sales sets up its lineitems separately */
+	ds_key_t jDate;		/* sale date of the current order */
+	ds_key_t kNewDateIndex;	/* last order on jDate */
+	int nItemIndex;		/* permutation entry of the last lineitem */
+	int nItemCount;
+} sales_state_t;
+
+/* store_sales: the foreign keys of a block of tickets; see fill_master_block() */
+#define SS_MASTER_JOINS	7
+typedef struct TICKET_KEYS_T {
+	ds_key_t kBlock;	/* first ticket in the block; -1 before the first block */
+	ds_key_t arKey[SS_MASTER_JOINS][STABLE_BATCH_SIZE];
+	int arNullCustomer[STABLE_BATCH_SIZE];
+} ticket_keys_t;
+
+/* inventory: the first week, and the items and warehouses counted each week */
+typedef struct INVENTORY_STATE_T {
+	int bInit;
+	ds_key_t kItemCount;
+	ds_key_t kWarehouseCount;
+	int jDate;
+} inventory_state_t;
+
+/* 
+ * the slowly changing dimensions: the values of the revision last written, 
+ * which a new revision of the same business key may keep
+ */
+typedef struct SCD_STATE_T {
+	struct CALL_CENTER_TBL *pCallCenter;
+	struct W_ITEM_TBL *pItem;
+	struct W_STORE_TBL *pStore;
+	struct W_WEB_PAGE_TBL *pWebPage;
+	struct W_WEB_SITE_TBL *pWebSite;
+} scd_state_t;
+
+/* set_pricing(): constants, and the limits of the last pricing id */
+typedef struct PRICING_STATE_T {
+	int bInit;
+	int nLastId;
+	int nQuantityMin,
+		nQuantityMax;
+	decimal_t dMarkupMin, dMarkupMax,
+		dDiscountMin, dDiscountMax,
+		dWholesaleMin, dWholesaleMax,
+		dCouponMin, dCouponMax,
+		dZero, dOneHalf, d9pct, dOne, dHundred;
+} pricing_state_t;
+
+/* gen_text(): the sentence being built */
+typedef struct TEXT_STATE_T {
+	char *szVerbiage;
+	int nAllocated;
+	int nUsed;
+} text_state_t;
+
+typedef struct GEN_CTX_T {
+	sales_state_t StoreSales;
+	sales_state_t CatalogSales;
+	sales_state_t WebSales;
+	ticket_keys_t StoreKeys;
+	inventory_state_t Inventory;
+	scd_state_t Scd;
+	pricing_state_t Pricing;
+	text_state_t Text;
+} gen_ctx_t;
+
+gen_ctx_t *ctx_new(void);
+void ctx_free(gen_ctx_t *pCtx);
+
+#endif /* CONTEXT_H */
@@ -281,8 +281,8 @@ strtodt(date_t *dest, char *s)
 char *
 dttostr(date_t *d)
 {
-	static char 	*res;
-	static int init = 0;
+	static THREAD char 	*res;
+	static THREAD int init = 0;
 	
 	if (!init)
 		{
@@ -451,12 +451,12 @@ itodt(date_t *dest, int src)
  * TODO: 
  */
 static int doomsday[4] = {3, 2, 0, 5};
-static int known[13] = { 0, 3, 0, 0, 4, 9, 6, 11, 8, 5, 10, 7, 12 };
+static THREAD int known[13] = { 0, 3, 0, 0, 4, 9, 6, 11, 8, 5, 10, 7, 12 };
 int
 set_dow(date_t *d)
 {
 
-	static int last_year = -1, 
+	static THREAD int last_year = -1, 
 		dday;
 	int res,
 		q, r, s;
@@ -63,7 +63,7 @@ extern char g_szCommandLine[];
 * TODO: None
 */
 int
-mk_dbgen_version(void *pDest, ds_key_t kIndex)
+mk_dbgen_version(gen_ctx_t *pCtx, void *pDest, ds_key_t kIndex)
 {
 	static int bInit = 0;
 	struct DBGEN_VERSION_TBL *r;
@@ -151,6 +151,6 @@ ld_dbgen_version(void *pSrc)
 	else
 		r = pSrc;
 	
-	return(0);
+	return(pr_dbgen_version(r));
 }
 
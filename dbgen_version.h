@@ -35,6 +35,7 @@
  */ 
 #ifndef DBGEN_VERSION_H
 #define DBGEN_VERSION_H
+#include "context.h"
 
 #define RS_VERSION_LENGTH	100
 #define RS_CMDLINARGS_LENGTH	200
@@ -46,7 +47,7 @@ struct DBGEN_VERSION_TBL {
 	char		szCmdLineArgs[RS_CMDLINARGS_LENGTH + 1];
 };
 
-int mk_dbgen_version(void *pDest, ds_key_t kIndex);
+int mk_dbgen_version(gen_ctx_t *pCtx, void *pDest, ds_key_t kIndex);
 int pr_dbgen_version(void *pSrc);
 int ld_dbgen_version(void *pSrc);
 #endif
@@ -237,6 +237,153 @@ WriteIndex(distindex_t *t)
    return(err_cnt);
 }    
 
+/*
+ * Routine: WriteNativeIndex()
+ * Purpose: write the distributions in the native layout described in dist.h,
+ *		so that dist.c can map the file and use the arrays in place
+ * Algorithm: the weights are made cumulative and the maximums computed here,
+ *		which is the work load_dist() does after reading the portable file
+ * Data Structures:
+ *
+ * Params: (list_t)
+ * Returns:
+ * Called By: main()
+ * Calls: 
+ * Assumptions:
+ * Side Effects:
+ * TODO: None
+ */
+int 
+WriteNativeIndex(distindex_t *t)
+{
+   d_idx_t *idx = NULL;
+   dist_t *d;
+   int32_t i, j, 
+      nDist,
+      nPad,
+      *arOffset,
+      arHeader[3],
+      nMax,
+      temp;
+   int err_cnt = 0;
+   long offset;
+   FILE *ofp = NULL;
+   static char szPad[sizeof(int32_t)];
+
+	if ((ofp = fopen(get_str("NATIVE"), "wb")) == NULL)
+	{
+		printf("ERROR: Cannot open output file '%s'\n", 
+		get_str("NATIVE"));
+		usage(NULL, NULL);
+	}
+	arOffset = (int32_t *)malloc(t->nDistCount * sizeof(int32_t));
+	MALLOC_CHECK(arOffset);
+
+	/* the header is rewritten with the index offset at the end */
+	arHeader[0] = DIST_NATIVE_MAGIC;
+	arHeader[1] = t->nDistCount;
+	arHeader[2] = 0;
+	if (fwrite(arHeader, sizeof(int32_t), 3, ofp) != 3)
+		err_cnt = 12;
+	offset = DIST_NATIVE_HEADER;
+
+	for (nDist=0; nDist < t->nDistCount; nDist++)
+	{
+		idx = t->pEntries + nDist;
+		d = idx->dist;
+		arOffset[nDist] = offset;
+
+		if (fwrite(d->type_vector, sizeof(int32_t), idx->v_width, ofp) != (size_t)idx->v_width)
+			err_cnt = 12;
+		offset += idx->v_width * sizeof(int32_t);
+
+		/* cumulative weights */
+		for (i=0; i < idx->w_width; i++)
+		{
+			nMax = 0;
+			for (j=0; j < idx->length; j++)
+			{
+				nMax += d->weight_sets[i][j];
+				if (fwrite(&nMax, sizeof(int32_t), 1, ofp) != 1)
+					err_cnt = 6;
+			}
+			offset += idx->length * sizeof(int32_t);
+		}
+
+		/* the maximum of each weight set */
+		for (i=0; i < idx->w_width; i++)
+		{
+			nMax = 0;
+			for (j=0; j < idx->length; j++)
+				nMax += d->weight_sets[i][j];
+			if (fwrite(&nMax, sizeof(int32_t), 1, ofp) != 1)
+				err_cnt = 6;
+			offset += sizeof(int32_t);
+		}
+
+		for (i=0; i < idx->v_width; i++)
+		{
+			if (fwrite(d->value_sets[i], sizeof(int32_t), idx->length, ofp) != (size_t)idx->length)
+				err_cnt = 8;
+			offset += idx->length * sizeof(int32_t);
+		}
+
+		if (d->names)
+		{
+			if (fwrite(d->names, 1, idx->name_space, ofp) < (size_t)idx->name_space)
+				err_cnt = 8;
+			offset += idx->name_space;
+		}
+
+		if (fwrite(d->strings, 1, idx->str_space, ofp) < (size_t)idx->str_space)
+			err_cnt = 8;
+		offset += idx->str_space;
+
+		/* keep the next distribution aligned */
+		nPad = (sizeof(int32_t) - offset % sizeof(int32_t)) % sizeof(int32_t);
+		if (nPad && (fwrite(szPad, 1, nPad, ofp) != (size_t)nPad))
+			err_cnt = 8;
+		offset += nPad;
+	}
+
+	/* the index, in the same order and form as the portable file */
+	arHeader[2] = offset;
+	for (i=0; i < t->nDistCount; i++)
+	{
+		idx = t->pEntries + i;
+		if (fwrite(idx->name, 1, D_NAME_LEN, ofp) != D_NAME_LEN)
+			{err_cnt = 9; break;}
+		temp = idx->index;
+		if (fwrite(&temp, sizeof(int32_t), 1, ofp) != 1)
+			{err_cnt = 10; break;}
+		if (fwrite(&arOffset[i], sizeof(int32_t), 1, ofp) != 1)
+			{err_cnt = 12; break;}
+		temp = idx->str_space;
+		if (fwrite(&temp, sizeof(int32_t), 1, ofp) != 1)
+			{err_cnt = 13; break;}
+		temp = idx->length;
+		if (fwrite(&temp, sizeof(int32_t), 1, ofp) != 1)
+			{err_cnt = 15; break;}
+		temp = idx->w_width;
+		if (fwrite(&temp, sizeof(int32_t), 1, ofp) != 1)
+			{err_cnt = 16; break;}
+		temp = idx->v_width;
+		if (fwrite(&temp, sizeof(int32_t), 1, ofp) != 1)
+			{err_cnt = 17; break;}
+		temp = idx->name_space;
+		if (fwrite(&temp, sizeof(int32_t), 1, ofp) != 1)
+			{err_cnt = 18; break;}
+	}
+
+	if (fseek(ofp, 0, SEEK_SET) || (fwrite(arHeader, sizeof(int32_t), 3, ofp) != 3))
+		err_cnt = 12;
+
+	fclose(ofp);
+	free(arOffset);
+
+   return(err_cnt);
+}    
+
  /*
  * Routine: main()
  * Purpose: provide command line interface to distcomp routines
@@ -323,5 +470,12 @@ int main(int argc, char* argv[])
 		ReportError(QERR_WRITE_FAILED, szPath, 1);
 		}
 
+	if (is_set("NATIVE") && ((i = WriteNativeIndex(pDistIndex)) > 0))
+		{
+		sprintf(szPath, "WriteNativeIndex returned %d writing to %s", 
+			i, get_str("NATIVE"));
+		ReportError(QERR_WRITE_FAILED, szPath, 1);
+		}
+
 	return 0;
 }
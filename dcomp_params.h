@@ -37,7 +37,7 @@
 #define DCOMP_PARAMS_H
 
 #include "r_params.h"
-#define MAX_PARAM	4
+#define MAX_PARAM	5
 #ifdef DECLARER
 
 option_t options[] =
@@ -49,6 +49,7 @@ option_t options[] =
 {"HELP",OPT_FLG,3, "display this message", usage, "N"},
 {"OUTPUT",OPT_STR,4, "output the compiled distributions to <s>", NULL, "."}, 
 {"HEADER",OPT_STR,5, "output distribution index names to header file <s>", NULL, ""},
+{"NATIVE",OPT_STR,6, "also write a native byte order copy for mapping to <s>", NULL, ""},
 {NULL}
 };
 
@@ -155,7 +155,7 @@ itodec(decimal_t *dest, int src)
 int
 ftodec(decimal_t *dest, double f)
 {
-	static char valbuf[20];
+	static THREAD char valbuf[20];
 
 	sprintf(valbuf, "%f", f);
 	
@@ -228,8 +228,8 @@ dectostr(char *dest, decimal_t *d)
 {
 	ds_key_t number;
 	int i;
-   static int bInit = 0;
-   static char szFormat[20];
+   static THREAD int bInit = 0;
+   static THREAD char szFormat[20];
 
    if (!bInit)
    {
@@ -247,6 +247,74 @@ dectostr(char *dest, decimal_t *d)
 	return(0);
 }
 
+/*
+ * Routine: dectoa(char *dest, decimal_t *d)
+ * Purpose: format a decimal as text using integer arithmetic only
+ * Algorithm: split the scaled integer into its whole and fractional parts
+ *	with a single division by 10^precision, then emit the digits directly.
+ *	The result matches printf("%.*f") of the exact value, without the
+ *	rounding a round trip through a double can introduce.
+ * Data Structures:
+ *
+ * Params: dest must have room for 21 characters plus the precision
+ * Returns: the number of characters written (no terminating NUL)
+ * Called By: print_decimal()
+ * Calls: 
+ * Assumptions:
+ * Side Effects:
+ * TODO: None
+ */
+int
+dectoa(char *dest, decimal_t *d)
+{
+	static ds_key_t arPowers[MAX_DECIMAL_PRECISION + 1] = {
+		1, 10, 100, 1000, 10000, 100000, 1000000, 10000000, 100000000,
+		1000000000, 10000000000LL, 100000000000LL, 1000000000000LL,
+		10000000000000LL, 100000000000000LL, 1000000000000000LL,
+		10000000000000000LL, 100000000000000000LL, 1000000000000000000LL};
+	char szDigits[48],
+		*cp = szDigits + sizeof(szDigits);
+	ds_key_t kWhole,
+		kFraction;
+	int i,
+		nDigit,
+		nLength;
+
+	if ((d->precision < 0) || (d->precision > MAX_DECIMAL_PRECISION))
+	{
+		double dTemp = (double)d->number;
+
+		for (i=0; i < d->precision; i++)
+			dTemp /= 10.0;
+		return(sprintf(dest, "%.*f", d->precision, dTemp));
+	}
+
+	/* both parts carry the sign of the number; the digits use its magnitude */
+	kWhole = d->number / arPowers[d->precision];
+	kFraction = d->number % arPowers[d->precision];
+	for (i=0; i < d->precision; i++)
+	{
+		nDigit = (int)(kFraction % 10);
+		*--cp = (char)('0' + ((nDigit < 0)?-nDigit:nDigit));
+		kFraction /= 10;
+	}
+	if (d->precision)
+		*--cp = '.';
+	do
+	{
+		nDigit = (int)(kWhole % 10);
+		*--cp = (char)('0' + ((nDigit < 0)?-nDigit:nDigit));
+		kWhole /= 10;
+	} while (kWhole);
+	if (d->number < 0)
+		*--cp = '-';
+
+	nLength = (int)(szDigits + sizeof(szDigits) - cp);
+	memcpy(dest, cp, nLength);
+
+	return(nLength);
+}
+
 /*
  * Routine: dectof(float *dest, decimal_t *d)
  * Purpose: convert a decimal structure to a double
@@ -52,6 +52,7 @@ typedef struct DECIMAL_T {
 } decimal_t;
 
 #define FL_INIT		0x0004
+#define MAX_DECIMAL_PRECISION	18	/* largest precision that fits a ds_key_t */
 
 decimal_t	*mk_decimal(int s, int p);
 
@@ -60,6 +61,7 @@ int ftodec(decimal_t *d, double f);
 int strtodec(decimal_t *d, char *src);
 
 int	dectostr(char *dest, decimal_t *d);
+int	dectoa(char *dest, decimal_t *d);
 int dectof(double *dest, decimal_t *);
 #define dectoi(d)	atoi(d->number)
 
@@ -45,6 +45,8 @@
 #else
 #include <sys/types.h>
 #include <sys/stat.h>
+#include <sys/mman.h>
+#include <unistd.h>
 #include <netinet/in.h>
 #endif
 #ifdef NCR
@@ -76,7 +78,19 @@ struct {char *name;} tdefs[] = {NULL};
 /* NOTE: these need to be in sync with a_dist.h */
 #define D_NAME_LEN	20
 #define FL_LOADED	0x01
+#define DIST_NAME_CACHE	64	/* name lookups remembered by find_dist() */
 static int load_dist(d_idx_t *d);
+static void parse_dist(d_idx_t *di);
+static int weight_search(int *pWeights, int nLength, int nLevel);
+static d_idx_t *map_native_index(char *szPath, int *pCount);
+DECLARE_LOCK(DistLock);
+
+/* the native distribution file, when one is in use */
+static char *pNativeMap = NULL;
+
+/* the index loaded by find_dist(), for dist_string() */
+static d_idx_t *pDistIndex = NULL;
+static int nDistIndexCount = 0;
 
 
 /*
@@ -122,6 +136,11 @@ find_dist(char *name)
 	static int index_loaded = 0,
 		entry_count;
 	static d_idx_t *idx = NULL;
+	static THREAD struct DIST_CACHE_T {
+		char *szName;
+		d_idx_t *pIndex;
+	} arNameCache[DIST_NAME_CACHE];
+	struct DIST_CACHE_T *pCache;
 	d_idx_t key,
 		*id = NULL;
 	int i;
@@ -133,6 +152,7 @@ find_dist(char *name)
 	if (!index_loaded)
 	{
 		/* make sure that this is read one thread at a time */
+		LOCK(DistLock);
 		if (!index_loaded)	/* make sure no one beat us to it */
 		{
 			
@@ -149,93 +169,127 @@ find_dist(char *name)
 					perror(get_str("DISTRIBUTIONS"));
 					exit(2);
 				}
-				entry_count = ntohl(temp);
-				if ((temp = fseek(ifp, -entry_count * IDX_SIZE, SEEK_END)) < 0)
+				if (temp == DIST_NATIVE_MAGIC)
 				{
-					fprintf(stderr, "Error: lseek to index failed: ");
-					fprintf(stderr, "attempting to reach %d\nSystem error: ", 
-						(int)(-entry_count * IDX_SIZE));
-					perror(get_str("DISTRIBUTIONS"));
-					exit(3);
+					/* a native file is mapped rather than read */
+					fclose(ifp);
+					ifp = NULL;
+					idx = map_native_index(get_str("DISTRIBUTIONS"), &entry_count);
 				}
-				idx = (d_idx_t *)malloc(entry_count * sizeof(d_idx_t));
-				MALLOC_CHECK(idx);
-				for (i=0; i < entry_count; i++)
+				else
 				{
-					memset(idx + i, 0, sizeof(d_idx_t));
-					if (fread( idx[i].name,  1, D_NAME_LEN, ifp) < D_NAME_LEN)
-					{
-						fprintf(stderr, "Error: read index failed (1): ");
-						perror(get_str("DISTRIBUTIONS"));
-						exit(2);
-					}
-					idx[i].name[D_NAME_LEN] = '\0';
-					if (fread( &temp,  1, sizeof(int32_t), ifp) != sizeof(int32_t))
-					{
-						fprintf(stderr, "Error: read index failed (2): ");
-						perror(get_str("DISTRIBUTIONS"));
-						exit(2);
-					}
-					idx[i].index = ntohl(temp);
-					if (fread( &temp,  1, sizeof(int32_t), ifp) != sizeof(int32_t))
-					{
-						fprintf(stderr, "Error: read index failed (4): ");
-						perror(get_str("DISTRIBUTIONS"));
-						exit(2);
-					}
-					idx[i].offset = ntohl(temp);
-					if (fread( &temp,  1, sizeof(int32_t), ifp) != sizeof(int32_t))
-					{
-						fprintf(stderr, "Error: read index failed (5): ");
-						perror(get_str("DISTRIBUTIONS"));
-						exit(2);
-					}
-					idx[i].str_space = ntohl(temp);
-					if (fread( &temp, 1, sizeof(int32_t), ifp) != sizeof(int32_t))
-					{
-						fprintf(stderr, "Error: read index failed (6): ");
-						perror(get_str("DISTRIBUTIONS"));
-						exit(2);
-					}
-					idx[i].length = ntohl(temp);
-					if (fread( &temp, 1, sizeof(int32_t), ifp) != sizeof(int32_t))
-					{
-						fprintf(stderr, "Error: read index failed (7): ");
-						perror(get_str("DISTRIBUTIONS"));
-						exit(2);
-					}
-					idx[i].w_width = ntohl(temp);
-					if (fread( &temp, 1, sizeof(int32_t), ifp) != sizeof(int32_t))
+					entry_count = ntohl(temp);
+					if ((temp = fseek(ifp, -entry_count * IDX_SIZE, SEEK_END)) < 0)
 					{
-						fprintf(stderr, "Error: read index failed (8): ");
+						fprintf(stderr, "Error: lseek to index failed: ");
+						fprintf(stderr, "attempting to reach %d\nSystem error: ", 
+							(int)(-entry_count * IDX_SIZE));
 						perror(get_str("DISTRIBUTIONS"));
-						exit(2);
+						exit(3);
 					}
-					idx[i].v_width = ntohl(temp);
-					if (fread( &temp,  1, sizeof(int32_t), ifp) != sizeof(int32_t))
+					idx = (d_idx_t *)malloc(entry_count * sizeof(d_idx_t));
+					MALLOC_CHECK(idx);
+					for (i=0; i < entry_count; i++)
 					{
-						fprintf(stderr, "Error: read index failed (9): ");
-						perror(get_str("DISTRIBUTIONS"));
-						exit(2);
+						memset(idx + i, 0, sizeof(d_idx_t));
+						if (fread( idx[i].name,  1, D_NAME_LEN, ifp) < D_NAME_LEN)
+						{
+							fprintf(stderr, "Error: read index failed (1): ");
+							perror(get_str("DISTRIBUTIONS"));
+							exit(2);
+						}
+						idx[i].name[D_NAME_LEN] = '\0';
+						if (fread( &temp,  1, sizeof(int32_t), ifp) != sizeof(int32_t))
+						{
+							fprintf(stderr, "Error: read index failed (2): ");
+							perror(get_str("DISTRIBUTIONS"));
+							exit(2);
+						}
+						idx[i].index = ntohl(temp);
+						if (fread( &temp,  1, sizeof(int32_t), ifp) != sizeof(int32_t))
+						{
+							fprintf(stderr, "Error: read index failed (4): ");
+							perror(get_str("DISTRIBUTIONS"));
+							exit(2);
+						}
+						idx[i].offset = ntohl(temp);
+						if (fread( &temp,  1, sizeof(int32_t), ifp) != sizeof(int32_t))
+						{
+							fprintf(stderr, "Error: read index failed (5): ");
+							perror(get_str("DISTRIBUTIONS"));
+							exit(2);
+						}
+						idx[i].str_space = ntohl(temp);
+						if (fread( &temp, 1, sizeof(int32_t), ifp) != sizeof(int32_t))
+						{
+							fprintf(stderr, "Error: read index failed (6): ");
+							perror(get_str("DISTRIBUTIONS"));
+							exit(2);
+						}
+						idx[i].length = ntohl(temp);
+						if (fread( &temp, 1, sizeof(int32_t), ifp) != sizeof(int32_t))
+						{
+							fprintf(stderr, "Error: read index failed (7): ");
+							perror(get_str("DISTRIBUTIONS"));
+							exit(2);
+						}
+						idx[i].w_width = ntohl(temp);
+						if (fread( &temp, 1, sizeof(int32_t), ifp) != sizeof(int32_t))
+						{
+							fprintf(stderr, "Error: read index failed (8): ");
+							perror(get_str("DISTRIBUTIONS"));
+							exit(2);
+						}
+						idx[i].v_width = ntohl(temp);
+						if (fread( &temp,  1, sizeof(int32_t), ifp) != sizeof(int32_t))
+						{
+							fprintf(stderr, "Error: read index failed (9): ");
+							perror(get_str("DISTRIBUTIONS"));
+							exit(2);
+						}
+						idx[i].name_space = ntohl(temp);
+						idx[i].dist = NULL;
 					}
-					idx[i].name_space = ntohl(temp);
-					idx[i].dist = NULL;
 				}
 				qsort((void *)idx, entry_count, sizeof(d_idx_t), di_compare);
+				pDistIndex = idx;
+				nDistIndexCount = entry_count;
 				index_loaded = 1;
 				
 				/* make sure that this is read one thread at a time */
-			fclose(ifp);
+			if (ifp)
+				fclose(ifp);
 		}
+		UNLOCK(DistLock);
 	}
 	
-	/* find the distribution, if it exists and move to it */
-	strcpy(key.name, name);
-	id = (d_idx_t *)bsearch((void *)&key, (void *)idx, entry_count, 
-		sizeof(d_idx_t), di_compare);
+	/* 
+	 * callers almost always pass a string constant, so remember where each
+	 * name pointer led last time; the name is still compared, since the
+	 * same buffer could be reused for another distribution
+	 */
+	pCache = &arNameCache[((size_t)name >> 2) % DIST_NAME_CACHE];
+	if ((pCache->szName == name) && !strcasecmp(name, pCache->pIndex->name))
+		id = pCache->pIndex;
+	else
+	{
+		/* find the distribution, if it exists and move to it */
+		strcpy(key.name, name);
+		id = (d_idx_t *)bsearch((void *)&key, (void *)idx, entry_count, 
+			sizeof(d_idx_t), di_compare);
+		if (id != NULL)
+		{
+			pCache->szName = name;
+			pCache->pIndex = id;
+		}
+	}
 	if (id != NULL)	/* found a valid distribution */
 		if (id->flags != FL_LOADED)	 /* but it needs to be loaded */
+		{
+			LOCK(DistLock);
 			load_dist(id);
+			UNLOCK(DistLock);
+		}
 		
 		
 		
@@ -266,6 +320,41 @@ load_dist(d_idx_t *di)
 	int32_t temp;
 	FILE *ifp;
 	
+	/* a mapped native file already holds the arrays; just point at them */
+	if (pNativeMap && (di->flags != FL_LOADED))
+	{
+		char *pData = pNativeMap + di->offset;
+
+		d = (dist_t *)malloc(sizeof(struct DIST_T) + (di->w_width + di->v_width) * sizeof(int *));
+		MALLOC_CHECK(d);
+		memset(d, 0, sizeof(struct DIST_T));
+		d->weight_sets = (int **)(d + 1);
+		d->value_sets = d->weight_sets + di->w_width;
+		d->type_vector = (int *)pData;
+		pData += di->v_width * sizeof(int32_t);
+		for (i=0; i < di->w_width; i++)
+		{
+			d->weight_sets[i] = (int *)pData;
+			pData += di->length * sizeof(int32_t);
+		}
+		d->maximums = (int *)pData;
+		pData += di->w_width * sizeof(int32_t);
+		for (i=0; i < di->v_width; i++)
+		{
+			d->value_sets[i] = (int *)pData;
+			pData += di->length * sizeof(int32_t);
+		}
+		if (di->name_space)
+			d->names = pData;
+		pData += di->name_space;
+		d->strings = pData;
+
+		di->dist = d;
+		parse_dist(di);
+		di->flags = FL_LOADED;
+		return(res);
+	}
+
 	if (di->flags != FL_LOADED)	/* make sure no one beat us to it */
 	{
 			if ((ifp = fopen(get_str("DISTRIBUTIONS"), "rb")) == NULL)
@@ -369,6 +458,7 @@ load_dist(d_idx_t *di)
 		}
 	
 	fclose(ifp);
+	parse_dist(di);
 	di->flags = FL_LOADED;
 	}
 
@@ -377,6 +467,198 @@ load_dist(d_idx_t *di)
 	return(res);
 }
 
+/*
+* Routine: parse_dist(d_idx_t *di)
+* Purpose: convert the int, date and decimal value sets of a distribution once,
+*	rather than on every pick
+* Algorithm:
+* Data Structures:
+*
+* Params:
+* Returns:
+* Called By: load_dist()
+* Calls: strtodt(), strtodec()
+* Assumptions: called under DistLock, before the distribution is marked loaded
+* Side Effects:
+* TODO: None
+*/
+static void
+parse_dist(d_idx_t *di)
+{
+	dist_t *d = di->dist;
+	int i,
+		j,
+		*pInt;
+	date_t *pDate;
+	decimal_t *pDecimal;
+
+	d->parsed_sets = (void **)malloc(di->v_width * sizeof(void *));
+	MALLOC_CHECK(d->parsed_sets);
+	for (i=0; i < di->v_width; i++)
+	{
+		d->parsed_sets[i] = NULL;
+		switch(d->type_vector[i])
+		{
+		case TKN_INT:
+			pInt = (int *)malloc(di->length * sizeof(int));
+			MALLOC_CHECK(pInt);
+			for (j=0; j < di->length; j++)
+				pInt[j] = atoi(d->strings + d->value_sets[i][j]);
+			d->parsed_sets[i] = pInt;
+			break;
+		case TKN_DATE:
+			pDate = (date_t *)malloc(di->length * sizeof(date_t));
+			MALLOC_CHECK(pDate);
+			memset(pDate, 0, di->length * sizeof(date_t));
+			for (j=0; j < di->length; j++)
+				strtodt(pDate + j, d->strings + d->value_sets[i][j]);
+			d->parsed_sets[i] = pDate;
+			break;
+		case TKN_DECIMAL:
+			pDecimal = (decimal_t *)malloc(di->length * sizeof(decimal_t));
+			MALLOC_CHECK(pDecimal);
+			for (j=0; j < di->length; j++)
+				strtodec(pDecimal + j, d->strings + d->value_sets[i][j]);
+			d->parsed_sets[i] = pDecimal;
+			break;
+		}
+	}
+
+	return;
+}
+
+/*
+* Routine: weight_search(int *pWeights, int nLength, int nLevel)
+* Purpose: find the first entry whose cumulative weight reaches nLevel
+* Algorithm: binary search; the weights are cumulative, so this is the entry
+*	the original linear walk stopped on
+* Data Structures:
+*
+* Params:
+* Returns: an index in [0, nLength]; nLength if nLevel exceeds every weight
+* Called By: dist_op_idx(), MatchDistWeight()
+* Calls: 
+* Assumptions:
+* Side Effects:
+* TODO: None
+*/
+static int
+weight_search(int *pWeights, int nLength, int nLevel)
+{
+	int nLow = 0,
+		nHigh = nLength,
+		nMid;
+
+	while (nLow < nHigh)
+	{
+		nMid = (nLow + nHigh) / 2;
+		if (pWeights[nMid] < nLevel)
+			nLow = nMid + 1;
+		else
+			nHigh = nMid;
+	}
+
+	return(nLow);
+}
+
+/*
+* Routine: map_native_index(char *szPath, int *pCount)
+* Purpose: map a native distribution file and build the index from it
+* Algorithm: the whole file is mapped once; load_dist() then points each
+*	dist_t at its arrays inside the mapping, so nothing is parsed or byte
+*	swapped, and -CHILD processes share the pages
+* Data Structures:
+*
+* Params:
+* Returns: an index of *pCount entries, in file order
+* Called By: find_dist()
+* Calls: 
+* Assumptions: the file was written by distcomp on a machine of the same byte order
+* Side Effects: sets pNativeMap; the mapping is kept for the life of the process
+* TODO: None
+*/
+static d_idx_t *
+map_native_index(char *szPath, int *pCount)
+{
+	d_idx_t *idx;
+	int32_t *pHeader,
+		*pEntry;
+	char *pIndex;
+	int i,
+		nLength;
+#ifndef WIN32
+	int fd;
+	struct stat st;
+
+	if (((fd = open(szPath, O_RDONLY)) < 0) || (fstat(fd, &st) < 0))
+	{
+		fprintf(stderr, "Error: open of distributions failed: ");
+		perror(szPath);
+		exit(1);
+	}
+	nLength = (int)st.st_size;
+	pNativeMap = (char *)mmap(NULL, nLength, PROT_READ, MAP_PRIVATE, fd, 0);
+	if (pNativeMap == (char *)MAP_FAILED)
+	{
+		fprintf(stderr, "Error: map of distributions failed: ");
+		perror(szPath);
+		exit(2);
+	}
+	close(fd);
+#else
+	FILE *ifp;
+
+	if ((ifp = fopen(szPath, "rb")) == NULL)
+	{
+		fprintf(stderr, "Error: open of distributions failed: ");
+		perror(szPath);
+		exit(1);
+	}
+	fseek(ifp, 0, SEEK_END);
+	nLength = (int)ftell(ifp);
+	fseek(ifp, 0, SEEK_SET);
+	pNativeMap = (char *)malloc(nLength);
+	MALLOC_CHECK(pNativeMap);
+	if (fread(pNativeMap, 1, nLength, ifp) != (size_t)nLength)
+	{
+		fprintf(stderr, "Error: read of distributions failed: ");
+		perror(szPath);
+		exit(2);
+	}
+	fclose(ifp);
+#endif
+
+	pHeader = (int32_t *)pNativeMap;
+	*pCount = pHeader[1];
+	if ((nLength < (int)DIST_NATIVE_HEADER) 
+		|| (pHeader[2] + *pCount * (int)IDX_SIZE > nLength))
+	{
+		fprintf(stderr, "Error: distribution file '%s' is truncated\n", szPath);
+		exit(3);
+	}
+
+	idx = (d_idx_t *)malloc(*pCount * sizeof(d_idx_t));
+	MALLOC_CHECK(idx);
+	pIndex = pNativeMap + pHeader[2];
+	for (i=0; i < *pCount; i++)
+	{
+		memset(idx + i, 0, sizeof(d_idx_t));
+		memcpy(idx[i].name, pIndex, D_NAME_LEN);
+		idx[i].name[D_NAME_LEN] = '\0';
+		pEntry = (int32_t *)(pIndex + D_NAME_LEN);
+		idx[i].index = pEntry[0];
+		idx[i].offset = pEntry[1];
+		idx[i].str_space = pEntry[2];
+		idx[i].length = pEntry[3];
+		idx[i].w_width = pEntry[4];
+		idx[i].v_width = pEntry[5];
+		idx[i].name_space = pEntry[6];
+		pIndex += IDX_SIZE;
+	}
+
+	return(idx);
+}
+
 /*
 * Routine: void *dist_op()
 * Purpose: select a value/weight from a distribution
@@ -397,12 +679,6 @@ int
 dist_op(void *dest, int op, char *d_name, int vset, int wset, int stream)
 {
 	d_idx_t *d;
-	dist_t *dist;
-	int	level,
-		index = 0,
-		dt;
-	char *char_val;
-	int i_res = 1;
 	
 	if ((d = find_dist(d_name)) == NULL)
 	{
@@ -411,16 +687,52 @@ dist_op(void *dest, int op, char *d_name, int vset, int wset, int stream)
 		INTERNAL(msg);
 		assert(d != NULL);
 	}
+	
+	return(dist_op_idx(dest, op, d, vset, wset, stream));
+}
+
+/*
+* Routine: dist_op_idx()
+* Purpose: dist_op() for a distribution already found with find_dist()
+* Algorithm: picks use a binary search of the cumulative weights, and
+*	int/date/decimal values come from the sets converted by parse_dist();
+*	the random draws are the same as before
+* Data Structures:
+*
+* Params:	d_idx_t *d: from find_dist()
+*			int vset: which set of values
+*			int wset: which set of weights
+* Returns: appropriate data type cast as a void *
+* Called By: dist_op(), and builders that resolve their distributions once
+* Calls: 
+* Assumptions:
+* Side Effects:
+* TODO: None
+*/
+int
+dist_op_idx(void *dest, int op, d_idx_t *d, int vset, int wset, int stream)
+{
+	dist_t *dist;
+	int	level,
+		index = 0,
+		dt;
+	char *char_val;
+	int i_res = 1;
+	date_t *pDate;
 		
+	if (d->flags != FL_LOADED)
+	{
+		LOCK(DistLock);
+		load_dist(d);
+		UNLOCK(DistLock);
+	}
 	dist = d->dist;
 	
 	if (op == 0)
 	{
 		genrand_integer(&level, DIST_UNIFORM, 1, 
 			dist->maximums[wset - 1], 0, stream);
-		while (level > dist->weight_sets[wset - 1][index] && 
-			index < d->length)
-			index += 1;
+		index = weight_search(dist->weight_sets[wset - 1], d->length, level);
 		dt = vset - 1;
 		if ((index >= d->length) || (dt > d->v_width))
 			INTERNAL("Distribution overrun");
@@ -450,7 +762,7 @@ dist_op(void *dest, int op, char *d_name, int vset, int wset, int stream)
 			*(char **)dest = (char *)char_val;
 		break;
 	case TKN_INT:
-		i_res = atoi(char_val);
+		i_res = ((int *)dist->parsed_sets[dt])[index];
 		if (dest)
 			*(int *)dest = i_res;
 		break;
@@ -460,7 +772,12 @@ dist_op(void *dest, int op, char *d_name, int vset, int wset, int stream)
 			dest = (date_t *)malloc(sizeof(date_t));
 			MALLOC_CHECK(dest);
 		}
-		strtodt(*(date_t **)dest, char_val);
+		/* strtodt() leaves the flags alone, so only copy what it sets */
+		pDate = (date_t *)dist->parsed_sets[dt] + index;
+		(*(date_t **)dest)->year = pDate->year;
+		(*(date_t **)dest)->month = pDate->month;
+		(*(date_t **)dest)->day = pDate->day;
+		(*(date_t **)dest)->julian = pDate->julian;
 		break;
 	case TKN_DECIMAL:
 		if (dest == NULL)
@@ -468,7 +785,7 @@ dist_op(void *dest, int op, char *d_name, int vset, int wset, int stream)
 			dest = (decimal_t *)malloc(sizeof(decimal_t));
 			MALLOC_CHECK(dest);
 		}
-		strtodec(*(decimal_t **)dest,char_val);
+		**(decimal_t **)dest = ((decimal_t *)dist->parsed_sets[dt])[index];
 		break;
 	}
 	
@@ -840,9 +1157,7 @@ int MatchDistWeight(void *dest, char *szDist, int nWeight, int nWeightSet, int V
 		dist = d->dist;
 		nWeight %= dist->maximums[nWeightSet - 1];
 		
-		while (nWeight > dist->weight_sets[nWeightSet - 1][index] && 
-			index < d->length)
-			index += 1;
+		index = weight_search(dist->weight_sets[nWeightSet - 1], d->length, nWeight);
 		dt = ValueSet - 1;
 		if (index >= d->length)
 			index = d->length - 1;
@@ -925,6 +1240,52 @@ findDistValue(char *szValue, char *szDistName, int ValueSet)
 }
 
 
+/*
+* Routine: dist_string(char *szValue, d_idx_t **ppDist)
+* Purpose: recognize a varchar value that dist_op() picked from a distribution
+* Algorithm: dist_op() hands back pointers into the string space of the 
+*	distribution, so such a value is identified by where it lies, without
+*	looking at its characters. *ppDist is tried first, since a column 
+*	usually draws from a single distribution; if it is NULL, the loaded
+*	distributions are searched and *ppDist is set to the one that holds the
+*	value.
+* Data Structures:
+*
+* Params:
+* Returns: the offset of szValue in the string space of *ppDist, or -1
+* Called By: parquet_dictionary()
+* Calls: 
+* Assumptions:
+* Side Effects:
+* TODO: None
+*/
+int
+dist_string(char *szValue, d_idx_t **ppDist)
+{
+	d_idx_t *d;
+	int i;
+
+	if ((d = *ppDist) != NULL)
+	{
+		if ((szValue >= d->dist->strings) && (szValue < d->dist->strings + d->str_space))
+			return((int)(szValue - d->dist->strings));
+		return(-1);
+	}
+
+	for (i=0; i < nDistIndexCount; i++)
+	{
+		d = &pDistIndex[i];
+		if ((d->flags != FL_LOADED) || (d->dist == NULL) || (d->dist->strings == NULL))
+			continue;
+		if ((szValue >= d->dist->strings) && (szValue < d->dist->strings + d->str_space))
+		{
+			*ppDist = d;
+			return((int)(szValue - d->dist->strings));
+		}
+	}
+
+	return(-1);
+}
 
 
 
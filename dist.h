@@ -46,6 +46,7 @@ typedef struct DIST_T {
 	char *strings;
 	char *names;
 	int	size;
+	void **parsed_sets;	/* int, date_t or decimal_t values of each value set, converted at load time; NULL for varchar */
 	} dist_t;
 
 typedef struct D_IDX_T {
@@ -72,10 +73,31 @@ typedef struct DISTINDEX_T {
 /* must match WriteDist() in dcomp.c */
 #define IDX_SIZE	(D_NAME_LEN + 7 * sizeof(int))	
 
+/*
+ * native layout, written by WriteNativeIndex() in dcomp.c alongside the
+ * portable file, and mapped in place by dist.c. All integers are int32_t in
+ * the byte order of the machine that ran distcomp.
+ *	header: DIST_NATIVE_MAGIC, distribution count, offset of the index
+ *	each distribution, starting on a 4 byte boundary:
+ *		type vector (v_width), weight sets (w_width x length, already
+ *		cumulative), maximums (w_width), value offsets (v_width x length),
+ *		aliases (name_space bytes), strings (str_space bytes)
+ *	index: one IDX_SIZE entry per distribution, laid out as in the portable file
+ */
+#define DIST_NATIVE_MAGIC	0x4E534454
+#define DIST_NATIVE_HEADER	(3 * sizeof(int32_t))
+
 int	dist_op(void *dest, int op, char *d_name, int vset, int wset, int stream);
 #define pick_distribution(dest, dist, v, w, s)	dist_op(dest, 0, dist, v, w, s)
 #define dist_member(dest, dist, v, w)		dist_op(dest, 1, dist, v, w, 0)
 #define	dist_max(dist, w)		dist->maximums[w - 1]
+/* 
+ * the same operations on a distribution already resolved with find_dist(), 
+ * for callers that use it on every row
+ */
+int	dist_op_idx(void *dest, int op, d_idx_t *d, int vset, int wset, int stream);
+#define pick_distribution_idx(dest, d, v, w, s)	dist_op_idx(dest, 0, d, v, w, s)
+#define dist_member_idx(dest, d, v, w)		dist_op_idx(dest, 1, d, v, w, 0)
 int dist_weight(int *dest, char *d, int index, int wset);
 int distsize(char *szDistname);
 int dist_type(char *szDistName, int vset);
@@ -87,6 +109,7 @@ int DistNameIndex(char *szDist, int nNameType, char *szName);
 int DistSizeToShiftWidth(char *szDist, int nWeightSet);
 int MatchDistWeight(void *dest, char *szDist, int nWeight, int nWeightSet, int ValueSet);
 int findDistValue(char *szValue, char *szDistName, int ValueSet);
+int dist_string(char *szValue, d_idx_t **ppDist);
 int di_compare(const void *op1, const void *op2);
 
 
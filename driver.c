@@ -68,6 +68,11 @@
 #include "grammar_support.h" /* to get definition of file_ref_t */
 #include "address.h" /* for access to resetCountyCount() */
 #include "scd.h"
+#include "constants.h"
+#include "runtime.h"
+#include "stats.h"
+#include "progress.h"
+#include "context.h"
 
 
 extern int optind, opterr;
@@ -78,62 +83,6 @@ file_ref_t CurrentFile;
 file_ref_t *pCurrentFile;
 
 
-/*
-* Routine: 
-* Purpose: 
-* Algorithm:
-* Data Structures:
-*
-* Params:
-* Returns:
-* Called By: 
-* Calls: 
-* Assumptions:
-* Side Effects:
-* TODO: None
-*/
-ds_key_t
-skipDays(int nTable, ds_key_t *pRemainder)
-{
-	static int bInit = 0;
-   static date_t BaseDate;
-   ds_key_t jDate;
-	ds_key_t kRowCount,
-		kFirstRow,
-      kDayCount,
-      index = 1;
-
-   if (!bInit)
-   {
-      strtodt(&BaseDate, DATA_START_DATE);
-      bInit = 1;
-      *pRemainder = 0;
-   }
-	
-   // set initial conditions
-   jDate = BaseDate.julian;
-  *pRemainder = dateScaling(nTable, jDate) + index;
-
-  // now check to see if we need to move to the 
-  // the next peice of a parallel build
-  // move forward one day at a time
-  split_work(nTable, &kFirstRow, &kRowCount);
-  while (index < kFirstRow)
-  {
-     kDayCount = dateScaling(nTable, jDate);
-     index += kDayCount;
-     jDate += 1;
-     *pRemainder = index;
-  }
-  if (index > kFirstRow)
-  {
-     jDate -= 1;
-  }
-	
-	return(jDate);
-}
-
-
 /*
 * Routine: find_table(char *, char *)
 * Purpose: partial match routine for arguments to -T
@@ -244,6 +193,390 @@ set_files (int i)
 	return (0);
 }
 
+#ifdef USE_THREADS
+/*
+ * a chunk of a table, as built by a scheduler thread under -THREADS
+ */
+typedef struct WORKER_T {
+	int nTable;
+	int nChunk;
+	ds_key_t kFirstRow;
+	ds_key_t kRowCount;
+	int nChunks;	/* a table built as a single chunk needs no spool file */
+	rng_t *pStreams;	/* main thread's RNG state */
+	tdef *pTdefs;	/* main thread's table definitions */
+} worker_t;
+
+/*
+* Routine: gen_chunk(worker_t *pW)
+* Purpose: build one chunk of a table for -THREADS
+* Algorithm: start from a copy of the main thread's RNG and table definitions
+*	and a fresh gen_ctx_t, so that nothing is left over from the previous 
+*	task run on the same thread, move the streams to the start of the chunk 
+*	with row_skip() (as a -CHILD process would), and write to a spool file 
+*	that task_done() merges later. Chunk 0 writes directly to the output file.
+* Data Structures:
+*
+* Params:
+* Returns:
+* Called By: gen_task()
+* Calls: 
+* Assumptions:
+* Side Effects:
+* TODO: None
+*/
+static void
+gen_chunk(worker_t *pW)
+{
+	int direct = is_set("DBLOAD");
+	ds_key_t i;
+	tdef *pT;
+	table_func_t *pF = getTdefFunctionsByNumber(pW->nTable);
+	gen_ctx_t *pCtx = ctx_new();
+
+	RNGRestore(pW->pStreams);
+	restoreTdefs(pW->pTdefs);
+	set_chunk(pW->kFirstRow, pW->kRowCount);
+	print_spool((pW->nChunks > 1)?pW->nChunk:-1);
+	progress_thread(pW->nTable);
+	stats_start(pW->nTable, pW->nChunk, pW->kRowCount);
+
+	pT = getSimpleTdefsByNumber(pW->nTable);
+	row_skip(pW->nTable, pW->kFirstRow - 1);
+	if (pT->flags & FL_PARENT)
+		row_skip(pT->nParam, pW->kFirstRow - 1);
+
+	for (i=pW->kFirstRow; i < pW->kFirstRow + pW->kRowCount; i++)
+	{
+		if (!pF->builder(pCtx, NULL, i))
+			if (pF->loader[direct](NULL))
+			{
+				fprintf(stderr, "ERROR: Load failed on %s!\n", getTableNameByID(pW->nTable));
+				exit(-1);
+			}
+		row_stop(pW->nTable);
+		if (g_Runtime.bProgress)
+			progress_row();
+	}
+	print_close(pW->nTable);
+	progress_flush();
+	stats_end();
+	ctx_free(pCtx);
+
+	return;
+}
+
+/*
+ * -THREADS: each table, or chunk of a date based table, is a task; 
+ * gen_schedule() hands them out largest first
+ */
+typedef struct TASK_T {
+	worker_t Worker;
+	ds_key_t kCost;
+} task_t;
+
+static task_t *arTasks = NULL;
+static int nTasks = 0,
+	nNextTask = 0,
+	bScheduleVerbose = 0;
+static struct {
+	ds_key_t kRowCount;
+	int nChunks;
+	int nStarted;
+	int nFinished;
+	ds_key_t kStart;
+} arSchedule[MAX_TABLE + 1];
+DECLARE_LOCK(TaskLock);
+
+/*
+* Routine: task_weight(int nTable)
+* Purpose: estimate the cost of one call to the builder of a table
+* Algorithm: the number of RNG columns, which tracks the work done per row; 
+*	a sales builder produces an order of 8 to 16 line items, each of which
+*	may also produce a return
+* Data Structures:
+*
+* Params:
+* Returns:
+* Called By: schedule_table()
+* Calls: 
+* Assumptions:
+* Side Effects:
+* TODO: None
+*/
+static ds_key_t
+task_weight(int nTable)
+{
+	tdef *pT = getSimpleTdefsByNumber(nTable),
+		*pC;
+	ds_key_t kWeight;
+
+	kWeight = pT->nLastColumn - pT->nFirstColumn + 1;
+	if (pT->flags & FL_PARENT)
+	{
+		pC = getSimpleTdefsByNumber(pT->nParam);
+		kWeight += pC->nLastColumn - pC->nFirstColumn + 1;
+		kWeight *= (LINES_PER_ORDER * 3) / 4;
+	}
+
+	return(kWeight);
+}
+
+/*
+* Routine: task_compare(const void *pA, const void *pB)
+* Purpose: order tasks by decreasing cost
+* Algorithm: ties are broken by table and chunk, so that the order does not
+*	depend on qsort()
+* Data Structures:
+*
+* Params:
+* Returns:
+* Called By: gen_schedule(), through qsort()
+* Calls: 
+* Assumptions:
+* Side Effects:
+* TODO: None
+*/
+static int
+task_compare(const void *pA, const void *pB)
+{
+	const task_t *pTaskA = (const task_t *)pA,
+		*pTaskB = (const task_t *)pB;
+
+	if (pTaskA->kCost != pTaskB->kCost)
+		return((pTaskA->kCost > pTaskB->kCost)?-1:1);
+	if (pTaskA->Worker.nTable != pTaskB->Worker.nTable)
+		return(pTaskA->Worker.nTable - pTaskB->Worker.nTable);
+
+	return(pTaskA->Worker.nChunk - pTaskB->Worker.nChunk);
+}
+
+/*
+* Routine: schedule_table(int tabid, ds_key_t kFirstRow, ds_key_t kRowCount)
+* Purpose: add the tasks for a table to the schedule
+* Algorithm: a date based table is cut into CHUNKS_PER_THREAD chunks per 
+*	thread, of at least MIN_MULTI_THREAD_ROWS rows each; any other table is
+*	a single task. Rows are orders for the sales tables, so the output of a 
+*	chunk varies with its line items and returns; many small chunks handed 
+*	out as threads come free keep that from leaving one thread to finish 
+*	long after the others. Under -SHARDS every table is a single task, as
+*	each shard file is written by the one thread that builds the table.
+* Data Structures:
+*
+* Params:
+* Returns:
+* Called By: main(), gen_tbl()
+* Calls: 
+* Assumptions: kFirstRow and kRowCount come from split_work()
+* Side Effects:
+* TODO: None
+*/
+static void
+schedule_table(int tabid, ds_key_t kFirstRow, ds_key_t kRowCount)
+{
+	int i,
+		nChunks = 1;
+	ds_key_t kChunkSize,
+		kExtraRows,
+		kWeight = task_weight(tabid);
+	task_t *pTask;
+	tdef *pT = getSimpleTdefsByNumber(tabid);
+
+	if ((pT->flags & FL_DATE_BASED) && !g_Runtime.nShards)
+	{
+		nChunks = get_int("THREADS") * CHUNKS_PER_THREAD;
+		if (nChunks > kRowCount / MIN_MULTI_THREAD_ROWS)
+			nChunks = (int)(kRowCount / MIN_MULTI_THREAD_ROWS);
+		if (nChunks < 1)
+			nChunks = 1;
+	}
+	arSchedule[tabid].kRowCount = kRowCount;
+	arSchedule[tabid].nChunks = nChunks;
+
+	arTasks = (task_t *)realloc(arTasks, (nTasks + nChunks) * sizeof(task_t));
+	MALLOC_CHECK(arTasks);
+	kExtraRows = kRowCount % nChunks;
+	kChunkSize = (kRowCount - kExtraRows) / nChunks;
+	for (i=0; i < nChunks; i++)
+	{
+		pTask = &arTasks[nTasks++];
+		memset(pTask, 0, sizeof(task_t));
+		pTask->Worker.nTable = tabid;
+		pTask->Worker.nChunk = i;
+		pTask->Worker.nChunks = nChunks;
+		pTask->Worker.kFirstRow = kFirstRow;
+		pTask->Worker.kRowCount = kChunkSize + ((i < kExtraRows)?1:0);
+		pTask->kCost = pTask->Worker.kRowCount * kWeight;
+		kFirstRow += pTask->Worker.kRowCount;
+	}
+
+	return;
+}
+
+/*
+* Routine: task_done(int tabid)
+* Purpose: finish a table once its last task is complete
+* Algorithm:
+* Data Structures:
+*
+* Params:
+* Returns:
+* Called By: gen_task()
+* Calls: 
+* Assumptions:
+* Side Effects:
+* TODO: None
+*/
+static void
+task_done(int tabid)
+{
+	tdef *pT = getSimpleTdefsByNumber(tabid),
+		*pC;
+
+	if (arSchedule[tabid].nChunks > 1)
+	{
+		stats_start(tabid, STATS_MERGE, 0);
+		print_merge(tabid, arSchedule[tabid].nChunks);
+		if (pT->flags & FL_PARENT)
+			print_merge(pT->nParam, arSchedule[tabid].nChunks);
+		stats_end();
+		stats_table(tabid, stats_clock() - arSchedule[tabid].kStart);
+	}
+	progress_end(tabid);
+
+	if (bScheduleVerbose)
+	{
+		if (pT->flags & FL_PARENT)
+		{
+			pC = getSimpleTdefsByNumber(pT->nParam);
+			fprintf(stderr, "%s %s and %s ... Done\n", 
+				is_set("DBLOAD")?"Loading":"Writing", pT->name, pC->name);
+		}
+		else
+			fprintf(stderr, "%s %s ... Done\n", 
+				is_set("DBLOAD")?"Loading":"Writing", pT->name);
+	}
+
+	return;
+}
+
+/*
+* Routine: gen_task(void *pArg)
+* Purpose: body of a scheduler thread; run tasks until none are left
+* Algorithm: each task is built in turn on this thread by gen_chunk(), 
+*	which resets the per thread generator state first. Whichever thread 
+*	finishes the last task of a table merges its spool files.
+* Data Structures:
+*
+* Params:
+* Returns:
+* Called By: gen_schedule()
+* Calls: gen_chunk(), task_done()
+* Assumptions:
+* Side Effects:
+* TODO: None
+*/
+static void *
+gen_task(void *pArg)
+{
+	task_t *pTask;
+	int nTable,
+		bLast;
+
+	for (;;)
+	{
+		LOCK(TaskLock);
+		if (nNextTask == nTasks)
+		{
+			UNLOCK(TaskLock);
+			break;
+		}
+		pTask = &arTasks[nNextTask++];
+		nTable = pTask->Worker.nTable;
+		if (arSchedule[nTable].nStarted++ == 0)
+		{
+			arSchedule[nTable].kStart = stats_clock();
+			progress_start(nTable, arSchedule[nTable].kRowCount);
+		}
+		UNLOCK(TaskLock);
+
+		gen_chunk(&pTask->Worker);
+
+		LOCK(TaskLock);
+		bLast = (++arSchedule[nTable].nFinished == arSchedule[nTable].nChunks);
+		UNLOCK(TaskLock);
+		if (bLast)
+			task_done(nTable);
+	}
+
+	return(NULL);
+}
+
+/*
+* Routine: gen_schedule(int bVerbose)
+* Purpose: build every table added by schedule_table(), on -THREADS threads
+* Algorithm: the tasks are sorted by estimated cost and handed out largest
+*	first, each to the next thread that comes free, so that the chunks of 
+*	the fact tables start early and the small dimensions fill in around 
+*	them. Every task starts from the RNG state and table definitions of the
+*	main thread and positions its own streams, so the output matches a 
+*	serial run byte for byte.
+* Data Structures:
+*
+* Params: bVerbose: report each table as it is completed
+* Returns:
+* Called By: main(), gen_tbl()
+* Calls: gen_task()
+* Assumptions:
+* Side Effects:
+* TODO: None
+*/
+static void
+gen_schedule(int bVerbose)
+{
+	int i,
+		nThreads = get_int("THREADS");
+	pthread_t *arThreads;
+	rng_t *pStreams;
+	tdef *pTdefs;
+
+	if (!nTasks)
+		return;
+
+	bScheduleVerbose = bVerbose;
+	pStreams = RNGSave();
+	pTdefs = saveTdefs();
+	qsort(arTasks, nTasks, sizeof(task_t), task_compare);
+	for (i=0; i < nTasks; i++)
+	{
+		arTasks[i].Worker.pStreams = pStreams;
+		arTasks[i].Worker.pTdefs = pTdefs;
+	}
+
+	if (nThreads > nTasks)
+		nThreads = nTasks;
+	arThreads = (pthread_t *)malloc(nThreads * sizeof(pthread_t));
+	MALLOC_CHECK(arThreads);
+	for (i=0; i < nThreads; i++)
+		if (pthread_create(&arThreads[i], NULL, gen_task, NULL))
+		{
+			INTERNAL("Failed to start scheduler thread");
+			exit(-1);
+		}
+	for (i=0; i < nThreads; i++)
+		pthread_join(arThreads[i], NULL);
+
+	free(arThreads);
+	free(arTasks);
+	arTasks = NULL;
+	nTasks = nNextTask = 0;
+	free(pStreams);
+	free(pTdefs);
+
+	return;
+}
+#endif /* USE_THREADS */
+
 /*
 * generate a particular table
 */
@@ -262,13 +595,14 @@ set_files (int i)
 * TODO: 20011217 JMS need to build date-correlated (i.e. fact) tables in proper order
 */
 void
-gen_tbl (int tabid, ds_key_t kFirstRow, ds_key_t kRowCount)
+gen_tbl (gen_ctx_t *pCtx, int tabid, ds_key_t kFirstRow, ds_key_t kRowCount)
 {
 	int direct,
 		bIsVerbose,
 		nLifeFreq,
 		nMultiplier,
-      nChild;
+      nChild,
+      nThreads;
 	ds_key_t i,
 		kTotalRows;
    tdef *pT = getSimpleTdefsByNumber(tabid);
@@ -310,24 +644,48 @@ gen_tbl (int tabid, ds_key_t kFirstRow, ds_key_t kRowCount)
     */
    if (pT->flags & FL_SMALL)
       resetCountCount();
-   
+
+#ifdef USE_THREADS
+   /*
+    * the date based fact tables can be split between threads; every
+    * thread needs enough rows to cover the cost of repositioning its streams
+    */
+   nThreads = (is_set("THREADS") && !is_set("UPDATE"))?get_int("THREADS"):1;
+   if (nThreads > kRowCount / MIN_MULTI_THREAD_ROWS)
+      nThreads = (int)(kRowCount / MIN_MULTI_THREAD_ROWS);
+   if ((pT->flags & FL_DATE_BASED) && (nThreads > 1) && !g_Runtime.nShards)
+   {
+      schedule_table(tabid, kFirstRow, kRowCount);
+      gen_schedule(0);
+      if (bIsVerbose)
+         fprintf(stderr, "Done    \n");
+      return;
+   }
+#endif
+
+   progress_start(tabid, kRowCount);
+   stats_start(tabid, 0, kRowCount);
    for (i=kFirstRow; kRowCount; i++,kRowCount--)
 	{
 		if (bIsVerbose && i && (i % nLifeFreq) == 0)
 			fprintf(stderr, "%3d%%\b\b\b\b",(int)(((kTotalRows - kRowCount)*100)/kTotalRows));
 		
 		/* not all rows that are built should be printed. Use return code to deterine output */
-		if (!pF->builder(NULL, i))
+		if (!pF->builder(pCtx, NULL, i))
 			if (pF->loader[direct](NULL))
 			{
 				fprintf(stderr, "ERROR: Load failed on %s!\n", getTableNameByID(tabid));
 				exit(-1);
 			}
 			row_stop(tabid);
+		if (g_Runtime.bProgress)
+			progress_row();
 	}
 	if (bIsVerbose)
 			fprintf(stderr, "Done    \n");	
 	print_close(tabid);
+	stats_end();
+	progress_end(tabid);
 
 	return;
 }
@@ -351,14 +709,7 @@ validate_options(void)
 {
 	char msg[1024];
 
-	msg[0] = '\0';
-	if (is_set("PARALLEL"))
-	{
-		if (get_int("PARALLEL") < 2) strcat(msg, "PARALLEL must be >= 2\n");
-		if (get_int("CHILD") < 1) strcat(msg, "CHILD must be >= 1\n");
-	}
-
-	if (strlen(msg)) usage(NULL, msg);
+	if (check_options(msg)) usage(NULL, msg);
 
 	return;
 }
@@ -398,10 +749,15 @@ main (int ac, char **av)
 	struct timeb t;
    tdef *pT;
    table_func_t *pF;
+   int bSchedule = 0;
+   gen_ctx_t *pCtx;
 	
 	process_options (ac, av);
 	validate_options();
+	init_runtime();
 	init_rand();
+	progress_init();
+	pCtx = ctx_new();
 
 	/* build command line argument string */
 	g_szCommandLine[0] = '\0';
@@ -470,6 +826,12 @@ main (int ac, char **av)
 		tabid = find_table("ABREVIATION", get_str("ABREVIATION"));
 	}
 
+#ifdef USE_THREADS
+	/* build the whole schema at once, rather than one table at a time */
+	bSchedule = (tabid == -1) && is_set("THREADS") && (get_int("THREADS") > 1) &&
+		!is_set("UPDATE") && !is_set("VALIDATE") && !g_Runtime.bStdout;
+#endif
+
 	for (i=(is_set("UPDATE"))?S_BRAND:CALL_CENTER; (pT = getSimpleTdefsByNumber(i)); i++)
 	{
 
@@ -551,7 +913,7 @@ main (int ac, char **av)
 			for (; kValidateCount; kValidateCount--)
 			{
 				genrand_key(&kRandomRow, DIST_UNIFORM, 1, kRowCount, 0, VALIDATE_STREAM); 
-				pF->validate(i, kRandomRow, NULL);
+				pF->validate(pCtx, i, kRandomRow, NULL);
             if (!(pT->flags & FL_VPRINT))
                printValidation(i, kRandomRow);
 			}
@@ -574,6 +936,13 @@ main (int ac, char **av)
 		     generation_table = STORE_SALES;
 		     
          split_work(generation_table, &kFirstRow, &kRowCount);
+#ifdef USE_THREADS
+         if (bSchedule)
+         {
+            schedule_table(generation_table, kFirstRow, kRowCount);
+            continue;
+         }
+#endif
          /*
          * if there are rows to skip then skip them 
          */
@@ -588,14 +957,20 @@ main (int ac, char **av)
          /*
          * now build the actual rows
          */
-         gen_tbl(generation_table, kFirstRow, kRowCount);
+         gen_tbl(pCtx, generation_table, kFirstRow, kRowCount);
 		}
 	}
+#ifdef USE_THREADS
+	if (bSchedule)
+		gen_schedule(is_set("VERBOSE") && !is_set("QUIET"));
+#endif
 
 #ifndef NOLOAD
 	if (is_set("DBLOAD"))
 		load_close();
 #endif
+	ctx_free(pCtx);
+	stats_report();
 	
 	return (0);
 }
@@ -57,6 +57,17 @@
 static long Mult = 16807;       /* the multiplier */
 static long nQ = 127773;        /* the quotient MAXINT / Mult */
 static long nR = 2836;          /* the remainder MAXINT % Mult */
+
+/*
+ * Mult^k % MAXINT for small k, so that a stream can be moved k draws ahead
+ * with one multiplication, and Mult^(2^k) % MAXINT, so that longer jumps
+ * need one multiplication per set bit of the distance; filled in by init_rand()
+ */
+#define RNG_ADVANCE_TABLE	2048
+#define RNG_JUMP_TABLE		63
+static long arMultPower[RNG_ADVANCE_TABLE];
+static long arMultJump[RNG_JUMP_TABLE];
+static ds_key_t jump_seed(ds_key_t Z, ds_key_t N);
 void NthElement (HUGE_TYPE N, int nStream);
 
 /*
@@ -118,15 +129,48 @@ next_random_float (int stream)
 }
 
 /*
- * Routine: skip_random(int stream, int skip_count)
- * Purpose: 
- * Algorithm:
+ * Routine: jump_seed(ds_key_t Z, ds_key_t N)
+ * Purpose: return the seed N draws after Z
+ * Algorithm: X_(n+N) = (Mult^N * X_n) % MAXINT; Mult^N is read from
+ *	arMultPower[] when N is small, and built from the Mult^(2^k) entries
+ *	of arMultJump[] otherwise
  * Data Structures:
  *
  * Params:
  * Returns:
- * Called By: 
+ * Called By: skip_random(), advance_random()
  * Calls: 
+ * Assumptions: init_rand() has been called
+ * Side Effects:
+ * TODO: None
+ */
+static ds_key_t
+jump_seed (ds_key_t Z, ds_key_t N)
+{
+   int k;
+
+   if (N < RNG_ADVANCE_TABLE)
+      return ((Z * arMultPower[N]) % MAXINT);
+
+   for (k = 0; N > 0; k++, N >>= 1)
+      if (N & 1)
+         Z = (Z * arMultJump[k]) % MAXINT;
+
+   return (Z);
+}
+
+/*
+ * Routine: skip_random(int stream, int skip_count)
+ * Purpose: position a stream N draws after its initial seed
+ * Algorithm: the last skip of each stream is remembered; a skip to a later
+ *	position starts from there rather than from the initial seed, which
+ *	keeps the jump short when rows are visited in increasing order
+ * Data Structures:
+ *
+ * Params:
+ * Returns:
+ * Called By: row_skip()
+ * Calls: jump_seed()
  * Assumptions:
  * Side Effects:
  * TODO: None
@@ -134,23 +178,54 @@ next_random_float (int stream)
 void
 skip_random (int nStream, ds_key_t N)
 {
+   rng_t *pStream = &Streams[nStream];
    ds_key_t Z;
-   ds_key_t M;
 
 #ifdef UNDEF
 	fprintf(stderr, "skipping stream %d to %d\n", nStream, N);
    Streams[nStream].nTotal = N;
 #endif
-   M = Mult;
-   Z = (ds_key_t) Streams[nStream].nInitialSeed;
-   while (N > 0)
-     {
-        if (N % 2 != 0)         /* testing for oddness, this seems portable */
-           Z = (M * Z) % MAXINT;
-        N = N / 2;              /* integer division, truncates */
-        M = (M * M) % MAXINT;
-     }
-   Streams[nStream].nSeed = (long) Z;
+   if (pStream->nSkipSeed && (pStream->nSkipBase == pStream->nInitialSeed)
+      && (N >= pStream->kSkipCount))
+      Z = jump_seed ((ds_key_t) pStream->nSkipSeed, N - pStream->kSkipCount);
+   else
+      Z = jump_seed ((ds_key_t) pStream->nInitialSeed, N);
+
+   pStream->nSeed = (long) Z;
+   pStream->nSkipBase = pStream->nInitialSeed;
+   pStream->kSkipCount = N;
+   pStream->nSkipSeed = (long) Z;
+
+   return;
+}
+
+/*
+ * Routine: advance_random(int nStream, ds_key_t nCount)
+ * Purpose: move a stream nCount draws ahead of its current position
+ * Algorithm: see jump_seed(); this leaves the stream exactly where nCount
+ *	calls to next_random() would have
+ * Data Structures:
+ *
+ * Params:
+ * Returns:
+ * Called By: checkSeeds()
+ * Calls: jump_seed()
+ * Assumptions: init_rand() has been called
+ * Side Effects: the draws are counted in nUsed, as next_random() would
+ * TODO: None
+ */
+void
+advance_random (int nStream, ds_key_t nCount)
+{
+   if (nCount <= 0)
+      return;
+
+   Streams[nStream].nSeed =
+      (long) jump_seed ((ds_key_t) Streams[nStream].nSeed, nCount);
+   Streams[nStream].nUsed += (int) nCount;
+#ifdef JMS
+   Streams[nStream].nTotal += nCount;
+#endif
 
    return;
 }
@@ -337,6 +412,52 @@ RNGReset (int tbl)
    return (0);
 }
 
+/* Routine: RNGSave(void)
+ * Purpose: take a copy of the current state of every stream
+ * Algorithm:
+ * Data Structures:
+ *
+ * Params:
+ * Returns: a newly allocated copy of Streams[]
+ * Called By: gen_tbl()
+ * Calls: 
+ * Assumptions:
+ * Side Effects:
+ * TODO: None
+ */
+rng_t *
+RNGSave (void)
+{
+   rng_t *pSaved;
+
+   pSaved = (rng_t *)malloc(sizeof(Streams));
+   MALLOC_CHECK(pSaved);
+   memcpy(pSaved, Streams, sizeof(Streams));
+
+   return (pSaved);
+}
+
+/* Routine: RNGRestore(rng_t *pSaved)
+ * Purpose: load the stream state captured by RNGSave()
+ * Algorithm:
+ * Data Structures:
+ *
+ * Params:
+ * Returns:
+ * Called By: worker threads started by gen_tbl()
+ * Calls: 
+ * Assumptions: Streams[] is thread local, so this only affects the caller
+ * Side Effects:
+ * TODO: None
+ */
+void
+RNGRestore (rng_t *pSaved)
+{
+   memcpy(Streams, pSaved, sizeof(Streams));
+
+   return;
+}
+
 
 /* WARNING!  This routine assumes the existence of 64-bit                 */
 
@@ -595,6 +716,12 @@ init_rand (void)
              Streams[i].nSeed = nSeed + skip * i;
              Streams[i].nUsed = 0;
           }
+        arMultPower[0] = 1;
+        for (i = 1; i < RNG_ADVANCE_TABLE; i++)
+           arMultPower[i] = (long) (((ds_key_t) arMultPower[i - 1] * Mult) % MAXINT);
+        arMultJump[0] = Mult;
+        for (i = 1; i < RNG_JUMP_TABLE; i++)
+           arMultJump[i] = (long) (((ds_key_t) arMultJump[i - 1] * arMultJump[i - 1]) % MAXINT);
         bInit = 1;
      }
    return;
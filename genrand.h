@@ -50,11 +50,14 @@ long nInitialSeed; /* used to allow skip_row() to back up */
 int nColumn; /* column where this stream is used */
 int nTable;	/* table where this stream is used */
 int nDuplicateOf;	/* duplicate streams allow independent tables to share data streams */
+long nSkipBase;	/* nInitialSeed when the last skip_random() was made */
+ds_key_t kSkipCount;	/* ... the position it skipped to */
+long nSkipSeed;	/* ... and the seed found there; 0 if there was no skip */
 #ifdef JMS
 ds_key_t nTotal;
 #endif
 } rng_t;
-extern rng_t Streams[];
+extern THREAD rng_t Streams[];
 
 #define FL_SEED_OVERRUN	0x0001
 
@@ -71,7 +74,10 @@ int		gen_charset(char *dest, char *set, int min, int max, int stream);
 int	dump_seeds(int tbl);
 void	init_rand(void);
 void	skip_random(int s, ds_key_t count);
+void	advance_random(int nStream, ds_key_t nCount);
 int	RNGReset(int nTable);
+rng_t	*RNGSave(void);
+void	RNGRestore(rng_t *pSaved);
 long	next_random(int nStream);
 void	genrand_email(char *pEmail, char *pFirst, char *pLast, int nColumn);
 void	genrand_ipaddr(char *pDest, int nColumn);
@@ -53,6 +53,7 @@
 #include "scd.h"
 #include "r_params.h"
 #include "sparse.h"
+#include "runtime.h"
 
 static ds_key_t web_join(int col, ds_key_t join_key);
 
@@ -77,7 +78,7 @@ date_join(int from_tbl, int from_col, ds_key_t join_count, int nYear)
 		nMin = -1, 
 		nMax = -1,
 		nResult;
-	static int bInit = 0,
+	static THREAD int bInit = 0,
 		jToday;
 	date_t TempDate;
 
@@ -193,13 +194,13 @@ static ds_key_t
 cp_join(int tbl, int col, ds_key_t jDate)
 {
 	ds_key_t res;
-	static int init = 0,
+	static THREAD int init = 0,
 		nPagePerCatalog;
 	int nType,
 		nCount,
 		nOffset,
 		nPage;
-	static date_t *dTemp;
+	static THREAD date_t *dTemp;
 	char *szTemp;
 
 	if (!init)
@@ -250,8 +251,8 @@ cp_join(int tbl, int col, ds_key_t jDate)
 ds_key_t
 getCatalogNumberFromPage(ds_key_t kPageNumber)
 {
-	static int bInit = 0;
-	static int nPagePerCatalog;
+	static THREAD int bInit = 0;
+	static THREAD int nPagePerCatalog;
 
 	if (!bInit)
 	{
@@ -286,11 +287,11 @@ web_join(int col, ds_key_t join_key)
 {
 	ds_key_t res = -1,
 		kSite;
-	static int init = 0,
+	static THREAD int init = 0,
 		nConcurrentSites,
 		nSiteDuration,
 		nOffset;
-	static date_t *dSiteOpen,	/* open/close dates for current web site */
+	static THREAD date_t *dSiteOpen,	/* open/close dates for current web site */
 		*dSiteClose;
 	int nTemp;
    tdef *pWS = getSimpleTdefsByNumber(WEB_SITE);
@@ -428,7 +429,8 @@ mk_join(int from_col, int to_tbl, ds_key_t join_count)
 	pTdef = getSimpleTdefsByNumber(to_tbl);
 	if (pTdef->flags & FL_SPARSE)
 	{
-		if (pTdef->arSparseKeys == NULL)
+		/* with -STATELESS the keys are computed by getSparseKey() instead */
+		if ((pTdef->arSparseKeys == NULL) && !g_Runtime.bStateless)
 			initSparseKeys(to_tbl);
 	}
 
@@ -0,0 +1,633 @@
+/* 
+ * Legal Notice 
+ * 
+ * This document and associated source code (the "Work") is a part of a 
+ * benchmark specification maintained by the TPC. 
+ * 
+ * The TPC reserves all right, title, and interest to the Work as provided 
+ * under U.S. and international laws, including without limitation all patent 
+ * and trademark rights therein. 
+ * 
+ * No Warranty 
+ * 
+ * 1.1 TO THE MAXIMUM EXTENT PERMITTED BY APPLICABLE LAW, THE INFORMATION 
+ *     CONTAINED HEREIN IS PROVIDED "AS IS" AND WITH ALL FAULTS, AND THE 
+ *     AUTHORS AND DEVELOPERS OF THE WORK HEREBY DISCLAIM ALL OTHER 
+ *     WARRANTIES AND CONDITIONS, EITHER EXPRESS, IMPLIED OR STATUTORY, 
+ *     INCLUDING, BUT NOT LIMITED TO, ANY (IF ANY) IMPLIED WARRANTIES, 
+ *     DUTIES OR CONDITIONS OF MERCHANTABILITY, OF FITNESS FOR A PARTICULAR 
+ *     PURPOSE, OF ACCURACY OR COMPLETENESS OF RESPONSES, OF RESULTS, OF 
+ *     WORKMANLIKE EFFORT, OF LACK OF VIRUSES, AND OF LACK OF NEGLIGENCE. 
+ *     ALSO, THERE IS NO WARRANTY OR CONDITION OF TITLE, QUIET ENJOYMENT, 
+ *     QUIET POSSESSION, CORRESPONDENCE TO DESCRIPTION OR NON-INFRINGEMENT 
+ *     WITH REGARD TO THE WORK. 
+ * 1.2 IN NO EVENT WILL ANY AUTHOR OR DEVELOPER OF THE WORK BE LIABLE TO 
+ *     ANY OTHER PARTY FOR ANY DAMAGES, INCLUDING BUT NOT LIMITED TO THE 
+ *     COST OF PROCURING SUBSTITUTE GOODS OR SERVICES, LOST PROFITS, LOSS 
+ *     OF USE, LOSS OF DATA, OR ANY INCIDENTAL, CONSEQUENTIAL, DIRECT, 
+ *     INDIRECT, OR SPECIAL DAMAGES WHETHER UNDER CONTRACT, TORT, WARRANTY,
+ *     OR OTHERWISE, ARISING IN ANY WAY OUT OF THIS OR ANY OTHER AGREEMENT 
+ *     RELATING TO THE WORK, WHETHER OR NOT SUCH AUTHOR OR DEVELOPER HAD 
+ *     ADVANCE NOTICE OF THE POSSIBILITY OF SUCH DAMAGES. 
+ * 
+ * Contributors:
+ * Gradient Systems
+ */ 
+#define DECLARER
+#include "config.h"
+#include "porting.h"
+#include <stdio.h>
+#ifdef USE_STRING_H
+#include <string.h>
+#else
+#include <strings.h>
+#endif
+#ifdef USE_STDLIB_H
+#include <stdlib.h>
+#else
+#include <malloc.h>
+#endif
+#include "genrand.h"
+#include "tdefs.h"
+#include "build_support.h"
+#include "params.h"
+#include "parallel.h"
+#include "scaling.h"
+#include "validate.h"
+#include "context.h"
+#include "runtime.h"
+#include "grammar_support.h"
+#include "w_call_center.h"
+#include "w_catalog_page.h"
+#include "w_catalog_sales.h"
+#include "w_customer.h"
+#include "w_customer_address.h"
+#include "w_customer_demographics.h"
+#include "w_datetbl.h"
+#include "w_household_demographics.h"
+#include "w_income_band.h"
+#include "w_inventory.h"
+#include "w_item.h"
+#include "w_promotion.h"
+#include "w_reason.h"
+#include "w_ship_mode.h"
+#include "w_store.h"
+#include "w_store_sales.h"
+#include "w_timetbl.h"
+#include "w_warehouse.h"
+#include "w_web_page.h"
+#include "w_web_sales.h"
+#include "w_web_site.h"
+#include "libdsdgen.h"
+
+/* defined by the driver in a dsdgen build */
+char g_szCommandLine[201];
+file_ref_t CurrentFile;
+file_ref_t *pCurrentFile;
+
+/*
+ * the tables that can be built a row at a time. A row of a sales table is 
+ * an order, and all of its lineitems are built together; the returns tables 
+ * only exist as a side effect of their sales, and are left out.
+ */
+typedef struct LIB_TABLE_T {
+	int nTable;
+	int nSize;
+	int nMaxRows;	/* rows built by each call */
+	int (*pOrder)(gen_ctx_t *pGen, void *pDest, ds_key_t kIndex, ds_key_t *arNulls);	/* the lineitems of an order */
+} lib_table_t;
+
+static lib_table_t arLibTables[] = {
+{CALL_CENTER, sizeof(struct CALL_CENTER_TBL), 1, NULL},
+{CATALOG_PAGE, sizeof(struct CATALOG_PAGE_TBL), 1, NULL},
+{CATALOG_SALES, sizeof(struct W_CATALOG_SALES_TBL), CS_MAX_LINEITEMS, mk_w_catalog_sales_lineitems},
+{CUSTOMER, sizeof(struct W_CUSTOMER_TBL), 1, NULL},
+{CUSTOMER_ADDRESS, sizeof(struct W_CUSTOMER_ADDRESS_TBL), 1, NULL},
+{CUSTOMER_DEMOGRAPHICS, sizeof(struct W_CUSTOMER_DEMOGRAPHICS_TBL), 1, NULL},
+{DATE, sizeof(struct W_DATE_TBL), 1, NULL},
+{HOUSEHOLD_DEMOGRAPHICS, sizeof(struct W_HOUSEHOLD_DEMOGRAPHICS_TBL), 1, NULL},
+{INCOME_BAND, sizeof(struct W_INCOME_BAND_TBL), 1, NULL},
+{INVENTORY, sizeof(struct W_INVENTORY_TBL), 1, NULL},
+{ITEM, sizeof(struct W_ITEM_TBL), 1, NULL},
+{PROMOTION, sizeof(struct W_PROMOTION_TBL), 1, NULL},
+{REASON, sizeof(struct W_REASON_TBL), 1, NULL},
+{SHIP_MODE, sizeof(struct W_SHIP_MODE_TBL), 1, NULL},
+{STORE, sizeof(struct W_STORE_TBL), 1, NULL},
+{STORE_SALES, sizeof(struct W_STORE_SALES_TBL), SS_MAX_LINEITEMS, mk_w_store_sales_lineitems},
+{TIME, sizeof(struct W_TIME_TBL), 1, NULL},
+{WAREHOUSE, sizeof(struct W_WAREHOUSE_TBL), 1, NULL},
+{WEB_PAGE, sizeof(struct W_WEB_PAGE_TBL), 1, NULL},
+{WEB_SALES, sizeof(struct W_WEB_SALES_TBL), WS_MAX_LINEITEMS, mk_w_web_sales_lineitems},
+{WEB_SITE, sizeof(struct W_WEB_SITE_TBL), 1, NULL},
+{-1}
+};
+
+/*
+ * the options, RNG state and table definitions are set up once per process,
+ * by the first dsdgen_open(); each thread loads a copy of the state before it
+ * builds its first row
+ */
+struct DSDGEN_CTX_T {
+	int nSerial;
+	rng_t *pStreams;
+	tdef *pTdefs;
+	ds_key_t arRowcount[MAX_TABLE + 1];
+};
+
+static char *szOptions = NULL;
+static rng_t *pBaseStreams;
+static tdef *pBaseTdefs;
+static int nContexts = 0;
+static THREAD int nLoaded = 0;	/* serial number of the context this thread has loaded */
+static THREAD gen_ctx_t *pGen = NULL;	/* this thread's builder state */
+DECLARE_LOCK(ContextLock);
+
+static int lib_build(gen_ctx_t *pGen, lib_table_t *pL, ds_key_t kRow, void *pDest, ds_key_t *arNulls);
+
+/*
+* Routine: lib_table(int nTable)
+* Purpose: find the description of a table that libdsdgen can build
+* Algorithm:
+* Data Structures:
+*
+* Params:
+* Returns: NULL for a table that cannot be built a row at a time
+* Called By: 
+* Calls: 
+* Assumptions:
+* Side Effects:
+* TODO: None
+*/
+static lib_table_t *
+lib_table(int nTable)
+{
+	lib_table_t *pL;
+
+	for (pL=arLibTables; pL->nTable != -1; pL++)
+		if (pL->nTable == nTable)
+			return(pL);
+
+	return(NULL);
+}
+
+/*
+* Routine: lib_load(dsdgen_ctx_t *pCtx)
+* Purpose: give the calling thread its own copy of a context's generator state
+* Algorithm: row_skip() positions the streams from their initial seeds, so the
+*	state only needs to be loaded once per thread; the builders start over
+*	with a fresh gen_ctx_t
+* Data Structures:
+*
+* Params:
+* Returns:
+* Called By: dsdgen_rows()
+* Calls: RNGRestore(), restoreTdefs(), ctx_new()
+* Assumptions:
+* Side Effects:
+* TODO: None
+*/
+static void
+lib_load(dsdgen_ctx_t *pCtx)
+{
+	if (nLoaded != pCtx->nSerial)
+	{
+		RNGRestore(pCtx->pStreams);
+		restoreTdefs(pCtx->pTdefs);
+		if (pGen != NULL)
+			ctx_free(pGen);
+		pGen = ctx_new();
+		nLoaded = pCtx->nSerial;
+	}
+
+	return;
+}
+
+/*
+* Routine: lib_check_args(int nArgs, char **arArgs)
+* Purpose: find the options that process_options() would end the process on
+* Algorithm: unknown or ambiguous options, missing or malformed arguments, and
+*	the options that only make sense on the command line are reported
+* Data Structures:
+*
+* Params:
+* Returns: 0 if process_options() can be given the options
+* Called By: dsdgen_open()
+* Calls: fnd_param()
+* Assumptions:
+* Side Effects:
+* TODO: None
+*/
+#ifdef WIN32
+#define LIB_OPTION_START '/'
+#else
+#define LIB_OPTION_START '-'
+#endif
+
+static int
+lib_check_args(int nArgs, char **arArgs)
+{
+	option_t *o;
+	char *szValue;
+	int i,
+		nParam;
+
+	for (i=1; i < nArgs; i++)
+	{
+		if (*arArgs[i] != LIB_OPTION_START)
+			continue;	/* the Y or N of a flag */
+		if ((nParam = fnd_param(arArgs[i] + 1)) < 0)
+		{
+			fprintf(stderr, "ERROR: option '%s' is unknown\n", arArgs[i] + 1);
+			return(-1);
+		}
+		o = &options[nParam];
+		if (!strcmp(o->name, "HELP") || !strcmp(o->name, "PARAMS") || !strcmp(o->name, "RELEASE"))
+		{
+			fprintf(stderr, "ERROR: option '%s' is not supported by libdsdgen\n", o->name);
+			return(-1);
+		}
+		if ((o->flags & TYPE_MASK) == OPT_FLG)
+			continue;
+		if (++i == nArgs)
+		{
+			fprintf(stderr, "ERROR: option '%s' needs an argument\n", o->name);
+			return(-1);
+		}
+		szValue = arArgs[i];
+		if ((o->flags & TYPE_MASK) == OPT_INT)
+		{
+			if ((*szValue == '-') && (o->action == NULL))
+				szValue += 1;
+			if (!*szValue || (strspn(szValue, "0123456789") != strlen(szValue)))
+			{
+				fprintf(stderr, "ERROR: option '%s' needs an integer\n", o->name);
+				return(-1);
+			}
+		}
+		else if ((*szValue == '"') && (strchr(szValue + 1, '"') == NULL))
+		{
+			fprintf(stderr, "ERROR: option '%s' has a non-terminated string\n", o->name);
+			return(-1);
+		}
+	}
+
+	return(0);
+}
+
+/*
+* Routine: lib_reset_options()
+* Purpose: return every option to its default after a failed dsdgen_open()
+* Algorithm:
+* Data Structures:
+*
+* Params:
+* Returns:
+* Called By: dsdgen_open()
+* Calls: 
+* Assumptions: init_params() has been called
+* Side Effects:
+* TODO: None
+*/
+static void
+lib_reset_options(void)
+{
+	int i;
+
+	for (i=0; options[i].name != NULL; i++)
+	{
+		strncpy(params[options[i].index], options[i].dflt, 80);
+		options[i].flags &= ~OPT_SET;
+	}
+
+	return;
+}
+
+/*
+* Routine: dsdgen_open(int nArgs, char **arArgs)
+* Purpose: create a context for building rows
+* Algorithm: the first call processes the options and builds one row of each
+*	table, so that the one time set up inside the builders (distributions,
+*	permutations, constants) is complete before any other thread can use it
+* Data Structures:
+*
+* Params: arArgs are dsdgen command line options; arArgs[0] is ignored
+* Returns: NULL if the options are invalid, or differ from those of an 
+*	earlier context
+* Called By: 
+* Calls: lib_check_args(), process_options(), check_options(), 
+*	lib_reset_options(), init_runtime(), init_rand()
+* Assumptions: options are process wide, so every context uses the same ones
+* Side Effects:
+* TODO: None
+*/
+dsdgen_ctx_t *
+dsdgen_open(int nArgs, char **arArgs)
+{
+	dsdgen_ctx_t *pCtx;
+	lib_table_t *pL;
+	char *szArgs,
+		*pScratch,
+		szMsg[1024];
+	int i,
+		nLength = 1,
+		nScratch = 0;
+
+	for (i=1; i < nArgs; i++)
+		nLength += strlen(arArgs[i]) + 1;
+	szArgs = (char *)malloc(nLength);
+	MALLOC_CHECK(szArgs);
+	szArgs[0] = '\0';
+	for (i=1; i < nArgs; i++)
+	{
+		strcat(szArgs, arArgs[i]);
+		strcat(szArgs, " ");
+	}
+
+	pCtx = (dsdgen_ctx_t *)malloc(sizeof(struct DSDGEN_CTX_T));
+	MALLOC_CHECK(pCtx);
+	memset(pCtx, 0, sizeof(struct DSDGEN_CTX_T));
+
+	LOCK(ContextLock);
+	if (szOptions == NULL)
+	{
+		if (lib_check_args(nArgs, arArgs))
+		{
+			UNLOCK(ContextLock);
+			free(szArgs);
+			free(pCtx);
+			return(NULL);
+		}
+		process_options(nArgs, arArgs);
+		if (check_options(szMsg))
+		{
+			lib_reset_options();
+			UNLOCK(ContextLock);
+			fprintf(stderr, "ERROR: %s", szMsg);
+			free(szArgs);
+			free(pCtx);
+			return(NULL);
+		}
+		init_runtime();
+		init_rand();
+		pBaseStreams = RNGSave();
+		pBaseTdefs = saveTdefs();
+		szOptions = szArgs;
+	}
+	else
+	{
+		if (strcmp(szOptions, szArgs))
+		{
+			UNLOCK(ContextLock);
+			fprintf(stderr, "ERROR: every dsdgen context must use the same options\n");
+			free(szArgs);
+			free(pCtx);
+			return(NULL);
+		}
+		free(szArgs);
+	}
+	pCtx->nSerial = ++nContexts;
+	pCtx->pStreams = pBaseStreams;
+	pCtx->pTdefs = pBaseTdefs;
+	for (pL=arLibTables; pL->nTable != -1; pL++)
+		pCtx->arRowcount[pL->nTable] = get_rowcount(pL->nTable);
+
+	if (pCtx->nSerial == 1)
+	{
+		for (pL=arLibTables; pL->nTable != -1; pL++)
+			if (nScratch < pL->nSize * pL->nMaxRows)
+				nScratch = pL->nSize * pL->nMaxRows;
+		pScratch = (char *)malloc(nScratch);
+		MALLOC_CHECK(pScratch);
+		lib_load(pCtx);
+		for (pL=arLibTables; pL->nTable != -1; pL++)
+			lib_build(pGen, pL, 1, pScratch, NULL);
+		free(pScratch);
+	}
+	UNLOCK(ContextLock);
+
+	return(pCtx);
+}
+
+/*
+* Routine: dsdgen_close(dsdgen_ctx_t *pCtx)
+* Purpose: release a context
+* Algorithm:
+* Data Structures:
+*
+* Params:
+* Returns:
+* Called By: 
+* Calls: 
+* Assumptions: no thread is still building rows from the context
+* Side Effects:
+* TODO: None
+*/
+void
+dsdgen_close(dsdgen_ctx_t *pCtx)
+{
+	free(pCtx);
+
+	return;
+}
+
+/*
+* Routine: dsdgen_rowcount(dsdgen_ctx_t *pCtx, int nTable)
+* Purpose: the number of rows of a table that dsdgen_row() accepts
+* Algorithm:
+* Data Structures:
+*
+* Params:
+* Returns: the number of orders for a sales table; -1 for an unsupported table
+* Called By: 
+* Calls: 
+* Assumptions:
+* Side Effects:
+* TODO: None
+*/
+ds_key_t
+dsdgen_rowcount(dsdgen_ctx_t *pCtx, int nTable)
+{
+	if (lib_table(nTable) == NULL)
+		return(-1);
+
+	return(pCtx->arRowcount[nTable]);
+}
+
+/*
+* Routine: dsdgen_row_size(int nTable)
+* Purpose: the size of the structure that holds a row of a table
+* Algorithm:
+* Data Structures:
+*
+* Params:
+* Returns: -1 for an unsupported table
+* Called By: 
+* Calls: 
+* Assumptions:
+* Side Effects:
+* TODO: None
+*/
+int
+dsdgen_row_size(int nTable)
+{
+	lib_table_t *pL = lib_table(nTable);
+
+	return((pL == NULL)?-1:pL->nSize);
+}
+
+/*
+* Routine: dsdgen_row_max(int nTable)
+* Purpose: the most rows that a single row number can produce
+* Algorithm:
+* Data Structures:
+*
+* Params:
+* Returns: the largest number of lineitems in an order for a sales table, 1 for 
+*	any other table, and -1 for an unsupported table
+* Called By: 
+* Calls: 
+* Assumptions:
+* Side Effects:
+* TODO: None
+*/
+int
+dsdgen_row_max(int nTable)
+{
+	lib_table_t *pL = lib_table(nTable);
+
+	return((pL == NULL)?-1:pL->nMaxRows);
+}
+
+/*
+* Routine: lib_build(gen_ctx_t *pGen, lib_table_t *pL, ds_key_t kRow, void *pDest, 
+*	ds_key_t *arNulls)
+* Purpose: build a single row, or all of the lineitems of an order
+* Algorithm:
+* Data Structures:
+*
+* Params: arNulls, if not NULL, receives the NULL bitmap of each row
+* Returns: the number of rows built
+* Called By: dsdgen_open(), dsdgen_rows()
+* Calls: rebuildRow(), set_chunk()
+* Assumptions:
+* Side Effects:
+* TODO: None
+*/
+static int
+lib_build(gen_ctx_t *pGen, lib_table_t *pL, ds_key_t kRow, void *pDest, ds_key_t *arNulls)
+{
+	int nRows = 1;
+
+	memset(pDest, 0, pL->nSize * pL->nMaxRows);
+	if (pL->pOrder)
+	{
+		set_chunk(kRow, 1);
+		nRows = pL->pOrder(pGen, pDest, kRow, arNulls);
+		set_chunk(0, 0);
+	}
+	else
+	{
+		rebuildRow(pGen, pL->nTable, kRow, pDest);
+		if (arNulls != NULL)
+			arNulls[0] = getSimpleTdefsByNumber(pL->nTable)->kNullBitMap;
+	}
+
+	return(nRows);
+}
+
+/*
+* Routine: dsdgen_row(dsdgen_ctx_t *pCtx, int nTable, ds_key_t kRow, void *pDest, 
+*	ds_key_t *arNulls)
+* Purpose: build row kRow of a table into pDest
+* Algorithm:
+* Data Structures:
+*
+* Params: pDest has room for dsdgen_row_max(nTable) rows; arNulls, if not NULL,
+*	has room for as many NULL bitmaps (see dsdgen_is_null())
+* Returns: the number of rows built, or -1 for an unsupported table or a row 
+*	out of range
+* Called By: 
+* Calls: dsdgen_rows()
+* Assumptions:
+* Side Effects:
+* TODO: None
+*/
+int
+dsdgen_row(dsdgen_ctx_t *pCtx, int nTable, ds_key_t kRow, void *pDest, ds_key_t *arNulls)
+{
+	return(dsdgen_rows(pCtx, nTable, &kRow, 1, pDest, arNulls, NULL));
+}
+
+/*
+* Routine: dsdgen_rows(dsdgen_ctx_t *pCtx, int nTable, ds_key_t *arRows, 
+*	int nRows, void *pDest, ds_key_t *arNulls, int *arCount)
+* Purpose: build a list of rows of a table
+* Algorithm: the rows of arRows[i] start at slot i * dsdgen_row_max(nTable) of
+*	pDest, and their NULL bitmaps at the same slot of arNulls; rows in 
+*	ascending order share more of the work inside the builders
+* Data Structures:
+*
+* Params: arNulls and arCount may be NULL; arCount receives the number of rows 
+*	built for each entry
+* Returns: the total number of rows built, or -1 for an unsupported table or a 
+*	row out of range
+* Called By: dsdgen_row()
+* Calls: lib_load(), lib_build()
+* Assumptions:
+* Side Effects:
+* TODO: None
+*/
+int
+dsdgen_rows(dsdgen_ctx_t *pCtx, int nTable, ds_key_t *arRows, int nRows, void *pDest, 
+	ds_key_t *arNulls, int *arCount)
+{
+	lib_table_t *pL = lib_table(nTable);
+	char *pRow = (char *)pDest;
+	int i,
+		nBuilt,
+		nTotal = 0;
+
+	if (pL == NULL)
+		return(-1);
+	for (i=0; i < nRows; i++)
+		if ((arRows[i] < 1) || (arRows[i] > pCtx->arRowcount[nTable]))
+			return(-1);
+
+	lib_load(pCtx);
+	for (i=0; i < nRows; i++)
+	{
+		nBuilt = lib_build(pGen, pL, arRows[i], pRow, 
+			(arNulls == NULL)?NULL:arNulls + i * pL->nMaxRows);
+		if (arCount != NULL)
+			arCount[i] = nBuilt;
+		nTotal += nBuilt;
+		pRow += pL->nSize * pL->nMaxRows;
+	}
+
+	return(nTotal);
+}
+
+/*
+* Routine: dsdgen_is_null(ds_key_t kNullBitMap, int nColumn)
+* Purpose: test a column of a row against the NULL bitmap returned with it
+* Algorithm: as nullCheck()
+* Data Structures:
+*
+* Params: nColumn is a column number from columns.h
+* Returns: non-zero if the column is NULL in the row
+* Called By: 
+* Calls: 
+* Assumptions:
+* Side Effects:
+* TODO: None
+*/
+int
+dsdgen_is_null(ds_key_t kNullBitMap, int nColumn)
+{
+	tdef *pTdef = getSimpleTdefsByNumber(getTableFromColumn(nColumn));
+	ds_key_t kBitMask = 1;
+
+	kBitMask <<= nColumn - pTdef->nFirstColumn;
+
+	return((kNullBitMap & kBitMask) != 0);
+}
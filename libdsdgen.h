@@ -0,0 +1,73 @@
+/* 
+ * Legal Notice 
+ * 
+ * This document and associated source code (the "Work") is a part of a 
+ * benchmark specification maintained by the TPC. 
+ * 
+ * The TPC reserves all right, title, and interest to the Work as provided 
+ * under U.S. and international laws, including without limitation all patent 
+ * and trademark rights therein. 
+ * 
+ * No Warranty 
+ * 
+ * 1.1 TO THE MAXIMUM EXTENT PERMITTED BY APPLICABLE LAW, THE INFORMATION 
+ *     CONTAINED HEREIN IS PROVIDED "AS IS" AND WITH ALL FAULTS, AND THE 
+ *     AUTHORS AND DEVELOPERS OF THE WORK HEREBY DISCLAIM ALL OTHER 
+ *     WARRANTIES AND CONDITIONS, EITHER EXPRESS, IMPLIED OR STATUTORY, 
+ *     INCLUDING, BUT NOT LIMITED TO, ANY (IF ANY) IMPLIED WARRANTIES, 
+ *     DUTIES OR CONDITIONS OF MERCHANTABILITY, OF FITNESS FOR A PARTICULAR 
+ *     PURPOSE, OF ACCURACY OR COMPLETENESS OF RESPONSES, OF RESULTS, OF 
+ *     WORKMANLIKE EFFORT, OF LACK OF VIRUSES, AND OF LACK OF NEGLIGENCE. 
+ *     ALSO, THERE IS NO WARRANTY OR CONDITION OF TITLE, QUIET ENJOYMENT, 
+ *     QUIET POSSESSION, CORRESPONDENCE TO DESCRIPTION OR NON-INFRINGEMENT 
+ *     WITH REGARD TO THE WORK. 
+ * 1.2 IN NO EVENT WILL ANY AUTHOR OR DEVELOPER OF THE WORK BE LIABLE TO 
+ *     ANY OTHER PARTY FOR ANY DAMAGES, INCLUDING BUT NOT LIMITED TO THE 
+ *     COST OF PROCURING SUBSTITUTE GOODS OR SERVICES, LOST PROFITS, LOSS 
+ *     OF USE, LOSS OF DATA, OR ANY INCIDENTAL, CONSEQUENTIAL, DIRECT, 
+ *     INDIRECT, OR SPECIAL DAMAGES WHETHER UNDER CONTRACT, TORT, WARRANTY,
+ *     OR OTHERWISE, ARISING IN ANY WAY OUT OF THIS OR ANY OTHER AGREEMENT 
+ *     RELATING TO THE WORK, WHETHER OR NOT SUCH AUTHOR OR DEVELOPER HAD 
+ *     ADVANCE NOTICE OF THE POSSIBILITY OF SUCH DAMAGES. 
+ * 
+ * Contributors:
+ * Gradient Systems
+ */ 
+#ifndef LIBDSDGEN_H
+#define LIBDSDGEN_H
+
+#include "config.h"
+#include "porting.h"
+#include "tables.h"
+
+/*
+ * libdsdgen: build any row of a table on demand, without a dsdgen process.
+ * Rows are returned in the structures of the w_*.h headers, as the builders 
+ * fill them; see libdsdgen.c for the tables that are supported.
+ *
+ * NULL columns are not marked in the structures; each row comes with a bitmap 
+ * to test with dsdgen_is_null().
+ *
+ * A context holds the generator state of one set of options. Any number of 
+ * threads can build rows from the same context at once.
+ *
+ * The options, RNG seeds and table definitions are process wide, so in 
+ * practice there is one context per process: every later dsdgen_open() must 
+ * pass the same options as the first, and cannot change the scale or seed. 
+ * Invalid options make dsdgen_open() return NULL, with a message on stderr,
+ * instead of ending the process. A distributions file that cannot be read 
+ * still ends it.
+ */
+typedef struct DSDGEN_CTX_T dsdgen_ctx_t;
+
+dsdgen_ctx_t *dsdgen_open(int nArgs, char **arArgs);
+void dsdgen_close(dsdgen_ctx_t *pCtx);
+ds_key_t dsdgen_rowcount(dsdgen_ctx_t *pCtx, int nTable);
+int dsdgen_row_size(int nTable);
+int dsdgen_row_max(int nTable);
+int dsdgen_row(dsdgen_ctx_t *pCtx, int nTable, ds_key_t kRow, void *pDest, ds_key_t *arNulls);
+int dsdgen_rows(dsdgen_ctx_t *pCtx, int nTable, ds_key_t *arRows, int nRows, void *pDest, 
+	ds_key_t *arNulls, int *arCount);
+int dsdgen_is_null(ds_key_t kNullBitMap, int nColumn);
+
+#endif /* LIBDSDGEN_H */
@@ -36,7 +36,33 @@
 #ifndef LOAD_H
 #define LOAD_H
 #include "tables.h"
+#include "decimal.h"
+#include "arrow.h"
+
+/*
+ * -DBLOAD: the ld_* routines hand their rows to the print routines, which 
+ * write them in the PostgreSQL binary COPY format; see load.c
+ */
+typedef struct LOAD_TABLE_T {
+	int nTable;
+	int nColumns;	/* columns described by the DDL */
+	int *arSqlType;
+	int *arPrecision;
+	int *arScale;
+	int nColumn;	/* next field of the current row */
+	int bChecked;	/* the first row has been held up against the DDL */
+	arrow_buf_t Row;
+} load_table_t;
+
 void load_init(void);
 void load_close(void);
 int create_table(int nTable);
+load_table_t *load_open(int nTable);
+void load_free(load_table_t *pLoad);
+int load_header(char **ppData);
+int load_trailer(char **ppData);
+void load_integer(load_table_t *pLoad, int nType, ds_key_t kValue, int bNull);
+void load_decimal(load_table_t *pLoad, decimal_t *pValue, int bNull);
+void load_string(load_table_t *pLoad, char *szValue, int nLength, int bNull);
+int load_end_row(load_table_t *pLoad, char **ppData);
 #endif
@@ -35,12 +35,13 @@
  */ 
 #ifndef MISC_H
 #define MISC_H
+#include "context.h"
 int prep_direct(int dialect);
 int close_direct(int dialect);
 int pick_tbl(char *dname);
 int itostr(char *dest, int i);
 int char_op(char *dest, int op, char *s1, char *s2);
-char *gen_text(char *dest, int min, int max, int stream);
+char *gen_text(gen_ctx_t *pCtx, char *dest, int min, int max, int stream);
 int int_op(int *dest, int op, int arg1, int arg2);
 
 char	*env_config (char *var, char *dflt);
@@ -112,7 +112,7 @@ main(int ac, char **av)
 	fprintf(pTablesFile, "/*\n * THIS IS A GENERATED FILE\n * SEE COLUMNS.LIST\n*/\n");
 	fprintf(pColumnsFile, "#ifndef COLUMNS_H\n#define COLUMNS_H\n");
 	fprintf(pStreamsFile, "#ifndef STREAMS_H\n#define STREAMS_H\n");
-	fprintf(pStreamsFile, "rng_t Streams[] = {\n{0, 0, 0, 0, 0, 0, 0},\n");
+	fprintf(pStreamsFile, "THREAD rng_t Streams[] = {\n{0, 0, 0, 0, 0, 0, 0},\n");
 	fprintf(pTablesFile, "#ifndef TABLES_H\n#define TABLES_H\n");
 	
 	/* add an entry to each for each column in the list */
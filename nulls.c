@@ -56,7 +56,7 @@
 int
 nullCheck(int nColumn)
 {
-	static int nLastTable = 0;
+	static THREAD int nLastTable = 0;
 	tdef *pTdef;
 	ds_key_t kBitMask = 1;
 
@@ -90,7 +90,7 @@ nullSet(ds_key_t *pDest, int nStream)
 {
 	int nThreshold;
    ds_key_t kBitMap;
-	static int nLastTable = 0;
+	static THREAD int nLastTable = 0;
    tdef *pTdef;
 
 	nLastTable = getTableFromColumn(nStream);
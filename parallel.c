@@ -40,6 +40,11 @@
 #include "scaling.h"
 #include "tdefs.h"
 #include "genrand.h"
+#include "date.h"
+#include "constants.h"
+
+static THREAD ds_key_t kChunkFirstRow = 0,
+	kChunkRowCount = 0;
 
 /*
 * Routine: split_work(int tnum, worker_t *w)
@@ -61,6 +66,14 @@ split_work (int tnum, ds_key_t * pkFirstRow, ds_key_t * pkRowCount)
   ds_key_t kTotalRows, kRowsetSize, kExtraRows;
   int nParallel, nChild;
 
+  /* a worker thread only builds the chunk it was handed by gen_tbl() */
+  if (kChunkFirstRow)
+	 {
+		*pkFirstRow = kChunkFirstRow;
+		*pkRowCount = kChunkRowCount;
+		return (1);
+	 }
+
   kTotalRows = get_rowcount(tnum);
   nParallel = get_int ("PARALLEL");
   nChild = get_int ("CHILD");
@@ -107,6 +120,75 @@ split_work (int tnum, ds_key_t * pkFirstRow, ds_key_t * pkRowCount)
   return (1);
 }
 
+/*
+ * Routine: set_chunk(ds_key_t kFirstRow, ds_key_t kRowCount)
+ * Purpose: restrict the calling thread to a sub-range of the rows assigned by split_work()
+ * Algorithm:
+ * Data Structures:
+ *
+ * Params: kFirstRow of 0 clears the restriction
+ * Returns:
+ * Called By: worker threads started by gen_tbl()
+ * Calls: 
+ * Assumptions:
+ * Side Effects: later calls to split_work() from this thread (e.g. in skipDays())
+ *	report the sub-range
+ * TODO: None
+ */
+void
+set_chunk (ds_key_t kFirstRow, ds_key_t kRowCount)
+{
+  kChunkFirstRow = kFirstRow;
+  kChunkRowCount = kRowCount;
+
+  return;
+}
+
+/*
+* Routine: skipDays(int nTable, ds_key_t *pRemainder)
+* Purpose: find the date of the first row of this part of a date based table
+* Algorithm:
+* Data Structures:
+*
+* Params:
+* Returns: the julian date of the first row; *pRemainder is set to the row at
+*	which the date next changes
+* Called By: mk_w_catalog_sales(), mk_w_store_sales(), mk_w_web_sales() and their
+*	validation routines
+* Calls: 
+* Assumptions:
+* Side Effects:
+* TODO: None
+*/
+ds_key_t
+skipDays(int nTable, ds_key_t *pRemainder)
+{
+	static THREAD int bInit = 0;
+   static THREAD date_t BaseDate;
+   ds_key_t jDate;
+	ds_key_t kRowCount,
+		kFirstRow,
+      kDayStart;
+	int nDay;
+
+   if (!bInit)
+   {
+      strtodt(&BaseDate, DATA_START_DATE);
+      bInit = 1;
+      *pRemainder = 0;
+   }
+	
+   // find the day that holds the first row of this part of a parallel build
+  split_work(nTable, &kFirstRow, &kRowCount);
+  nDay = getDayByRow(nTable, kFirstRow, &kDayStart);
+  jDate = BaseDate.julian + nDay;
+  if (nDay)	/* a day runs from the row after its first row to the next day's first row */
+     jDate -= 1;
+  *pRemainder = (nDay)?kDayStart:dateScaling(nTable, BaseDate.julian) + 1;
+	
+	return(jDate);
+}
+
 /*
  * Routine: 
  * Purpose: 
@@ -124,8 +206,8 @@ split_work (int tnum, ds_key_t * pkFirstRow, ds_key_t * pkRowCount)
 int
 checkSeeds (tdef * pTdef)
 {
-  int i, res, nReturnCode = 0;
-  static int bInit = 0, bSetSeeds = 0;
+  int i, nReturnCode = 0;
+  static THREAD int bInit = 0, bSetSeeds = 0;
 
   if (!bInit)
 	 {
@@ -135,8 +217,9 @@ checkSeeds (tdef * pTdef)
 
   for (i = pTdef->nFirstColumn; i <= pTdef->nLastColumn; i++)
 	 {
-		while (Streams[i].nUsed < Streams[i].nUsedPerRow)
-		  genrand_integer (&res, DIST_UNIFORM, 1, 100, 0, i);
+		/* jump straight to the next row's seed rather than drawing up to it */
+		if (Streams[i].nUsed < Streams[i].nUsedPerRow)
+		  advance_random (i, Streams[i].nUsedPerRow - Streams[i].nUsed);
 		if (bSetSeeds)
 		  {
 			 if (Streams[i].nUsed > Streams[i].nUsedPerRow)
@@ -38,4 +38,6 @@
 int split_work(int nTable, ds_key_t *pkFirstRow, ds_key_t *pkRowCount);
 int	row_stop(int tbl);
 int	row_skip(int tbl, ds_key_t count);
+void	set_chunk(ds_key_t kFirstRow, ds_key_t kRowCount);
+ds_key_t skipDays(int nTable, ds_key_t *pRemainder);
 #endif /* PARALLEL_H */
@@ -66,10 +66,22 @@ option_t options[] =
 {"VCOUNT",		OPT_INT|OPT_ADV,	22, "set number of validation rows to be produced", NULL, "50"}, 
 {"VSUFFIX",		OPT_STR|OPT_ADV,	23, "set file suffix for data validation", NULL, ".vld"}, 
 {"RNGSEED",		OPT_INT|OPT_ADV,	24, "set RNG seed", NULL, "19620718"}, 
+{"THREADS",		OPT_INT|OPT_ADV,	25, "build fact tables with <n> threads", NULL, ""}, 
+{"RETURNS",		OPT_FLG|OPT_ADV,	26, "write the returns table in the same pass as its sales table", NULL, "N"}, 
+{"STATELESS",	OPT_FLG|OPT_ADV,	27, "compute item permutations on demand (changes output)", NULL, "N"}, 
+{"STATS",		OPT_FLG|OPT_ADV,	28, "report rows, bytes and timings for each table on stderr", NULL, "N"}, 
+{"MONITOR",	OPT_STR|OPT_ADV,	29, "write progress records to <s> (a file, FIFO or descriptor number)", NULL, ""}, 
+{"INTERVAL",	OPT_INT|OPT_ADV,	30, "seconds between -MONITOR records", NULL, "5"}, 
+{"FORMAT",		OPT_STR|OPT_ADV,	31, "write rows as <s>: text, arrow or parquet", NULL, "text"}, 
+{"COMPRESS",	OPT_STR|OPT_ADV,	32, "compress -FORMAT parquet pages with <s>: none or snappy", NULL, "none"}, 
+{"DBLOAD",		OPT_FLG|OPT_ADV,	33, "write PostgreSQL binary COPY files through the load routines", NULL, "N"}, 
+{"PIPELINE",	OPT_FLG|OPT_ADV,	34, "write output from a separate thread while rows are generated", NULL, "N"}, 
+{"SHARDS",		OPT_INT|OPT_ADV,	35, "split each table into <n> files by a hash of its -SHARDKEY column", NULL, ""}, 
+{"SHARDKEY",	OPT_STR|OPT_ADV,	36, "comma separated shard columns, at most one per table; default is the first column", NULL, ""}, 
 {NULL}
 };
 
-char *params[23 + 2];
+char *params[35 + 2];
 #else
 extern option_t options[];
 extern char *params[];
@@ -0,0 +1,1130 @@
+/* 
+ * Legal Notice 
+ * 
+ * This document and associated source code (the "Work") is a part of a 
+ * benchmark specification maintained by the TPC. 
+ * 
+ * The TPC reserves all right, title, and interest to the Work as provided 
+ * under U.S. and international laws, including without limitation all patent 
+ * and trademark rights therein. 
+ * 
+ * No Warranty 
+ * 
+ * 1.1 TO THE MAXIMUM EXTENT PERMITTED BY APPLICABLE LAW, THE INFORMATION 
+ *     CONTAINED HEREIN IS PROVIDED "AS IS" AND WITH ALL FAULTS, AND THE 
+ *     AUTHORS AND DEVELOPERS OF THE WORK HEREBY DISCLAIM ALL OTHER 
+ *     WARRANTIES AND CONDITIONS, EITHER EXPRESS, IMPLIED OR STATUTORY, 
+ *     INCLUDING, BUT NOT LIMITED TO, ANY (IF ANY) IMPLIED WARRANTIES, 
+ *     DUTIES OR CONDITIONS OF MERCHANTABILITY, OF FITNESS FOR A PARTICULAR 
+ *     PURPOSE, OF ACCURACY OR COMPLETENESS OF RESPONSES, OF RESULTS, OF 
+ *     WORKMANLIKE EFFORT, OF LACK OF VIRUSES, AND OF LACK OF NEGLIGENCE. 
+ *     ALSO, THERE IS NO WARRANTY OR CONDITION OF TITLE, QUIET ENJOYMENT, 
+ *     QUIET POSSESSION, CORRESPONDENCE TO DESCRIPTION OR NON-INFRINGEMENT 
+ *     WITH REGARD TO THE WORK. 
+ * 1.2 IN NO EVENT WILL ANY AUTHOR OR DEVELOPER OF THE WORK BE LIABLE TO 
+ *     ANY OTHER PARTY FOR ANY DAMAGES, INCLUDING BUT NOT LIMITED TO THE 
+ *     COST OF PROCURING SUBSTITUTE GOODS OR SERVICES, LOST PROFITS, LOSS 
+ *     OF USE, LOSS OF DATA, OR ANY INCIDENTAL, CONSEQUENTIAL, DIRECT, 
+ *     INDIRECT, OR SPECIAL DAMAGES WHETHER UNDER CONTRACT, TORT, WARRANTY,
+ *     OR OTHERWISE, ARISING IN ANY WAY OUT OF THIS OR ANY OTHER AGREEMENT 
+ *     RELATING TO THE WORK, WHETHER OR NOT SUCH AUTHOR OR DEVELOPER HAD 
+ *     ADVANCE NOTICE OF THE POSSIBILITY OF SUCH DAMAGES. 
+ * 
+ * Contributors:
+ * Gradient Systems
+ */ 
+#include "config.h"
+#include "porting.h"
+#include <stdio.h>
+#ifndef USE_STDLIB_H
+#include <malloc.h>
+#endif
+#include "r_params.h"
+#include "tdefs.h"
+#include "release.h"
+#include "runtime.h"
+#include "arrow.h"
+#include "parquet.h"
+
+/*
+ * Apache Parquet file format. A file is the 4 byte magic "PAR1", the row 
+ * groups, a FileMetaData structure, its length and the magic again. Every 
+ * column of a row group is written as an optional dictionary page and a 
+ * single version 1 data page, each preceded by a PageHeader. The metadata 
+ * structures use the Thrift compact protocol. All columns are OPTIONAL, so
+ * a data page holds RLE encoded definition levels, and then the non-NULL 
+ * values, either PLAIN or as RLE_DICTIONARY codes.
+ */
+#define PARQUET_MAGIC		"PAR1"
+#define PARQUET_VERSION		1
+
+/* parquet.thrift */
+#define PT_INT32			1
+#define PT_INT64			2
+#define PT_BYTE_ARRAY		6
+#define CT_NONE				-1
+#define CT_UTF8				0
+#define CT_DECIMAL			5
+#define CT_DATE				6
+#define CT_TIME_MILLIS		7
+#define REPETITION_OPTIONAL	1
+#define ENC_PLAIN			0
+#define ENC_RLE				3
+#define ENC_RLE_DICTIONARY	8
+#define PAGE_DATA			0
+#define PAGE_DICTIONARY		2
+#define MAX_INT64_PRECISION	18
+
+/* Thrift compact protocol types */
+#define TC_I32		5
+#define TC_I64		6
+#define TC_BINARY	8
+#define TC_LIST		9
+#define TC_STRUCT	12
+#define TC_DEPTH	8
+
+#define SNAPPY_HASH_BITS	14
+#define SNAPPY_MAX_OFFSET	65535
+#define DIST_MISSES			64	/* values to try against the distributions */
+
+typedef struct THRIFT_T {
+	arrow_buf_t *pBuf;
+	int nLast;	/* field id of the previous field of the current struct */
+	int arLast[TC_DEPTH];
+	int nDepth;
+} thrift_t;
+
+/*
+* Routine: tc_byte(thrift_t *t, int nValue)
+* Purpose: primitives of the Thrift compact protocol
+* Algorithm: field headers carry the field id as a delta from the previous
+*	field of the same struct when it fits in 4 bits; integers are zigzag
+*	varints; structs end with a 0 byte
+* Data Structures:
+*
+* Params:
+* Returns:
+* Called By: 
+* Calls: 
+* Assumptions:
+* Side Effects:
+* TODO: None
+*/
+static void
+tc_byte(thrift_t *t, int nValue)
+{
+	int nPos = arrow_reserve(t->pBuf, 1, 1);
+
+	t->pBuf->pData[nPos] = (char)nValue;
+
+	return;
+}
+
+static void
+tc_varint(thrift_t *t, ds_key_t kValue)
+{
+	unsigned long long kBits = (unsigned long long)kValue;
+
+	while (kBits >= 0x80)
+	{
+		tc_byte(t, (int)(kBits & 0x7F) | 0x80);
+		kBits >>= 7;
+	}
+	tc_byte(t, (int)kBits);
+
+	return;
+}
+
+static void
+tc_zigzag(thrift_t *t, ds_key_t kValue)
+{
+	tc_varint(t, (ds_key_t)(((unsigned long long)kValue << 1) ^ (unsigned long long)(kValue >> 63)));
+
+	return;
+}
+
+static void
+tc_field(thrift_t *t, int nId, int nType)
+{
+	if ((nId > t->nLast) && (nId - t->nLast <= 15))
+		tc_byte(t, ((nId - t->nLast) << 4) | nType);
+	else
+	{
+		tc_byte(t, nType);
+		tc_zigzag(t, nId);
+	}
+	t->nLast = nId;
+
+	return;
+}
+
+static void
+tc_i32(thrift_t *t, int nId, int nValue)
+{
+	tc_field(t, nId, TC_I32);
+	tc_zigzag(t, nValue);
+
+	return;
+}
+
+static void
+tc_i64(thrift_t *t, int nId, ds_key_t kValue)
+{
+	tc_field(t, nId, TC_I64);
+	tc_zigzag(t, kValue);
+
+	return;
+}
+
+/* nId of 0 writes a bare string, as a list element */
+static void
+tc_string(thrift_t *t, int nId, char *szValue)
+{
+	int nLength = (int)strlen(szValue),
+		nPos;
+
+	if (nId)
+		tc_field(t, nId, TC_BINARY);
+	tc_varint(t, nLength);
+	nPos = arrow_reserve(t->pBuf, nLength, 1);
+	memcpy(t->pBuf->pData + nPos, szValue, nLength);
+
+	return;
+}
+
+static void
+tc_list(thrift_t *t, int nId, int nType, int nCount)
+{
+	tc_field(t, nId, TC_LIST);
+	if (nCount < 15)
+		tc_byte(t, (nCount << 4) | nType);
+	else
+	{
+		tc_byte(t, 0xF0 | nType);
+		tc_varint(t, nCount);
+	}
+
+	return;
+}
+
+/* nId of 0 starts the outermost struct, or a list element */
+static void
+tc_begin(thrift_t *t, int nId)
+{
+	if (t->nDepth == TC_DEPTH)
+	{
+		INTERNAL("Parquet metadata is nested too deeply");
+		exit(-1);
+	}
+	if (nId)
+		tc_field(t, nId, TC_STRUCT);
+	t->arLast[t->nDepth++] = t->nLast;
+	t->nLast = 0;
+
+	return;
+}
+
+static void
+tc_end(thrift_t *t)
+{
+	tc_byte(t, 0);
+	t->nLast = t->arLast[--t->nDepth];
+
+	return;
+}
+
+/*
+* Routine: get_le(char *pSrc, int nBytes)
+* Purpose: read a little endian value stored by arrow_put_le()
+* Algorithm:
+* Data Structures:
+*
+* Params:
+* Returns: the value, sign extended
+* Called By: 
+* Calls: 
+* Assumptions:
+* Side Effects:
+* TODO: None
+*/
+static ds_key_t
+get_le(char *pSrc, int nBytes)
+{
+	unsigned long long kValue = 0;
+	int i;
+
+	for (i=nBytes - 1; i >= 0; i--)
+		kValue = (kValue << 8) | (unsigned char)pSrc[i];
+	if (nBytes < 8)
+	{
+		i = 64 - 8 * nBytes;
+		return((ds_key_t)(kValue << i) >> i);
+	}
+
+	return((ds_key_t)kValue);
+}
+
+/*
+* Routine: rle_encode(arrow_buf_t *pBuf, int *arValues, int nCount, int nBitWidth)
+* Purpose: write values with the RLE/bit-packing hybrid encoding
+* Algorithm: the values are taken in groups of 8. Where 8 or more equal
+*	values start a group they become an RLE run; otherwise the group joins
+*	a bit-packed run. Only the last group may be padded.
+* Data Structures:
+*
+* Params:
+* Returns:
+* Called By: 
+* Calls: 
+* Assumptions:
+* Side Effects:
+* TODO: None
+*/
+static void
+rle_packed(thrift_t *t, int *arValues, int nCount, int nBitWidth)
+{
+	int i,
+		nGroups = (nCount + 7) / 8,
+		nBits = 0,
+		nPos;
+	unsigned long long kBits = 0;
+
+	if (nGroups == 0)
+		return;
+	tc_varint(t, (nGroups << 1) | 1);
+	nPos = arrow_reserve(t->pBuf, nGroups * nBitWidth, 1);
+	for (i=0; i < nGroups * 8; i++)
+	{
+		kBits |= (unsigned long long)((i < nCount)?arValues[i]:0) << nBits;
+		nBits += nBitWidth;
+		while (nBits >= 8)
+		{
+			t->pBuf->pData[nPos++] = (char)(kBits & 0xFF);
+			kBits >>= 8;
+			nBits -= 8;
+		}
+	}
+
+	return;
+}
+
+static void
+rle_encode(arrow_buf_t *pBuf, int *arValues, int nCount, int nBitWidth)
+{
+	thrift_t Varint;
+	int i = 0,
+		nStart = 0,
+		nRun,
+		nPos;
+
+	memset(&Varint, 0, sizeof(thrift_t));
+	Varint.pBuf = pBuf;
+	while (i < nCount)
+	{
+		for (nRun=1; (i + nRun < nCount) && (arValues[i + nRun] == arValues[i]); nRun++);
+		if (nRun >= 8)
+		{
+			rle_packed(&Varint, arValues + nStart, i - nStart, nBitWidth);
+			tc_varint(&Varint, (ds_key_t)nRun << 1);
+			nPos = arrow_reserve(pBuf, (nBitWidth + 7) / 8, 1);
+			arrow_put_le(pBuf->pData + nPos, arValues[i], (nBitWidth + 7) / 8);
+			i += nRun;
+			nStart = i;
+		}
+		else
+			i += 8;
+	}
+	rle_packed(&Varint, arValues + nStart, ((i < nCount)?i:nCount) - nStart, nBitWidth);
+
+	return;
+}
+
+/*
+* Routine: snappy_compress(arrow_buf_t *pDest, char *pSrc, int nLength, int *arHash)
+* Purpose: compress a page in the raw snappy format
+* Algorithm: greedy LZ77: the last position of each 4 byte sequence is kept
+*	in a hash table, and a match is extended as far as it goes. Matches are
+*	written as copies with 2 byte offsets, everything else as literals. The
+*	step between probes grows while nothing matches, as in the reference 
+*	implementation, so incompressible data is passed over quickly.
+* Data Structures:
+*
+* Params:
+* Returns:
+* Called By: parquet_page()
+* Calls: 
+* Assumptions: arHash has 1 << SNAPPY_HASH_BITS entries
+* Side Effects:
+* TODO: None
+*/
+static void
+snappy_literal(arrow_buf_t *pDest, char *pSrc, int nLength)
+{
+	int nPos,
+		nBytes;
+
+	if (nLength == 0)
+		return;
+	if (nLength <= 60)
+	{
+		nPos = arrow_reserve(pDest, 1 + nLength, 1);
+		pDest->pData[nPos++] = (char)((nLength - 1) << 2);
+	}
+	else
+	{
+		for (nBytes=1; (nBytes < 4) && ((nLength - 1) >> (8 * nBytes)); nBytes++);
+		nPos = arrow_reserve(pDest, 1 + nBytes + nLength, 1);
+		pDest->pData[nPos++] = (char)((59 + nBytes) << 2);
+		arrow_put_le(pDest->pData + nPos, nLength - 1, nBytes);
+		nPos += nBytes;
+	}
+	memcpy(pDest->pData + nPos, pSrc, nLength);
+
+	return;
+}
+
+static void
+snappy_compress(arrow_buf_t *pDest, char *pSrc, int nLength, int *arHash)
+{
+	thrift_t Varint;
+	int i = 0,
+		nLiteral = 0,
+		nCandidate,
+		nMatch,
+		nCopy,
+		nPos,
+		nSkip = 32;
+	unsigned int nValue;
+
+	memset(&Varint, 0, sizeof(thrift_t));
+	Varint.pBuf = pDest;
+	tc_varint(&Varint, nLength);
+	memset(arHash, 0, sizeof(int) << SNAPPY_HASH_BITS);
+
+	while (i + 4 <= nLength)
+	{
+		memcpy(&nValue, pSrc + i, 4);
+		nPos = (int)((nValue * 0x1E35A7BDU) >> (32 - SNAPPY_HASH_BITS));
+		nCandidate = arHash[nPos] - 1;
+		arHash[nPos] = i + 1;
+		if ((nCandidate < 0) || (i - nCandidate > SNAPPY_MAX_OFFSET) || memcmp(pSrc + nCandidate, pSrc + i, 4))
+		{
+			i += nSkip++ >> 5;
+			continue;
+		}
+
+		snappy_literal(pDest, pSrc + nLiteral, i - nLiteral);
+		for (nMatch=4; (i + nMatch < nLength) && (pSrc[nCandidate + nMatch] == pSrc[i + nMatch]); nMatch++);
+		while (nMatch > 0)
+		{
+			nCopy = (nMatch > 64)?64:nMatch;
+			nPos = arrow_reserve(pDest, 3, 1);
+			pDest->pData[nPos] = (char)(((nCopy - 1) << 2) | 2);
+			arrow_put_le(pDest->pData + nPos + 1, i - nCandidate, 2);
+			i += nCopy;
+			nCandidate += nCopy;
+			nMatch -= nCopy;
+		}
+		nLiteral = i;
+		nSkip = 32;
+	}
+	snappy_literal(pDest, pSrc + nLiteral, nLength - nLiteral);
+
+	return;
+}
+
+/*
+* Routine: parquet_new(int nTable, int nChunk)
+* Purpose: start a Parquet file for a table
+* Algorithm:
+* Data Structures:
+*
+* Params: nChunk: the -THREADS spool file being written, or 0
+* Returns:
+* Called By: print_start(), print_merge()
+* Calls: 
+* Assumptions:
+* Side Effects:
+* TODO: None
+*/
+parquet_file_t *
+parquet_new(int nTable, int nChunk)
+{
+	parquet_file_t *pFile;
+
+	pFile = (parquet_file_t *)malloc(sizeof(parquet_file_t));
+	MALLOC_CHECK(pFile);
+	memset(pFile, 0, sizeof(parquet_file_t));
+	pFile->nTable = nTable;
+	pFile->nChunk = nChunk;
+
+	return(pFile);
+}
+
+/*
+* Routine: parquet_free(parquet_file_t *pFile)
+* Purpose: release a Parquet file
+* Algorithm:
+* Data Structures:
+*
+* Params:
+* Returns:
+* Called By: print_close(), print_merge()
+* Calls: 
+* Assumptions:
+* Side Effects:
+* TODO: None
+*/
+void
+parquet_free(parquet_file_t *pFile)
+{
+	free(pFile->arColumns);
+	free(pFile->arRows);
+	free(pFile->arChunks);
+	free(pFile->arLevels);
+	free(pFile->arSnappy);
+	free(pFile->Output.pData);
+	free(pFile->Page.pData);
+	free(pFile->Compressed.pData);
+	free(pFile);
+
+	return;
+}
+
+/*
+* Routine: dict_find(parquet_dict_t *pDict, char *szValue, int nLength)
+* Purpose: find or add a dictionary entry
+* Algorithm: FNV-1a hash, open addressing with linear probing; the table is
+*	kept at most half full
+* Data Structures:
+*
+* Params:
+* Returns: the code of the entry, or -1 if the dictionary has been given up
+* Called By: parquet_dictionary()
+* Calls: 
+* Assumptions:
+* Side Effects: sets bPlain when the dictionary grows too large
+* TODO: None
+*/
+static unsigned int
+dict_hash(char *szValue, int nLength)
+{
+	unsigned int nHash = 2166136261U;
+	int i;
+
+	for (i=0; i < nLength; i++)
+		nHash = (nHash ^ (unsigned char)szValue[i]) * 16777619U;
+
+	return(nHash);
+}
+
+static int
+dict_find(parquet_dict_t *pDict, char *szValue, int nLength)
+{
+	int i,
+		nSlot,
+		nEntry,
+		nPos;
+	char *pEntry;
+
+	if (pDict->nEntries * 2 >= pDict->nHashSize)
+	{
+		pDict->nHashSize = (pDict->nHashSize)?2 * pDict->nHashSize:1024;
+		pDict->arHash = (int *)realloc(pDict->arHash, pDict->nHashSize * sizeof(int));
+		MALLOC_CHECK(pDict->arHash);
+		memset(pDict->arHash, 0, pDict->nHashSize * sizeof(int));
+		pDict->arEntry = (int *)realloc(pDict->arEntry, (pDict->nHashSize / 2) * sizeof(int));
+		MALLOC_CHECK(pDict->arEntry);
+		for (i=0; i < pDict->nEntries; i++)
+		{
+			pEntry = pDict->Values.pData + pDict->arEntry[i];
+			nSlot = dict_hash(pEntry + 4, (int)get_le(pEntry, 4)) & (pDict->nHashSize - 1);
+			while (pDict->arHash[nSlot])
+				nSlot = (nSlot + 1) & (pDict->nHashSize - 1);
+			pDict->arHash[nSlot] = i + 1;
+		}
+	}
+
+	nSlot = dict_hash(szValue, nLength) & (pDict->nHashSize - 1);
+	while ((nEntry = pDict->arHash[nSlot]) != 0)
+	{
+		pEntry = pDict->Values.pData + pDict->arEntry[nEntry - 1];
+		if ((get_le(pEntry, 4) == nLength) && !memcmp(pEntry + 4, szValue, nLength))
+			return(nEntry - 1);
+		nSlot = (nSlot + 1) & (pDict->nHashSize - 1);
+	}
+
+	if ((pDict->nEntries == PARQUET_DICT_ENTRIES) || (pDict->Values.nUsed + 4 + nLength > PARQUET_DICT_BYTES))
+	{
+		pDict->bPlain = 1;
+		return(-1);
+	}
+	nPos = arrow_reserve(&pDict->Values, 4 + nLength, 1);
+	arrow_put_le(pDict->Values.pData + nPos, nLength, 4);
+	memcpy(pDict->Values.pData + nPos + 4, szValue, nLength);
+	pDict->arEntry[pDict->nEntries] = nPos;
+	pDict->arHash[nSlot] = ++pDict->nEntries;
+
+	return(pDict->nEntries - 1);
+}
+
+/*
+* Routine: parquet_dictionary(arrow_batch_t *pBatch, arrow_column_t *pColumn, char *szValue, int nLength)
+* Purpose: find the dictionary code of a string as it is added to a column
+* Algorithm: most strings that repeat were picked from a distribution by
+*	dist_op(), and a pointer into the distribution comes with them. For 
+*	those the code is kept by position in the string space of the 
+*	distribution, so each distinct value is hashed once per row group and
+*	every later occurrence is a single array lookup. Other strings are 
+*	hashed. A column that has not matched a distribution within DIST_MISSES
+*	values stops looking, and one with more than PARQUET_DICT_ENTRIES 
+*	distinct values in a row group is written PLAIN from then on.
+* Data Structures:
+*
+* Params:
+* Returns:
+* Called By: arrow_string()
+* Calls: dist_string(), dict_find()
+* Assumptions: NULLs are not passed
+* Side Effects:
+* TODO: None
+*/
+void
+parquet_dictionary(arrow_batch_t *pBatch, arrow_column_t *pColumn, char *szValue, int nLength)
+{
+	parquet_dict_t *pDict = pColumn->pDictionary;
+	int nOffset = -1,
+		nCode = -1;
+
+	if (pDict == NULL)
+	{
+		pDict = (parquet_dict_t *)malloc(sizeof(parquet_dict_t));
+		MALLOC_CHECK(pDict);
+		memset(pDict, 0, sizeof(parquet_dict_t));
+		pDict->arCode = (int *)malloc(pBatch->nMaxRows * sizeof(int));
+		MALLOC_CHECK(pDict->arCode);
+		pColumn->pDictionary = pDict;
+	}
+	if (pDict->bPlain)
+		return;
+
+	if (pDict->pDist || (pDict->nMisses < DIST_MISSES))
+	{
+		nOffset = dist_string(szValue, &pDict->pDist);
+		if (nOffset >= 0)
+		{
+			if (pDict->arDistCode == NULL)
+			{
+				pDict->arDistCode = (int *)malloc(pDict->pDist->str_space * sizeof(int));
+				MALLOC_CHECK(pDict->arDistCode);
+				memset(pDict->arDistCode, 0, pDict->pDist->str_space * sizeof(int));
+			}
+			nCode = pDict->arDistCode[nOffset] - 1;
+		}
+		else if (pDict->pDist == NULL)
+			pDict->nMisses += 1;
+	}
+
+	if (nCode < 0)
+	{
+		if ((nCode = dict_find(pDict, szValue, nLength)) < 0)
+			return;
+		if (nOffset >= 0)
+			pDict->arDistCode[nOffset] = nCode + 1;
+	}
+	pDict->arCode[pDict->nCodes++] = nCode;
+
+	return;
+}
+
+/*
+* Routine: parquet_free_dictionary(parquet_dict_t *pDict)
+* Purpose: release the dictionary of a column
+* Algorithm:
+* Data Structures:
+*
+* Params:
+* Returns:
+* Called By: arrow_free()
+* Calls: 
+* Assumptions:
+* Side Effects:
+* TODO: None
+*/
+void
+parquet_free_dictionary(parquet_dict_t *pDict)
+{
+	free(pDict->arEntry);
+	free(pDict->Values.pData);
+	free(pDict->arHash);
+	free(pDict->arCode);
+	free(pDict->arDistCode);
+	free(pDict);
+
+	return;
+}
+
+/*
+* Routine: parquet_type(arrow_column_t *pColumn, int *pConverted)
+* Purpose: map a column to its Parquet physical and converted types
+* Algorithm: decimals are stored as INT64, which holds up to 18 digits
+* Data Structures:
+*
+* Params:
+* Returns: the physical type
+* Called By: 
+* Calls: 
+* Assumptions:
+* Side Effects:
+* TODO: None
+*/
+static int
+parquet_type(arrow_column_t *pColumn, int *pConverted)
+{
+	switch(pColumn->nType)
+	{
+	case ARROW_INT64: *pConverted = CT_NONE; return(PT_INT64);
+	case ARROW_DATE32: *pConverted = CT_DATE; return(PT_INT32);
+	case ARROW_TIME32: *pConverted = CT_TIME_MILLIS; return(PT_INT32);
+	case ARROW_DECIMAL: *pConverted = CT_DECIMAL; return(PT_INT64);
+	case ARROW_UTF8: *pConverted = CT_UTF8; return(PT_BYTE_ARRAY);
+	default: *pConverted = CT_NONE; return(PT_INT32);
+	}
+}
+
+/*
+* Routine: parquet_page(parquet_file_t *pFile, int nType, int nValues, int nEncoding, parquet_chunk_t *pChunk)
+* Purpose: write the page assembled in pFile->Page to the output, behind its
+*	PageHeader, compressing it if -COMPRESS asks for it
+* Algorithm:
+* Data Structures:
+*
+* Params:
+* Returns:
+* Called By: parquet_encode()
+* Calls: snappy_compress()
+* Assumptions:
+* Side Effects:
+* TODO: None
+*/
+static void
+parquet_page(parquet_file_t *pFile, int nType, int nValues, int nEncoding, parquet_chunk_t *pChunk)
+{
+	thrift_t t;
+	arrow_buf_t *pBody = &pFile->Page;
+	int nStart = pFile->Output.nUsed,
+		nPos;
+
+	if (g_Runtime.nCompress == COMPRESS_SNAPPY)
+	{
+		if (pFile->arSnappy == NULL)
+		{
+			pFile->arSnappy = (int *)malloc(sizeof(int) << SNAPPY_HASH_BITS);
+			MALLOC_CHECK(pFile->arSnappy);
+		}
+		pFile->Compressed.nUsed = 0;
+		snappy_compress(&pFile->Compressed, pFile->Page.pData, pFile->Page.nUsed, pFile->arSnappy);
+		pBody = &pFile->Compressed;
+	}
+
+	if (nType == PAGE_DICTIONARY)
+		pChunk->kDictionaryOffset = pFile->kOffset + nStart;
+	else
+		pChunk->kDataOffset = pFile->kOffset + nStart;
+
+	memset(&t, 0, sizeof(thrift_t));
+	t.pBuf = &pFile->Output;
+	tc_begin(&t, 0);
+	tc_i32(&t, 1, nType);
+	tc_i32(&t, 2, pFile->Page.nUsed);
+	tc_i32(&t, 3, pBody->nUsed);
+	if (nType == PAGE_DICTIONARY)
+	{
+		tc_begin(&t, 7);
+		tc_i32(&t, 1, nValues);
+		tc_i32(&t, 2, nEncoding);
+		tc_end(&t);
+	}
+	else
+	{
+		tc_begin(&t, 5);
+		tc_i32(&t, 1, nValues);
+		tc_i32(&t, 2, nEncoding);
+		tc_i32(&t, 3, ENC_RLE);
+		tc_i32(&t, 4, ENC_RLE);
+		tc_end(&t);
+	}
+	tc_end(&t);
+
+	nPos = pFile->Output.nUsed - nStart;	/* header size */
+	pChunk->kSize += nPos + pBody->nUsed;
+	pChunk->kRawSize += nPos + pFile->Page.nUsed;
+	nPos = arrow_reserve(&pFile->Output, pBody->nUsed, 1);
+	memcpy(pFile->Output.pData + nPos, pBody->pData, pBody->nUsed);
+
+	return;
+}
+
+/*
+* Routine: parquet_column(parquet_file_t *pFile, arrow_batch_t *pBatch, arrow_column_t *pColumn, parquet_chunk_t *pChunk)
+* Purpose: write one column of a row group
+* Algorithm:
+* Data Structures:
+*
+* Params:
+* Returns:
+* Called By: parquet_encode()
+* Calls: parquet_page(), rle_encode()
+* Assumptions:
+* Side Effects:
+* TODO: None
+*/
+static void
+parquet_column(parquet_file_t *pFile, arrow_batch_t *pBatch, arrow_column_t *pColumn, parquet_chunk_t *pChunk)
+{
+	parquet_dict_t *pDict = pColumn->pDictionary;
+	arrow_buf_t *pPage = &pFile->Page;
+	int i,
+		nPos,
+		nWidth,
+		nBitWidth,
+		nStart,
+		nEnd,
+		nValues = pBatch->nRows - pColumn->nNulls,
+		bDictionary;
+	ds_key_t kValue;
+
+	memset(pChunk, 0, sizeof(parquet_chunk_t));
+	pChunk->kDictionaryOffset = -1;
+	pChunk->kValues = pBatch->nRows;
+	bDictionary = pDict && !pDict->bPlain && (pDict->nCodes == nValues) && (nValues > 0);
+
+	if (bDictionary)
+	{
+		pPage->nUsed = 0;
+		nPos = arrow_reserve(pPage, pDict->Values.nUsed, 1);
+		memcpy(pPage->pData + nPos, pDict->Values.pData, pDict->Values.nUsed);
+		parquet_page(pFile, PAGE_DICTIONARY, pDict->nEntries, ENC_PLAIN, pChunk);
+	}
+
+	/* definition levels, behind their length */
+	pPage->nUsed = 0;
+	nPos = arrow_reserve(pPage, 4, 1);
+	for (i=0; i < pBatch->nRows; i++)
+		pFile->arLevels[i] = (pColumn->pValidity[i >> 3] >> (i & 7)) & 1;
+	rle_encode(pPage, pFile->arLevels, pBatch->nRows, 1);
+	arrow_put_le(pPage->pData + nPos, pPage->nUsed - 4, 4);
+
+	if (bDictionary)
+	{
+		for (nBitWidth=1; (nBitWidth < 32) && ((pDict->nEntries - 1) >> nBitWidth); nBitWidth++);
+		nPos = arrow_reserve(pPage, 1, 1);
+		pPage->pData[nPos] = (char)nBitWidth;
+		rle_encode(pPage, pDict->arCode, pDict->nCodes, nBitWidth);
+		parquet_page(pFile, PAGE_DATA, pBatch->nRows, ENC_RLE_DICTIONARY, pChunk);
+		return;
+	}
+
+	for (i=0; i < pBatch->nRows; i++)
+	{
+		if (!pFile->arLevels[i])
+			continue;
+		switch(pColumn->nType)
+		{
+		case ARROW_UTF8:
+			nStart = (int)get_le(pColumn->pValues + i * 4, 4);
+			nEnd = (int)get_le(pColumn->pValues + (i + 1) * 4, 4);
+			nPos = arrow_reserve(pPage, 4 + nEnd - nStart, 1);
+			arrow_put_le(pPage->pData + nPos, nEnd - nStart, 4);
+			memcpy(pPage->pData + nPos + 4, pColumn->pData + nStart, nEnd - nStart);
+			break;
+		case ARROW_TIME32:
+			kValue = get_le(pColumn->pValues + i * 4, 4) * 1000;
+			nPos = arrow_reserve(pPage, 4, 1);
+			arrow_put_le(pPage->pData + nPos, kValue, 4);
+			break;
+		case ARROW_DECIMAL:
+			nPos = arrow_reserve(pPage, 8, 1);
+			memcpy(pPage->pData + nPos, pColumn->pValues + i * 16, 8);
+			break;
+		default:
+			nWidth = (pColumn->nType == ARROW_INT64)?8:4;
+			nPos = arrow_reserve(pPage, nWidth, 1);
+			memcpy(pPage->pData + nPos, pColumn->pValues + i * nWidth, nWidth);
+			break;
+		}
+	}
+	parquet_page(pFile, PAGE_DATA, pBatch->nRows, ENC_PLAIN, pChunk);
+
+	return;
+}
+
+/*
+* Routine: parquet_encode(parquet_file_t *pFile, arrow_batch_t *pBatch, int bMagic, char **ppData)
+* Purpose: write the rows collected so far as a row group, and empty the batch
+* Algorithm:
+* Data Structures:
+*
+* Params: bMagic: this is the start of the file, rather than a spool file
+*	that will be appended to it
+* Returns: the number of bytes at *ppData
+* Called By: print_end(), print_close()
+* Calls: parquet_column()
+* Assumptions:
+* Side Effects:
+* TODO: None
+*/
+int
+parquet_encode(parquet_file_t *pFile, arrow_batch_t *pBatch, int bMagic, char **ppData)
+{
+	int i,
+		nPos;
+	parquet_dict_t *pDict;
+	parquet_chunk_t *pChunk;
+
+	pFile->Output.nUsed = 0;
+	if (bMagic && (pFile->kOffset == 0))
+	{
+		nPos = arrow_reserve(&pFile->Output, 4, 1);
+		memcpy(pFile->Output.pData + nPos, PARQUET_MAGIC, 4);
+	}
+
+	if (pBatch->nRows)
+	{
+		if (pFile->arColumns == NULL)
+		{
+			pFile->nColumns = pBatch->nColumns;
+			pFile->arColumns = (arrow_column_t *)malloc(pFile->nColumns * sizeof(arrow_column_t));
+			MALLOC_CHECK(pFile->arColumns);
+			memcpy(pFile->arColumns, pBatch->arColumns, pFile->nColumns * sizeof(arrow_column_t));
+			pFile->arLevels = (int *)malloc(pBatch->nMaxRows * sizeof(int));
+			MALLOC_CHECK(pFile->arLevels);
+		}
+		if (pFile->nGroups == pFile->nAllocated)
+		{
+			pFile->nAllocated += 16;
+			pFile->arRows = (ds_key_t *)realloc(pFile->arRows, pFile->nAllocated * sizeof(ds_key_t));
+			MALLOC_CHECK(pFile->arRows);
+			pFile->arChunks = (parquet_chunk_t *)realloc(pFile->arChunks, 
+				pFile->nAllocated * pFile->nColumns * sizeof(parquet_chunk_t));
+			MALLOC_CHECK(pFile->arChunks);
+		}
+		pFile->arRows[pFile->nGroups] = pBatch->nRows;
+		pChunk = pFile->arChunks + pFile->nGroups * pFile->nColumns;
+		for (i=0; i < pBatch->nColumns; i++)
+			parquet_column(pFile, pBatch, &pBatch->arColumns[i], pChunk + i);
+		pFile->nGroups += 1;
+
+		/* dictionaries do not carry over between row groups */
+		for (i=0; i < pBatch->nColumns; i++)
+		{
+			if ((pDict = pBatch->arColumns[i].pDictionary) == NULL)
+				continue;
+			pDict->nCodes = 0;
+			if (pDict->arHash)
+				memset(pDict->arHash, 0, pDict->nHashSize * sizeof(int));
+			if (pDict->arDistCode)
+				memset(pDict->arDistCode, 0, pDict->pDist->str_space * sizeof(int));
+			pDict->nEntries = 0;
+			pDict->Values.nUsed = 0;
+		}
+		arrow_clear(pBatch);
+	}
+
+	pFile->kOffset += pFile->Output.nUsed;
+	*ppData = pFile->Output.pData;
+	return(pFile->Output.nUsed);
+}
+
+/*
+* Routine: parquet_append(parquet_file_t *pDest, parquet_file_t *pSrc)
+* Purpose: account for the row groups of a spool file appended to pDest
+* Algorithm:
+* Data Structures:
+*
+* Params:
+* Returns:
+* Called By: print_merge()
+* Calls: 
+* Assumptions: the bytes of pSrc are written at pDest->kOffset
+* Side Effects:
+* TODO: None
+*/
+void
+parquet_append(parquet_file_t *pDest, parquet_file_t *pSrc)
+{
+	int i;
+	parquet_chunk_t *pChunk;
+
+	if (pSrc->nGroups)
+	{
+		if (pDest->arColumns == NULL)
+		{
+			pDest->nColumns = pSrc->nColumns;
+			pDest->arColumns = (arrow_column_t *)malloc(pDest->nColumns * sizeof(arrow_column_t));
+			MALLOC_CHECK(pDest->arColumns);
+			memcpy(pDest->arColumns, pSrc->arColumns, pDest->nColumns * sizeof(arrow_column_t));
+		}
+		pDest->nAllocated = pDest->nGroups + pSrc->nGroups;
+		pDest->arRows = (ds_key_t *)realloc(pDest->arRows, pDest->nAllocated * sizeof(ds_key_t));
+		MALLOC_CHECK(pDest->arRows);
+		pDest->arChunks = (parquet_chunk_t *)realloc(pDest->arChunks, 
+			pDest->nAllocated * pDest->nColumns * sizeof(parquet_chunk_t));
+		MALLOC_CHECK(pDest->arChunks);
+		memcpy(pDest->arRows + pDest->nGroups, pSrc->arRows, pSrc->nGroups * sizeof(ds_key_t));
+		pChunk = pDest->arChunks + pDest->nGroups * pDest->nColumns;
+		memcpy(pChunk, pSrc->arChunks, pSrc->nGroups * pSrc->nColumns * sizeof(parquet_chunk_t));
+		for (i=0; i < pSrc->nGroups * pSrc->nColumns; i++)
+		{
+			if (pChunk[i].kDictionaryOffset >= 0)
+				pChunk[i].kDictionaryOffset += pDest->kOffset;
+			pChunk[i].kDataOffset += pDest->kOffset;
+		}
+		pDest->nGroups += pSrc->nGroups;
+	}
+	pDest->kOffset += pSrc->kOffset;
+
+	return;
+}
+
+/*
+* Routine: parquet_magic(parquet_file_t *pFile, char **ppData)
+* Purpose: start a file whose first row group comes from a spool file
+* Algorithm:
+* Data Structures:
+*
+* Params:
+* Returns: the number of bytes at *ppData
+* Called By: print_merge()
+* Calls: 
+* Assumptions: nothing has been written to the file yet
+* Side Effects:
+* TODO: None
+*/
+int
+parquet_magic(parquet_file_t *pFile, char **ppData)
+{
+	*ppData = PARQUET_MAGIC;
+	pFile->kOffset += 4;
+
+	return(4);
+}
+
+/*
+* Routine: parquet_footer(parquet_file_t *pFile, char **ppData)
+* Purpose: write the FileMetaData that closes a Parquet file
+* Algorithm:
+* Data Structures:
+*
+* Params:
+* Returns: the number of bytes at *ppData
+* Called By: print_close(), print_merge()
+* Calls: 
+* Assumptions:
+* Side Effects:
+* TODO: None
+*/
+int
+parquet_footer(parquet_file_t *pFile, char **ppData)
+{
+	thrift_t t;
+	arrow_column_t *pColumn;
+	parquet_chunk_t *pChunk;
+	int i,
+		j,
+		nType,
+		nConverted,
+		nPos;
+	ds_key_t kRows = 0,
+		kBytes;
+	char szCreatedBy[64];
+
+	memset(&t, 0, sizeof(thrift_t));
+	t.pBuf = &pFile->Output;
+	pFile->Output.nUsed = 0;
+	for (i=0; i < pFile->nGroups; i++)
+		kRows += pFile->arRows[i];
+
+	tc_begin(&t, 0);
+	tc_i32(&t, 1, PARQUET_VERSION);
+	tc_list(&t, 2, TC_STRUCT, pFile->nColumns + 1);
+	tc_begin(&t, 0);
+	tc_string(&t, 4, "schema");
+	tc_i32(&t, 5, pFile->nColumns);
+	tc_end(&t);
+	for (i=0; i < pFile->nColumns; i++)
+	{
+		pColumn = &pFile->arColumns[i];
+		nType = parquet_type(pColumn, &nConverted);
+		tc_begin(&t, 0);
+		tc_i32(&t, 1, nType);
+		tc_i32(&t, 3, REPETITION_OPTIONAL);
+		tc_string(&t, 4, pColumn->szName);
+		if (nConverted != CT_NONE)
+			tc_i32(&t, 6, nConverted);
+		if (nConverted == CT_DECIMAL)
+		{
+			tc_i32(&t, 7, pColumn->nScale);
+			tc_i32(&t, 8, (pColumn->nPrecision > MAX_INT64_PRECISION)?MAX_INT64_PRECISION:pColumn->nPrecision);
+		}
+		tc_end(&t);
+	}
+	tc_i64(&t, 3, kRows);
+
+	tc_list(&t, 4, TC_STRUCT, pFile->nGroups);
+	for (i=0; i < pFile->nGroups; i++)
+	{
+		pChunk = pFile->arChunks + i * pFile->nColumns;
+		tc_begin(&t, 0);
+		tc_list(&t, 1, TC_STRUCT, pFile->nColumns);
+		kBytes = 0;
+		for (j=0; j < pFile->nColumns; j++)
+		{
+			pColumn = &pFile->arColumns[j];
+			nType = parquet_type(pColumn, &nConverted);
+			kBytes += pChunk[j].kRawSize;
+			tc_begin(&t, 0);	/* ColumnChunk */
+			tc_i64(&t, 2, (pChunk[j].kDictionaryOffset >= 0)?pChunk[j].kDictionaryOffset:pChunk[j].kDataOffset);
+			tc_begin(&t, 3);	/* ColumnMetaData */
+			tc_i32(&t, 1, nType);
+			if (pChunk[j].kDictionaryOffset >= 0)
+			{
+				tc_list(&t, 2, TC_I32, 3);
+				tc_zigzag(&t, ENC_PLAIN);
+				tc_zigzag(&t, ENC_RLE);
+				tc_zigzag(&t, ENC_RLE_DICTIONARY);
+			}
+			else
+			{
+				tc_list(&t, 2, TC_I32, 2);
+				tc_zigzag(&t, ENC_PLAIN);
+				tc_zigzag(&t, ENC_RLE);
+			}
+			tc_list(&t, 3, TC_BINARY, 1);
+			tc_string(&t, 0, pColumn->szName);
+			tc_i32(&t, 4, g_Runtime.nCompress);
+			tc_i64(&t, 5, pChunk[j].kValues);
+			tc_i64(&t, 6, pChunk[j].kRawSize);
+			tc_i64(&t, 7, pChunk[j].kSize);
+			tc_i64(&t, 9, pChunk[j].kDataOffset);
+			if (pChunk[j].kDictionaryOffset >= 0)
+				tc_i64(&t, 11, pChunk[j].kDictionaryOffset);
+			tc_end(&t);
+			tc_end(&t);
+		}
+		tc_i64(&t, 2, kBytes);
+		tc_i64(&t, 3, pFile->arRows[i]);
+		tc_end(&t);
+	}
+	sprintf(szCreatedBy, "dsdgen version %d.%d.%d%s", VERSION, RELEASE, MODIFICATION, PATCH);
+	tc_string(&t, 6, szCreatedBy);
+	tc_end(&t);
+
+	nPos = arrow_reserve(&pFile->Output, 8, 1);
+	arrow_put_le(pFile->Output.pData + nPos, nPos, 4);
+	memcpy(pFile->Output.pData + nPos + 4, PARQUET_MAGIC, 4);
+
+	pFile->kOffset += pFile->Output.nUsed;
+	*ppData = pFile->Output.pData;
+	return(pFile->Output.nUsed);
+}
@@ -0,0 +1,101 @@
+/* 
+ * Legal Notice 
+ * 
+ * This document and associated source code (the "Work") is a part of a 
+ * benchmark specification maintained by the TPC. 
+ * 
+ * The TPC reserves all right, title, and interest to the Work as provided 
+ * under U.S. and international laws, including without limitation all patent 
+ * and trademark rights therein. 
+ * 
+ * No Warranty 
+ * 
+ * 1.1 TO THE MAXIMUM EXTENT PERMITTED BY APPLICABLE LAW, THE INFORMATION 
+ *     CONTAINED HEREIN IS PROVIDED "AS IS" AND WITH ALL FAULTS, AND THE 
+ *     AUTHORS AND DEVELOPERS OF THE WORK HEREBY DISCLAIM ALL OTHER 
+ *     WARRANTIES AND CONDITIONS, EITHER EXPRESS, IMPLIED OR STATUTORY, 
+ *     INCLUDING, BUT NOT LIMITED TO, ANY (IF ANY) IMPLIED WARRANTIES, 
+ *     DUTIES OR CONDITIONS OF MERCHANTABILITY, OF FITNESS FOR A PARTICULAR 
+ *     PURPOSE, OF ACCURACY OR COMPLETENESS OF RESPONSES, OF RESULTS, OF 
+ *     WORKMANLIKE EFFORT, OF LACK OF VIRUSES, AND OF LACK OF NEGLIGENCE. 
+ *     ALSO, THERE IS NO WARRANTY OR CONDITION OF TITLE, QUIET ENJOYMENT, 
+ *     QUIET POSSESSION, CORRESPONDENCE TO DESCRIPTION OR NON-INFRINGEMENT 
+ *     WITH REGARD TO THE WORK. 
+ * 1.2 IN NO EVENT WILL ANY AUTHOR OR DEVELOPER OF THE WORK BE LIABLE TO 
+ *     ANY OTHER PARTY FOR ANY DAMAGES, INCLUDING BUT NOT LIMITED TO THE 
+ *     COST OF PROCURING SUBSTITUTE GOODS OR SERVICES, LOST PROFITS, LOSS 
+ *     OF USE, LOSS OF DATA, OR ANY INCIDENTAL, CONSEQUENTIAL, DIRECT, 
+ *     INDIRECT, OR SPECIAL DAMAGES WHETHER UNDER CONTRACT, TORT, WARRANTY,
+ *     OR OTHERWISE, ARISING IN ANY WAY OUT OF THIS OR ANY OTHER AGREEMENT 
+ *     RELATING TO THE WORK, WHETHER OR NOT SUCH AUTHOR OR DEVELOPER HAD 
+ *     ADVANCE NOTICE OF THE POSSIBILITY OF SUCH DAMAGES. 
+ * 
+ * Contributors:
+ * Gradient Systems
+ */ 
+#ifndef PARQUET_H
+#define PARQUET_H
+
+#include "arrow.h"
+#include "dist.h"
+
+/*
+ * -FORMAT parquet: the columns collected for -FORMAT arrow are written as
+ * Parquet row groups instead; see parquet.c for the layout
+ */
+#define PARQUET_GROUP_ROWS		262144
+#define PARQUET_DICT_ENTRIES	65536	/* more distinct values than this are written PLAIN */
+#define PARQUET_DICT_BYTES		(1024 * 1024)
+
+/* the dictionary of a string column, built as its values arrive */
+typedef struct PARQUET_DICT_T {
+	int bPlain;	/* too many distinct values; sticks for the rest of the file */
+	int nEntries;
+	int *arEntry;	/* position of each entry in Values */
+	arrow_buf_t Values;	/* entries, PLAIN encoded */
+	int *arHash;	/* open addressing on the entry bytes; entry + 1, 0 is empty */
+	int nHashSize;
+	int *arCode;	/* code of each non-NULL value of the row group */
+	int nCodes;
+	d_idx_t *pDist;	/* distribution the column draws from */
+	int *arDistCode;	/* code + 1 of each string offset in pDist */
+	int nMisses;	/* values found in no distribution */
+} parquet_dict_t;
+
+/* where one column of one row group was written */
+typedef struct PARQUET_CHUNK_T {
+	ds_key_t kDictionaryOffset;	/* -1 without a dictionary page */
+	ds_key_t kDataOffset;
+	ds_key_t kValues;
+	ds_key_t kSize;
+	ds_key_t kRawSize;
+} parquet_chunk_t;
+
+typedef struct PARQUET_FILE_T {
+	int nTable;
+	int nChunk;	/* -THREADS spool file that holds the row groups */
+	int nColumns;
+	arrow_column_t *arColumns;	/* names and types only */
+	int nGroups;
+	int nAllocated;
+	ds_key_t *arRows;	/* rows of each row group */
+	parquet_chunk_t *arChunks;	/* nColumns for each row group */
+	ds_key_t kOffset;	/* bytes written so far */
+	int *arLevels;	/* definition levels of the column being encoded */
+	int *arSnappy;	/* hash table for snappy_compress() */
+	arrow_buf_t Output;
+	arrow_buf_t Page;
+	arrow_buf_t Compressed;
+	struct PARQUET_FILE_T *pNext;
+} parquet_file_t;
+
+parquet_file_t *parquet_new(int nTable, int nChunk);
+void parquet_free(parquet_file_t *pFile);
+void parquet_dictionary(arrow_batch_t *pBatch, arrow_column_t *pColumn, char *szValue, int nLength);
+void parquet_free_dictionary(parquet_dict_t *pDict);
+int parquet_encode(parquet_file_t *pFile, arrow_batch_t *pBatch, int bMagic, char **ppData);
+void parquet_append(parquet_file_t *pDest, parquet_file_t *pSrc);
+int parquet_magic(parquet_file_t *pFile, char **ppData);
+int parquet_footer(parquet_file_t *pFile, char **ppData);
+
+#endif /* PARQUET_H */
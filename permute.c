@@ -39,7 +39,9 @@
 #include <malloc.h>
 #endif
 #include <stdio.h>
+#include <stdint.h>
 #include "genrand.h"
+#include "permute.h"
 
 /*
 * Routine: MakePermutation(int nSize)
@@ -130,3 +132,132 @@ makeKeyPermutation(ds_key_t *nNumberSet, ds_key_t nSize, int nStream)
 	return(nNumberSet);
 }
 
+/*
+* Routine: permuteMix(uint64_t kValue)
+* Purpose: scramble the bits of a 64-bit value; used as the Feistel round 
+*	function and to derive the round keys
+* Algorithm: SplitMix64 finalizer
+* Data Structures:
+*
+* Params:
+* Returns:
+* Called By: newPermutation(), getPermutationKey()
+* Calls: 
+* Assumptions:
+* Side Effects:
+* TODO: None
+*/
+static uint64_t
+permuteMix(uint64_t kValue)
+{
+	kValue ^= kValue >> 30;
+	kValue *= 0xBF58476D1CE4E5B9ULL;
+	kValue ^= kValue >> 27;
+	kValue *= 0x94D049BB133111EBULL;
+	kValue ^= kValue >> 31;
+
+	return(kValue);
+}
+
+/*
+* Routine: newPermutation(ds_key_t nSize, int nStream, int bStateless)
+* Purpose: build a permutation of [1..nSize]
+* Algorithm: the legacy permutation is shuffled by makePermutation(), and
+*	draws from nStream as it always has. A stateless permutation only
+*	derives PERMUTE_ROUNDS round keys from the initial seed of nStream, so
+*	that it follows -RNGSEED, and sizes a balanced Feistel block that is 
+*	just wide enough to hold nSize values
+* Data Structures:
+*
+* Params: bStateless: use the Feistel network rather than an array
+* Returns: a permutation_t to be passed to getPermutationKey()
+* Called By: 
+* Calls: makePermutation()
+* Assumptions:
+* Side Effects: a stateless permutation does not advance nStream
+* TODO: None
+*/
+permutation_t *
+newPermutation(ds_key_t nSize, int nStream, int bStateless)
+{
+	permutation_t *pPermutation;
+	int i;
+	uint64_t kSeed;
+
+	if (nSize <= 0)
+		return(NULL);
+
+	pPermutation = (permutation_t *)malloc(sizeof(permutation_t));
+	MALLOC_CHECK(pPermutation);
+	memset(pPermutation, 0, sizeof(permutation_t));
+	pPermutation->nSize = nSize;
+
+	if (!bStateless)
+	{
+		pPermutation->pEntries = makePermutation(NULL, (int)nSize, nStream);
+		return(pPermutation);
+	}
+
+	/* 2 * nHalfBits must cover [0, nSize - 1] */
+	pPermutation->nHalfBits = 1;
+	while (((ds_key_t)1 << (2 * pPermutation->nHalfBits)) < nSize)
+		pPermutation->nHalfBits += 1;
+	pPermutation->kHalfMask = ((ds_key_t)1 << pPermutation->nHalfBits) - 1;
+
+	kSeed = permuteMix((uint64_t)Streams[nStream].nInitialSeed ^ ((uint64_t)nSize << 32));
+	for (i=0; i < PERMUTE_ROUNDS; i++)
+	{
+		kSeed = permuteMix(kSeed + 0x9E3779B97F4A7C15ULL);
+		pPermutation->kKey[i] = (ds_key_t)(kSeed >> 1);
+	}
+
+	return(pPermutation);
+}
+
+/*
+* Routine: getPermutationKey(permutation_t *pPermutation, ds_key_t nIndex)
+* Purpose: return the nIndex'th entry of a permutation, in O(1)
+* Algorithm: a stateless permutation runs nIndex - 1 through the Feistel
+*	network, which is a bijection over the 2 * nHalfBits bit block, and 
+*	walks the cycle until the result falls back inside [0, nSize - 1]. 
+*	The block is less than 4 * nSize, so fewer than 4 passes are expected.
+* Data Structures:
+*
+* Params: nIndex is 1-based, as for getPermutationEntry()
+* Returns: a value in [1..nSize]
+* Called By: 
+* Calls: permuteMix()
+* Assumptions: the permutation is read only, and may be shared between threads
+* Side Effects:
+* TODO: None
+*/
+ds_key_t
+getPermutationKey(permutation_t *pPermutation, ds_key_t nIndex)
+{
+	ds_key_t kValue,
+		kLeft,
+		kRight,
+		kTemp;
+	int i;
+
+	if (pPermutation->pEntries)
+		return(getPermutationEntry(pPermutation->pEntries, nIndex));
+
+	kValue = nIndex - 1;
+	do
+	{
+		kLeft = kValue >> pPermutation->nHalfBits;
+		kRight = kValue & pPermutation->kHalfMask;
+		for (i=0; i < PERMUTE_ROUNDS; i++)
+		{
+			kTemp = kLeft ^ 
+				((ds_key_t)permuteMix((uint64_t)(kRight ^ pPermutation->kKey[i])) & pPermutation->kHalfMask);
+			kLeft = kRight;
+			kRight = kTemp;
+		}
+		kValue = (kLeft << pPermutation->nHalfBits) | kRight;
+	} while (kValue >= pPermutation->nSize);
+
+	return(kValue + 1);
+}
+
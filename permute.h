@@ -33,7 +33,28 @@
  * Contributors:
  * Gradient Systems
  */ 
+#ifndef PERMUTE_H
+#define PERMUTE_H
+
 int *makePermutation(int *pNumberSet, int nSize, int nStream);
 ds_key_t *makeKeyPermutation(ds_key_t *pNumberSet, ds_key_t nSize, int nStream);
 #define getPermutationEntry(pPermutation, nIndex) 	(pPermutation[nIndex - 1] + 1)
 
+/*
+ * a permutation of [1..nSize] that is either shuffled into an array, as
+ * makePermutation() does, or computed on demand by a keyed Feistel network
+ * (-STATELESS), which needs no storage and no set up
+ */
+#define PERMUTE_ROUNDS	4
+typedef struct PERMUTATION_T {
+	ds_key_t nSize;
+	int *pEntries;	/* NULL for a stateless permutation */
+	int nHalfBits;	/* width of each half of the Feistel block */
+	ds_key_t kHalfMask;
+	ds_key_t kKey[PERMUTE_ROUNDS];
+} permutation_t;
+
+permutation_t *newPermutation(ds_key_t nSize, int nStream, int bStateless);
+ds_key_t getPermutationKey(permutation_t *pPermutation, ds_key_t nIndex);
+
+#endif /* PERMUTE_H */
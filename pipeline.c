@@ -0,0 +1,313 @@
+/* 
+ * Legal Notice 
+ * 
+ * This document and associated source code (the "Work") is a part of a 
+ * benchmark specification maintained by the TPC. 
+ * 
+ * The TPC reserves all right, title, and interest to the Work as provided 
+ * under U.S. and international laws, including without limitation all patent 
+ * and trademark rights therein. 
+ * 
+ * No Warranty 
+ * 
+ * 1.1 TO THE MAXIMUM EXTENT PERMITTED BY APPLICABLE LAW, THE INFORMATION 
+ *     CONTAINED HEREIN IS PROVIDED "AS IS" AND WITH ALL FAULTS, AND THE 
+ *     AUTHORS AND DEVELOPERS OF THE WORK HEREBY DISCLAIM ALL OTHER 
+ *     WARRANTIES AND CONDITIONS, EITHER EXPRESS, IMPLIED OR STATUTORY, 
+ *     INCLUDING, BUT NOT LIMITED TO, ANY (IF ANY) IMPLIED WARRANTIES, 
+ *     DUTIES OR CONDITIONS OF MERCHANTABILITY, OF FITNESS FOR A PARTICULAR 
+ *     PURPOSE, OF ACCURACY OR COMPLETENESS OF RESPONSES, OF RESULTS, OF 
+ *     WORKMANLIKE EFFORT, OF LACK OF VIRUSES, AND OF LACK OF NEGLIGENCE. 
+ *     ALSO, THERE IS NO WARRANTY OR CONDITION OF TITLE, QUIET ENJOYMENT, 
+ *     QUIET POSSESSION, CORRESPONDENCE TO DESCRIPTION OR NON-INFRINGEMENT 
+ *     WITH REGARD TO THE WORK. 
+ * 1.2 IN NO EVENT WILL ANY AUTHOR OR DEVELOPER OF THE WORK BE LIABLE TO 
+ *     ANY OTHER PARTY FOR ANY DAMAGES, INCLUDING BUT NOT LIMITED TO THE 
+ *     COST OF PROCURING SUBSTITUTE GOODS OR SERVICES, LOST PROFITS, LOSS 
+ *     OF USE, LOSS OF DATA, OR ANY INCIDENTAL, CONSEQUENTIAL, DIRECT, 
+ *     INDIRECT, OR SPECIAL DAMAGES WHETHER UNDER CONTRACT, TORT, WARRANTY,
+ *     OR OTHERWISE, ARISING IN ANY WAY OUT OF THIS OR ANY OTHER AGREEMENT 
+ *     RELATING TO THE WORK, WHETHER OR NOT SUCH AUTHOR OR DEVELOPER HAD 
+ *     ADVANCE NOTICE OF THE POSSIBILITY OF SUCH DAMAGES. 
+ * 
+ * Contributors:
+ * Gradient Systems
+ */ 
+#include "config.h"
+#include "porting.h"
+#include <stdio.h>
+#include <errno.h>
+#ifdef WIN32
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+#ifdef USE_STDLIB_H
+#include <stdlib.h>
+#else
+#include <malloc.h>
+#endif
+#include "pipeline.h"
+
+#ifdef USE_THREADS
+/*
+ * the generator owns nHead and the writer owns nTail; each only reads the
+ * other's counter, so a block changes hands without a lock. A side that 
+ * finds the ring full or empty raises its waiting flag under the mutex, 
+ * checks the counter again and sleeps; the other side only takes the mutex
+ * to signal when it sees the flag after moving its counter. The counters 
+ * and flags are sequentially consistent so that one side always sees the 
+ * other's flag or counter. The counters are free running; nHead - nTail is
+ * the number of blocks waiting to be written.
+ */
+struct PIPELINE_T {
+	int nFile;
+	char *arBlock[PIPELINE_BLOCKS];
+	int arBytes[PIPELINE_BLOCKS];
+	unsigned int nHead;	/* blocks handed to the writer */
+	unsigned int nTail;	/* blocks written */
+	int bDone;
+	int bWriterWaiting;	/* the writer is asleep, or about to be, on Data */
+	int bGeneratorWaiting;	/* the generator is asleep, or about to be, on Space */
+	pthread_t hThread;
+	pthread_mutex_t Lock;
+	pthread_cond_t Data;	/* the writer waits for a block */
+	pthread_cond_t Space;	/* the generator waits for a free block */
+};
+
+#define PIPE_LOAD(v)	__atomic_load_n(&(v), __ATOMIC_SEQ_CST)
+#define PIPE_STORE(v, n)	__atomic_store_n(&(v), (n), __ATOMIC_SEQ_CST)
+
+/*
+* Routine: pipeline_writer(void *pArg)
+* Purpose: write the blocks of a ring to its descriptor, in order
+* Algorithm:
+* Data Structures:
+*
+* Params:
+* Returns:
+* Called By: pipeline_open(), as a thread
+* Calls: 
+* Assumptions:
+* Side Effects: exits the program if a write fails, as print_flush() does
+* TODO: None
+*/
+static void *
+pipeline_writer(void *pArg)
+{
+	pipeline_t *pPipe = (pipeline_t *)pArg;
+	char *pData;
+	int nBytes,
+		nWritten;
+
+	for (;;)
+	{
+		if (PIPE_LOAD(pPipe->nHead) == pPipe->nTail)
+		{
+			pthread_mutex_lock(&pPipe->Lock);
+			PIPE_STORE(pPipe->bWriterWaiting, 1);
+			while ((PIPE_LOAD(pPipe->nHead) == pPipe->nTail) && !pPipe->bDone)
+				pthread_cond_wait(&pPipe->Data, &pPipe->Lock);
+			PIPE_STORE(pPipe->bWriterWaiting, 0);
+			pthread_mutex_unlock(&pPipe->Lock);
+			/* bDone is only set once the last block has been pushed */
+			if (PIPE_LOAD(pPipe->nHead) == pPipe->nTail)
+				break;
+		}
+
+		pData = pPipe->arBlock[pPipe->nTail % PIPELINE_BLOCKS];
+		nBytes = pPipe->arBytes[pPipe->nTail % PIPELINE_BLOCKS];
+		while (nBytes > 0)
+		{
+			nWritten = write(pPipe->nFile, pData, nBytes);
+			if (nWritten < 0 && errno == EINTR)
+				continue;
+			if (nWritten <= 0)
+			{
+				fprintf(stderr, "ERROR: Failed to write output\n");
+				exit(-1);
+			}
+			pData += nWritten;
+			nBytes -= nWritten;
+		}
+
+		PIPE_STORE(pPipe->nTail, pPipe->nTail + 1);
+		if (PIPE_LOAD(pPipe->bGeneratorWaiting))
+		{
+			pthread_mutex_lock(&pPipe->Lock);
+			pthread_cond_signal(&pPipe->Space);
+			pthread_mutex_unlock(&pPipe->Lock);
+		}
+	}
+
+	return(NULL);
+}
+
+/*
+* Routine: pipeline_open(int nFile, int nBlockSize)
+* Purpose: start a writer thread for a descriptor
+* Algorithm:
+* Data Structures:
+*
+* Params: nBlockSize: the size of each block in the ring
+* Returns: the ring; pipeline_block() gives the first block to fill
+* Called By: print_start()
+* Calls: 
+* Assumptions:
+* Side Effects:
+* TODO: None
+*/
+pipeline_t *
+pipeline_open(int nFile, int nBlockSize)
+{
+	pipeline_t *pPipe;
+	int i;
+
+	pPipe = (pipeline_t *)malloc(sizeof(pipeline_t));
+	MALLOC_CHECK(pPipe);
+	memset(pPipe, 0, sizeof(pipeline_t));
+	pPipe->nFile = nFile;
+	for (i=0; i < PIPELINE_BLOCKS; i++)
+	{
+		pPipe->arBlock[i] = (char *)malloc(nBlockSize);
+		MALLOC_CHECK(pPipe->arBlock[i]);
+	}
+	pthread_mutex_init(&pPipe->Lock, NULL);
+	pthread_cond_init(&pPipe->Data, NULL);
+	pthread_cond_init(&pPipe->Space, NULL);
+	if (pthread_create(&pPipe->hThread, NULL, pipeline_writer, pPipe))
+	{
+		INTERNAL("Failed to start writer thread");
+		exit(-1);
+	}
+
+	return(pPipe);
+}
+
+/*
+* Routine: pipeline_block(pipeline_t *pPipe)
+* Purpose: return the block that the generator is to fill
+* Algorithm:
+* Data Structures:
+*
+* Params:
+* Returns:
+* Called By: print_start()
+* Calls: 
+* Assumptions: only called by the thread that pushes to the ring
+* Side Effects:
+* TODO: None
+*/
+char *
+pipeline_block(pipeline_t *pPipe)
+{
+	return(pPipe->arBlock[pPipe->nHead % PIPELINE_BLOCKS]);
+}
+
+/*
+* Routine: pipeline_push(pipeline_t *pPipe, int nBytes)
+* Purpose: hand the block being filled to the writer thread
+* Algorithm: the block is published by advancing nHead, and the writer is 
+*	only signalled if it is waiting; the generator then only waits if every
+*	other block is still queued for the writer
+* Data Structures:
+*
+* Params: nBytes: the bytes used in the current block
+* Returns: the next block to fill
+* Called By: print_flush()
+* Calls: 
+* Assumptions: only called by the thread that opened the ring
+* Side Effects:
+* TODO: None
+*/
+char *
+pipeline_push(pipeline_t *pPipe, int nBytes)
+{
+	unsigned int nHead = pPipe->nHead;
+
+	pPipe->arBytes[nHead % PIPELINE_BLOCKS] = nBytes;
+	PIPE_STORE(pPipe->nHead, nHead + 1);
+	if (PIPE_LOAD(pPipe->bWriterWaiting))
+	{
+		pthread_mutex_lock(&pPipe->Lock);
+		pthread_cond_signal(&pPipe->Data);
+		pthread_mutex_unlock(&pPipe->Lock);
+	}
+
+	nHead += 1;
+	if (nHead - PIPE_LOAD(pPipe->nTail) >= PIPELINE_BLOCKS)
+	{
+		pthread_mutex_lock(&pPipe->Lock);
+		PIPE_STORE(pPipe->bGeneratorWaiting, 1);
+		while (nHead - PIPE_LOAD(pPipe->nTail) >= PIPELINE_BLOCKS)
+			pthread_cond_wait(&pPipe->Space, &pPipe->Lock);
+		PIPE_STORE(pPipe->bGeneratorWaiting, 0);
+		pthread_mutex_unlock(&pPipe->Lock);
+	}
+
+	return(pPipe->arBlock[nHead % PIPELINE_BLOCKS]);
+}
+
+/*
+* Routine: pipeline_close(pipeline_t *pPipe)
+* Purpose: wait for the writer thread to drain the ring, and free it
+* Algorithm:
+* Data Structures:
+*
+* Params:
+* Returns:
+* Called By: print_close()
+* Calls: 
+* Assumptions: the last block has been pushed
+* Side Effects:
+* TODO: None
+*/
+void
+pipeline_close(pipeline_t *pPipe)
+{
+	int i;
+
+	pthread_mutex_lock(&pPipe->Lock);
+	pPipe->bDone = 1;
+	pthread_cond_signal(&pPipe->Data);
+	pthread_mutex_unlock(&pPipe->Lock);
+	pthread_join(pPipe->hThread, NULL);
+
+	pthread_mutex_destroy(&pPipe->Lock);
+	pthread_cond_destroy(&pPipe->Data);
+	pthread_cond_destroy(&pPipe->Space);
+	for (i=0; i < PIPELINE_BLOCKS; i++)
+		free(pPipe->arBlock[i]);
+	free(pPipe);
+
+	return;
+}
+#else
+/*
+ * without threads -PIPELINE is ignored, and print_flush() writes each
+ * block itself
+ */
+pipeline_t *
+pipeline_open(int nFile, int nBlockSize)
+{
+	return(NULL);
+}
+
+char *
+pipeline_block(pipeline_t *pPipe)
+{
+	return(NULL);
+}
+
+char *
+pipeline_push(pipeline_t *pPipe, int nBytes)
+{
+	return(NULL);
+}
+
+void
+pipeline_close(pipeline_t *pPipe)
+{
+	return;
+}
+#endif /* USE_THREADS */
@@ -118,6 +118,32 @@ char *strdup(const char *);
 #define MAXINT INT_MAX
 #endif
 
+/*
+ * in-process parallelism (-THREADS) relies on per-thread copies of the
+ * generator state; THREAD marks those variables, and the LOCK macros guard
+ * the few structures that are built once and then shared between threads
+ */
+#ifdef USE_THREADS
+#include <pthread.h>
+#define THREAD __thread
+#define DECLARE_LOCK(l)	static pthread_mutex_t l = PTHREAD_MUTEX_INITIALIZER
+#define LOCK(l)	pthread_mutex_lock(&(l))
+#define UNLOCK(l)	pthread_mutex_unlock(&(l))
+#else
+#define DECLARE_LOCK(l)
+#define LOCK(l)
+#define UNLOCK(l)
+#endif
+#ifndef THREAD
+#define THREAD
+#endif
+#ifndef MIN_MULTI_THREAD_ROWS
+#define MIN_MULTI_THREAD_ROWS	5000
+#endif
+#ifndef CHUNKS_PER_THREAD
+#define CHUNKS_PER_THREAD	8	/* -THREADS: sub-ranges per thread for a date based table */
+#endif
+
 #define INTERNAL(m) {\
 fprintf(stderr, "ERROR: %s\n\tFile: %s\n\tLine: %d\n", \
 	m, __FILE__, __LINE__); \
@@ -66,7 +66,7 @@ static ds_limits_t	aPriceLimits[MAX_LIMIT] =
 };
 
 /*
-* Routine: set_pricing(int nTabId, ds_pricing_t *pPricing)
+* Routine: set_pricing(gen_ctx_t *pCtx, int nTabId, ds_pricing_t *pPricing)
 * Purpose: handle the various pricing calculations for the fact tables
 * Notes:
 *	the RNG usage is not kept in sync between sales pricing and returns pricing. If the calculations look wrong, it may 
@@ -81,52 +81,48 @@ static ds_limits_t	aPriceLimits[MAX_LIMIT] =
 * Side Effects:
 * TODO: None
 */
-void set_pricing(int nTabId, ds_pricing_t *pPricing)
+void set_pricing(gen_ctx_t *pCtx, int nTabId, ds_pricing_t *pPricing)
 {
-	static int nLastId = -1, 
-		init = 0,
-		nQuantityMax,
-		nQuantityMin = 1;
-	static decimal_t dQuantity, dMarkupMin, dDiscountMin, dWholesaleMin,
-		 dMarkupMax, dDiscountMax, dWholesaleMax, dCouponMin, dCouponMax,
-		 dZero, dOneHalf, d9pct, dOne, dTemp, dHundred;
-	decimal_t dMarkup, dCoupon, dShipping, dDiscount, dTemp2;
+	pricing_state_t *pS = &pCtx->Pricing;
+	decimal_t dMarkup, dCoupon, dShipping, dDiscount, dTemp2, dQuantity, dTemp;
 	int i,
 		nCashPct,
 		nCreditPct,
 		nCouponUsage;
 	
-	if (!init)
+	if (!pS->bInit)
 	{
-		strtodec(&dMarkupMin, "0.00");
-		strtodec(&dDiscountMin, "0.00");
-		strtodec(&dWholesaleMin, "1.00");
-		strtodec(&dCouponMin, "0.00");
-		strtodec(&dZero, "0.00");
-		strtodec(&dOneHalf, "0.50");
-		strtodec(&d9pct, "0.09");
-		strtodec(&dWholesaleMin, "1.00");
-		strtodec(&dHundred, "100.00");
-		strtodec(&dOne, "1.00");
+		pS->nLastId = -1;
+		pS->nQuantityMin = 1;
+		strtodec(&pS->dMarkupMin, "0.00");
+		strtodec(&pS->dDiscountMin, "0.00");
+		strtodec(&pS->dWholesaleMin, "1.00");
+		strtodec(&pS->dCouponMin, "0.00");
+		strtodec(&pS->dZero, "0.00");
+		strtodec(&pS->dOneHalf, "0.50");
+		strtodec(&pS->d9pct, "0.09");
+		strtodec(&pS->dWholesaleMin, "1.00");
+		strtodec(&pS->dHundred, "100.00");
+		strtodec(&pS->dOne, "1.00");
 
-		init = 1;
+		pS->bInit = 1;
 	}
 	
-	if (nTabId != nLastId)
+	if (nTabId != pS->nLastId)
 	{
-		nLastId = -1;
+		pS->nLastId = -1;
 		for (i=0; i < MAX_LIMIT; i++)
 		{
 			if (nTabId == aPriceLimits[i].nId)
-				nLastId = i;
+				pS->nLastId = i;
 		}
-		if (nLastId == -1)
+		if (pS->nLastId == -1)
 			INTERNAL("No pricing limits defined");
-		nQuantityMax = atoi(aPriceLimits[nLastId].szQuantity);
-		strtodec(&dDiscountMax, aPriceLimits[nLastId].szDiscount);
-		strtodec(&dMarkupMax, aPriceLimits[nLastId].szMarkUp);
-		strtodec(&dWholesaleMax, aPriceLimits[nLastId].szWholesale);
-		strtodec(&dCouponMax, aPriceLimits[nLastId].szCoupon);
+		pS->nQuantityMax = atoi(aPriceLimits[pS->nLastId].szQuantity);
+		strtodec(&pS->dDiscountMax, aPriceLimits[pS->nLastId].szDiscount);
+		strtodec(&pS->dMarkupMax, aPriceLimits[pS->nLastId].szMarkUp);
+		strtodec(&pS->dWholesaleMax, aPriceLimits[pS->nLastId].szWholesale);
+		strtodec(&pS->dCouponMax, aPriceLimits[pS->nLastId].szCoupon);
 	}
 
 	switch(nTabId)
@@ -137,22 +133,22 @@ void set_pricing(int nTabId, ds_pricing_t *pPricing)
 	case S_PLINE_PRICING:
 	case S_CLIN_PRICING:
 	case S_WLIN_PRICING:
-		genrand_integer(&pPricing->quantity, DIST_UNIFORM, nQuantityMin, nQuantityMax, 0, nTabId);
+		genrand_integer(&pPricing->quantity, DIST_UNIFORM, pS->nQuantityMin, pS->nQuantityMax, 0, nTabId);
 		itodec(&dQuantity, pPricing->quantity);
-		genrand_decimal(&pPricing->wholesale_cost, DIST_UNIFORM, &dWholesaleMin, &dWholesaleMax, NULL, nTabId);
+		genrand_decimal(&pPricing->wholesale_cost, DIST_UNIFORM, &pS->dWholesaleMin, &pS->dWholesaleMax, NULL, nTabId);
 
 		/* ext_wholesale_cost = wholesale_cost * quantity */
 		decimal_t_op(&pPricing->ext_wholesale_cost, OP_MULT, &dQuantity, &pPricing->wholesale_cost);
 		
 		/* list_price = wholesale_cost * (1 + markup) */
-		genrand_decimal(&dMarkup, DIST_UNIFORM, &dMarkupMin, &dMarkupMax, NULL, nTabId);
-		decimal_t_op(&dMarkup, OP_PLUS, &dMarkup, &dOne);
+		genrand_decimal(&dMarkup, DIST_UNIFORM, &pS->dMarkupMin, &pS->dMarkupMax, NULL, nTabId);
+		decimal_t_op(&dMarkup, OP_PLUS, &dMarkup, &pS->dOne);
 		decimal_t_op(&pPricing->list_price, OP_MULT, &pPricing->wholesale_cost, &dMarkup);
 		
 		/* sales_price = list_price * (1 - discount)*/
-		genrand_decimal(&dDiscount, DIST_UNIFORM, &dDiscountMin, &dDiscountMax, NULL, nTabId);
+		genrand_decimal(&dDiscount, DIST_UNIFORM, &pS->dDiscountMin, &pS->dDiscountMax, NULL, nTabId);
 		NegateDecimal(&dDiscount);
-		decimal_t_op(&pPricing->ext_discount_amt, OP_PLUS, &dDiscount, &dOne);
+		decimal_t_op(&pPricing->ext_discount_amt, OP_PLUS, &dDiscount, &pS->dOne);
 		decimal_t_op(&pPricing->sales_price, OP_MULT, &pPricing->list_price, &pPricing->ext_discount_amt);
 		
 		/* ext_list_price = list_price * quantity */
@@ -165,18 +161,18 @@ void set_pricing(int nTabId, ds_pricing_t *pPricing)
 		decimal_t_op(&pPricing->ext_discount_amt, OP_MINUS, &pPricing->ext_list_price, &pPricing->ext_sales_price);
 		
 		/* coupon_amt = ext_sales_price * coupon */
-		genrand_decimal(&dCoupon, DIST_UNIFORM, &dZero, &dOne, NULL, nTabId);
+		genrand_decimal(&dCoupon, DIST_UNIFORM, &pS->dZero, &pS->dOne, NULL, nTabId);
 		genrand_integer(&nCouponUsage, DIST_UNIFORM, 1, 100, 0, nTabId);
 		if (nCouponUsage <= 20)	/* 20% of sales employ a coupon */
 			decimal_t_op(&pPricing->coupon_amt, OP_MULT, &pPricing->ext_sales_price, &dCoupon);
 		else
-			memcpy(&pPricing->coupon_amt, &dZero, sizeof(decimal_t));
+			memcpy(&pPricing->coupon_amt, &pS->dZero, sizeof(decimal_t));
 		
 		/* net_paid = ext_sales_price - coupon_amt */
 		decimal_t_op(&pPricing->net_paid, OP_MINUS, &pPricing->ext_sales_price, &pPricing->coupon_amt);
 		
 		/* shipping_cost = list_price * shipping */
-		genrand_decimal(&dShipping, DIST_UNIFORM, &dZero, &dOneHalf, NULL, nTabId);
+		genrand_decimal(&dShipping, DIST_UNIFORM, &pS->dZero, &pS->dOneHalf, NULL, nTabId);
 		decimal_t_op(&pPricing->ship_cost, OP_MULT, &pPricing->list_price, &dShipping);
 
       /* ext_shipping_cost = shipping_cost * quantity */
@@ -186,7 +182,7 @@ void set_pricing(int nTabId, ds_pricing_t *pPricing)
 		decimal_t_op(&pPricing->net_paid_inc_ship, OP_PLUS, &pPricing->net_paid, &pPricing->ext_ship_cost);
 		
 		/* ext_tax = tax * net_paid */
-		genrand_decimal(&pPricing->tax_pct, DIST_UNIFORM, &dZero, &d9pct, NULL, nTabId);
+		genrand_decimal(&pPricing->tax_pct, DIST_UNIFORM, &pS->dZero, &pS->d9pct, NULL, nTabId);
 		decimal_t_op(&pPricing->ext_tax, OP_MULT, &pPricing->net_paid, &pPricing->tax_pct);
 		
 		/* net_paid_inc_tax = net_paid + ext_tax */
@@ -216,7 +212,7 @@ void set_pricing(int nTabId, ds_pricing_t *pPricing)
 		memcpy(&pPricing->net_paid, &pPricing->ext_sales_price, sizeof(decimal_t));
 		
 		/* shipping_cost = list_price * shipping */
-		genrand_decimal(&dShipping, DIST_UNIFORM, &dZero, &dOneHalf, NULL, nTabId);
+		genrand_decimal(&dShipping, DIST_UNIFORM, &pS->dZero, &pS->dOneHalf, NULL, nTabId);
 		decimal_t_op(&pPricing->ship_cost, OP_MULT, &pPricing->list_price, &dShipping);
 
       /* ext_shipping_cost = shipping_cost * quantity */
@@ -241,13 +237,13 @@ void set_pricing(int nTabId, ds_pricing_t *pPricing)
 		/* allocate some of return to cash */
 		genrand_integer(&nCashPct, DIST_UNIFORM, 0, 100, 0, nTabId);
 		itodec(&dTemp, nCashPct);
-		decimal_t_op(&pPricing->refunded_cash, OP_DIV, &dTemp, &dHundred);
+		decimal_t_op(&pPricing->refunded_cash, OP_DIV, &dTemp, &pS->dHundred);
 		decimal_t_op(&pPricing->refunded_cash, OP_MULT, &pPricing->refunded_cash, &pPricing->net_paid);
 		
 		/* allocate some to reversed charges */
 		genrand_integer(&nCreditPct, DIST_UNIFORM, 1, 100, 0, nTabId);
 		itodec(&dTemp2, nCreditPct);
-		decimal_t_op(&dTemp, OP_DIV, &dTemp2, &dHundred);
+		decimal_t_op(&dTemp, OP_DIV, &dTemp2, &pS->dHundred);
 		decimal_t_op(&dTemp2, OP_MINUS, &pPricing->net_paid, &pPricing->refunded_cash);
 		decimal_t_op(&pPricing->reversed_charge, OP_MULT, &dTemp2, &dTemp);
 		
@@ -256,7 +252,7 @@ void set_pricing(int nTabId, ds_pricing_t *pPricing)
 		decimal_t_op(&pPricing->store_credit, OP_MINUS, &pPricing->store_credit, &pPricing->refunded_cash);
 		
 		/* pick a fee for the return */
-		genrand_decimal(&pPricing->fee, DIST_UNIFORM, &dOneHalf, &dHundred, &dZero, nTabId);
+		genrand_decimal(&pPricing->fee, DIST_UNIFORM, &pS->dOneHalf, &pS->dHundred, &pS->dZero, nTabId);
 		
 		/* and calculate the net effect */
 		decimal_t_op(&pPricing->net_loss, OP_MINUS, &pPricing->net_paid_inc_ship_tax, &pPricing->store_credit);
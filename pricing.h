@@ -36,6 +36,7 @@
 #ifndef PRICING_H
 #define PRICING_H
 #include "decimal.h"
+#include "context.h"
 
 typedef struct DS_PRICING_T {
 	decimal_t wholesale_cost;
@@ -73,5 +74,5 @@ typedef struct DS_LIMITS_T
 	char *szCoupon;
 } ds_limits_t;
 
-void set_pricing(int nTabId, ds_pricing_t *pPricing);
+void set_pricing(gen_ctx_t *pCtx, int nTabId, ds_pricing_t *pPricing);
 #endif
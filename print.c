@@ -36,6 +36,7 @@
 #include "config.h"
 #include "porting.h"
 #include <stdio.h>
+#include <errno.h>
 #ifdef WIN32
 #include <io.h>
 #else
@@ -51,19 +52,380 @@
 #include "nulls.h"
 #include "constants.h"
 #include "build_support.h"
+#include "runtime.h"
+#include "stats.h"
+#include "arrow.h"
+#include "parquet.h"
+#include "load.h"
+#include "pipeline.h"
 
-static FILE *fpOutfile = NULL;
+static THREAD FILE *fpOutfile = NULL;
 static FILE *fpDeleteFile;
 static char *arDeleteFiles[3] = {"", "delete_", "inventory_delete_"};
+static THREAD int nSpoolChunk = 0;
+
+#define MERGE_BUFFER_SIZE	(1024 * 1024)
+
+/*
+ * rows are formatted into a per-table buffer that is handed to write() in
+ * large blocks, rather than going through stdio a column at a time
+ */
+#define OUTPUT_BUFFER_SIZE	(1024 * 1024)
+#define MAX_FIELD_WIDTH		64	/* longest key, decimal, date or time */
+typedef struct OUTBUF_T {
+	int nFile;	/* descriptor behind the table's outfile */
+	int nUsed;
+	char *pData;
+	arrow_batch_t *pBatch;	/* -FORMAT arrow or parquet: rows are collected here */
+	parquet_file_t *pParquet;	/* -FORMAT parquet */
+	load_table_t *pLoad;	/* -DBLOAD: rows are written as binary COPY */
+	pipeline_t *pPipe;	/* -PIPELINE: full buffers go to a writer thread */
+	struct OUTBUF_T *arShard;	/* -SHARDS: this buffer only holds the current row */
+	FILE *pFile;	/* -SHARDS: the file of a shard */
+	int nShardField;	/* -SHARDS: the field that picks the shard */
+	int nField;	/* -SHARDS: fields of the current row so far */
+	int nFieldStart;
+	unsigned int nHash;	/* -SHARDS: hash of the shard field */
+} outbuf_t;
+static THREAD outbuf_t arOutput[MAX_TABLE + 1];
+static THREAD outbuf_t *pOutput = NULL;
+static THREAD int bSpooling = 0;	/* a worker thread under -THREADS */
+static int arHeader[MAX_TABLE + 1];	/* Arrow schema or COPY header already in the output file */
+static parquet_file_t *arParquetSpool[MAX_TABLE + 1];	/* row groups in spool files */
+DECLARE_LOCK(ParquetLock);
+static THREAD ds_key_t kWritten = 0;	/* bytes flushed by this thread */
 
 int print_jdate (FILE *pFile, ds_key_t kValue);
+static int fmt_date (char *pDest, ds_key_t kValue);
+static void print_path(int tbl, char *path);
+
+#define SHARD_HASH_BASIS	2166136261U	/* FNV-1a */
+#define SHARD_HASH_PRIME	16777619U
+
+/*
+* Routine: print_flush(outbuf_t *pBuf)
+* Purpose: write out the contents of an output buffer
+* Algorithm: under -PIPELINE the buffer is handed to the writer thread and
+*	replaced by the next free block of the ring; the time spent waiting for
+*	that block is what counts as write time
+* Data Structures:
+*
+* Params:
+* Returns:
+* Called By: 
+* Calls: 
+* Assumptions:
+* Side Effects:
+* TODO: None
+*/
+static void
+print_flush(outbuf_t *pBuf)
+{
+	char *pData = pBuf->pData;
+	int nWritten;
+	ds_key_t kBytes = pBuf->nUsed,
+		kStart = 0;
+
+	if (g_Runtime.bStats)
+		kStart = stats_clock();
+	if (pBuf->pPipe)
+	{
+		if (pBuf->nUsed > 0)
+			pBuf->pData = pipeline_push(pBuf->pPipe, pBuf->nUsed);
+		pBuf->nUsed = 0;
+	}
+	while (pBuf->nUsed > 0)
+	{
+		nWritten = write(pBuf->nFile, pData, pBuf->nUsed);
+		if (nWritten < 0 && errno == EINTR)
+			continue;
+		if (nWritten <= 0)
+		{
+			fprintf(stderr, "ERROR: Failed to write output\n");
+			exit(-1);
+		}
+		pData += nWritten;
+		pBuf->nUsed -= nWritten;
+	}
+	kWritten += kBytes;
+	if (g_Runtime.bStats && kBytes)
+		stats_write(kBytes, stats_clock() - kStart);
+
+	return;
+}
+
+/*
+* Routine: print_written()
+* Purpose: report the number of bytes written so far by the calling thread
+* Algorithm:
+* Data Structures:
+*
+* Params:
+* Returns:
+* Called By: progress_flush()
+* Calls: 
+* Assumptions:
+* Side Effects:
+* TODO: None
+*/
+ds_key_t
+print_written(void)
+{
+	return(kWritten);
+}
+
+/*
+* Routine: print_reserve(int nBytes)
+* Purpose: make room for nBytes in the current output buffer
+* Algorithm:
+* Data Structures:
+*
+* Params:
+* Returns: the position to format into; the caller advances nUsed
+* Called By: 
+* Calls: 
+* Assumptions: nBytes <= OUTPUT_BUFFER_SIZE
+* Side Effects:
+* TODO: None
+*/
+static char *
+print_reserve(int nBytes)
+{
+	if (pOutput->nUsed + nBytes > OUTPUT_BUFFER_SIZE)
+		print_flush(pOutput);
+
+	return(pOutput->pData + pOutput->nUsed);
+}
+
+/*
+* Routine: print_bytes(char *pSrc, int nBytes)
+* Purpose: append raw bytes to the current output buffer
+* Algorithm: a block larger than the buffer is written directly, unless the
+*	buffer belongs to a ring, in which case it is copied through in pieces
+* Data Structures:
+*
+* Params:
+* Returns:
+* Called By: 
+* Calls: 
+* Assumptions:
+* Side Effects:
+* TODO: None
+*/
+static void
+print_bytes(char *pSrc, int nBytes)
+{
+	outbuf_t Direct;
+	int nPiece;
+
+	if (nBytes > OUTPUT_BUFFER_SIZE && !pOutput->pPipe)
+	{
+		print_flush(pOutput);
+		Direct.nFile = pOutput->nFile;
+		Direct.nUsed = nBytes;
+		Direct.pData = pSrc;
+		Direct.pPipe = NULL;
+		print_flush(&Direct);
+		return;
+	}
+
+	while (nBytes > 0)
+	{
+		nPiece = (nBytes > OUTPUT_BUFFER_SIZE)?OUTPUT_BUFFER_SIZE:nBytes;
+		memcpy(print_reserve(nPiece), pSrc, nPiece);
+		pOutput->nUsed += nPiece;
+		pSrc += nPiece;
+		nBytes -= nPiece;
+	}
+
+	return;
+}
+
+/*
+* Routine: print_batch(int bLast)
+* Purpose: encode the rows collected for the current table under -FORMAT 
+*	arrow or parquet
+* Algorithm: the Arrow schema goes out with the first batch. The end of 
+*	stream marker, or the Parquet footer, is added when the table is closed,
+*	unless the rows belong to a worker thread, in which case print_merge() 
+*	adds it once the spool files have been appended. A worker hands the 
+*	row group metadata of its Parquet spool file to print_merge() through 
+*	arParquetSpool.
+* Data Structures:
+*
+* Params: bLast: the table is being closed
+* Returns:
+* Called By: print_end(), print_close()
+* Calls: arrow_encode(), parquet_encode()
+* Assumptions:
+* Side Effects:
+* TODO: None
+*/
+static void
+print_batch(int bLast)
+{
+	char *pData;
+	int nBytes,
+		nTable = pOutput->pBatch->nTable;
+
+	if (pOutput->pParquet)
+	{
+		nBytes = parquet_encode(pOutput->pParquet, pOutput->pBatch, !nSpoolChunk, &pData);
+		print_bytes(pData, nBytes);
+		if (bLast)
+		{
+			if (bSpooling)
+			{
+				LOCK(ParquetLock);
+				pOutput->pParquet->pNext = arParquetSpool[nTable];
+				arParquetSpool[nTable] = pOutput->pParquet;
+				UNLOCK(ParquetLock);
+			}
+			else
+			{
+				nBytes = parquet_footer(pOutput->pParquet, &pData);
+				print_bytes(pData, nBytes);
+				parquet_free(pOutput->pParquet);
+			}
+			pOutput->pParquet = NULL;
+		}
+	}
+	else
+	{
+		nBytes = arrow_encode(pOutput->pBatch, &pData);
+		print_bytes(pData, nBytes);
+		if (!nSpoolChunk && pOutput->pBatch->bSchema)
+			arHeader[nTable] = 1;
+		if (bLast && !bSpooling && pOutput->pBatch->bSchema)
+		{
+			nBytes = arrow_eos(&pData);
+			print_bytes(pData, nBytes);
+		}
+	}
+	if (bLast)
+	{
+		arrow_free(pOutput->pBatch);
+		pOutput->pBatch = NULL;
+	}
+
+	return;
+}
+
+/*
+* Routine: fmt_key(char *pDest, ds_key_t kValue)
+* Purpose: format a signed integer in decimal; equivalent to HUGE_FORMAT
+* Algorithm:
+* Data Structures:
+*
+* Params:
+* Returns: the number of characters written
+* Called By: 
+* Calls: 
+* Assumptions: pDest has room for 20 characters
+* Side Effects:
+* TODO: None
+*/
+static int
+fmt_key(char *pDest, ds_key_t kValue)
+{
+	char szDigits[24],
+		*cp = szDigits + sizeof(szDigits);
+	int nDigit,
+		bNegative = (kValue < 0),
+		nLength;
+
+	/* work with negative remainders so that the most negative value is safe */
+	do
+	{
+		nDigit = (int)(kValue % 10);
+		*--cp = (char)('0' + ((nDigit < 0)?-nDigit:nDigit));
+		kValue /= 10;
+	} while (kValue);
+	if (bNegative)
+		*--cp = '-';
+
+	nLength = (int)(szDigits + sizeof(szDigits) - cp);
+	memcpy(pDest, cp, nLength);
+
+	return(nLength);
+}
+
+/*
+* Routine: fmt_2digit(char *pDest, int nValue)
+* Purpose: format a value in [0, 99] as two digits; equivalent to "%02d"
+* Algorithm:
+* Data Structures:
+*
+* Params:
+* Returns:
+* Called By: 
+* Calls: 
+* Assumptions:
+* Side Effects:
+* TODO: None
+*/
+static void
+fmt_2digit(char *pDest, int nValue)
+{
+	pDest[0] = (char)('0' + nValue / 10);
+	pDest[1] = (char)('0' + nValue % 10);
+
+	return;
+}
 
 void 
 print_close(int tbl)
 {
    tdef *pTdef = getSimpleTdefsByNumber(tbl);
+	char *pData;
+	int nBytes,
+		i;
 
 	fpOutfile = NULL;
+	pOutput = NULL;
+	if (arOutput[tbl].pData)
+	{
+		if (arOutput[tbl].pBatch)
+		{
+			pOutput = &arOutput[tbl];
+			print_batch(1);
+			pOutput = NULL;
+		}
+		if (arOutput[tbl].pLoad)
+		{
+			pOutput = &arOutput[tbl];
+			if (!bSpooling)
+			{
+				nBytes = load_trailer(&pData);
+				print_bytes(pData, nBytes);
+			}
+			load_free(pOutput->pLoad);
+			pOutput->pLoad = NULL;
+			pOutput = NULL;
+		}
+		print_flush(&arOutput[tbl]);
+		if (arOutput[tbl].arShard)
+		{
+			/* the first shard is closed as the table's output file */
+			for (i=0; i < g_Runtime.nShards; i++)
+			{
+				print_flush(&arOutput[tbl].arShard[i]);
+				free(arOutput[tbl].arShard[i].pData);
+				if (i)
+					fclose(arOutput[tbl].arShard[i].pFile);
+			}
+			free(arOutput[tbl].arShard);
+			arOutput[tbl].arShard = NULL;
+		}
+		if (arOutput[tbl].pPipe)
+		{
+			pipeline_close(arOutput[tbl].pPipe);
+			arOutput[tbl].pPipe = NULL;
+		}
+		else
+			free(arOutput[tbl].pData);
+		arOutput[tbl].pData = NULL;
+	}
 	if (pTdef->outfile && pTdef->outfile != stdout)
 	{
 		fclose(pTdef->outfile);
@@ -76,30 +438,178 @@ print_close(int tbl)
 	return;
 }
 
+/*
+* Routine: shard_hash(char *pData, int nLength)
+* Purpose: hash the text of a field for -SHARDS
+* Algorithm: FNV-1a over the field as it is printed, so that a foreign key
+*	and the key it refers to land in the same shard
+* Data Structures:
+*
+* Params:
+* Returns:
+* Called By: print_separator(), print_shards()
+* Calls: 
+* Assumptions:
+* Side Effects:
+* TODO: None
+*/
+static unsigned int
+shard_hash(char *pData, int nLength)
+{
+	unsigned int nHash = SHARD_HASH_BASIS;
+
+	while (nLength-- > 0)
+	{
+		nHash ^= (unsigned char)*pData++;
+		nHash *= SHARD_HASH_PRIME;
+	}
+
+	return(nHash);
+}
+
+/*
+* Routine: shard_field(int tbl)
+* Purpose: find the field of a table named by -SHARDKEY
+* Algorithm: -SHARDKEY is a comma separated list of column names from the
+*	DDL, at most one per table
+* Data Structures:
+*
+* Params:
+* Returns: the position of the column, or 0, the first column, if no 
+*	column of the table is listed
+* Called By: print_shards()
+* Calls: arrow_new()
+* Assumptions:
+* Side Effects:
+* TODO: None
+*/
+static int
+shard_field(int tbl)
+{
+	arrow_batch_t *pBatch;
+	char *szList = get_str("SHARDKEY"),
+		*cp;
+	int i,
+		nLength,
+		nField = 0;
+
+	pBatch = arrow_new(tbl, 1);
+	while (*szList)
+	{
+		if ((cp = strchr(szList, ',')) == NULL)
+			cp = szList + strlen(szList);
+		nLength = (int)(cp - szList);
+		for (i=0; i < pBatch->nNamed; i++)
+			if (((int)strlen(pBatch->arColumns[i].szName) == nLength) && 
+				!strncasecmp(pBatch->arColumns[i].szName, szList, nLength))
+				nField = i;
+		szList = (*cp)?cp + 1:cp;
+	}
+	arrow_free(pBatch);
+
+	return(nField);
+}
+
+/*
+* Routine: print_shards(int tbl)
+* Purpose: open the -SHARDS files of a table
+* Algorithm: shard k of n is written to <table>_shard_<k>_<n><suffix>
+* Data Structures:
+*
+* Params:
+* Returns: the file of the first shard, which stands in for the table's 
+*	output file, and is closed with it
+* Called By: print_start()
+* Calls: 
+* Assumptions:
+* Side Effects:
+* TODO: None
+*/
+static FILE *
+print_shards(int tbl)
+{
+	outbuf_t *pShard;
+	char path[256];
+	int i,
+		nBase;
+
+	arOutput[tbl].arShard = (outbuf_t *)malloc(g_Runtime.nShards * sizeof(outbuf_t));
+	MALLOC_CHECK(arOutput[tbl].arShard);
+	memset(arOutput[tbl].arShard, 0, g_Runtime.nShards * sizeof(outbuf_t));
+	arOutput[tbl].nShardField = shard_field(tbl);
+	for (i=0; i < g_Runtime.nShards; i++)
+	{
+		pShard = &arOutput[tbl].arShard[i];
+		print_path(tbl, path);
+		nBase = (int)(strlen(path) - strlen(get_str("SUFFIX")));
+		sprintf(path + nBase, "_shard_%d_%d%s", i + 1, g_Runtime.nShards, get_str("SUFFIX"));
+		if ((access (path, F_OK) != -1) && !is_set ("FORCE"))
+		{
+			fprintf (stderr,
+				"ERROR: %s exists. Either remove it or use the FORCE option to overwrite it.\n",
+				path);
+			exit (-1);
+		}
+		if ((pShard->pFile = fopen(path, "w")) == NULL)
+		{
+			INTERNAL ("Failed to open output file!");
+			exit(-1);
+		}
+		pShard->nFile = fileno(pShard->pFile);
+		pShard->pData = (char *)malloc(OUTPUT_BUFFER_SIZE);
+		MALLOC_CHECK(pShard->pData);
+	}
+	arOutput[tbl].nHash = shard_hash(NULL, 0);
+
+	return(arOutput[tbl].arShard[0].pFile);
+}
+
+/*
+* Routine: print_shard_row()
+* Purpose: move the row just printed to the buffer of its shard
+* Algorithm:
+* Data Structures:
+*
+* Params:
+* Returns:
+* Called By: print_end()
+* Calls: 
+* Assumptions:
+* Side Effects:
+* TODO: None
+*/
+static void
+print_shard_row(void)
+{
+	outbuf_t *pShard = &pOutput->arShard[pOutput->nHash % g_Runtime.nShards];
+
+	if (pShard->nUsed + pOutput->nUsed > OUTPUT_BUFFER_SIZE)
+		print_flush(pShard);
+	memcpy(pShard->pData + pShard->nUsed, pOutput->pData, pOutput->nUsed);
+	pShard->nUsed += pOutput->nUsed;
+
+	pOutput->nUsed = 0;
+	pOutput->nField = 0;
+	pOutput->nFieldStart = 0;
+	pOutput->nHash = shard_hash(NULL, 0);
+
+	return;
+}
+
 int
 print_separator (int sep)
 {
 	int res = 0;
-	static char *pDelimiter;
-	static int init = 0;
 	
 	if (!fpOutfile)
 		return 0;
-		
-	if (!init)
-	{
-        pDelimiter = get_str ("DELIMITER");
-        init = 1;
-	}
 	
+	if (pOutput->arShard && (pOutput->nField++ == pOutput->nShardField))
+		pOutput->nHash = shard_hash(pOutput->pData + pOutput->nFieldStart, 
+			pOutput->nUsed - pOutput->nFieldStart);
 	if (sep)
-	{
-		if (fwrite(pDelimiter, 1, 1, fpOutfile) != 1)
-		{
-			fprintf(stderr, "ERROR: Failed to write delimiter\n");
-			exit(-1);
-		}
-	}
+		print_bytes(g_Runtime.szDelimiter, 1);
+	pOutput->nFieldStart = pOutput->nUsed;
 	   
 	return (res);
 }
@@ -144,17 +654,21 @@ print_integer (int nColumn, int val, int sep)
 {
 	if (!fpOutfile)
 		return;
-		
-	if (!nullCheck(nColumn))
+	if (pOutput->pBatch)
 	{
-		if (fprintf (fpOutfile, "%d", val) < 0)
-		{
-			fprintf(stderr, "ERROR: Failed to write output for column %d\n", nColumn);
-			exit(-1);
-		}
+		arrow_integer(pOutput->pBatch, ARROW_INT32, (ds_key_t)val, nullCheck(nColumn));
+		return;
 	}
+	if (pOutput->pLoad)
+	{
+		load_integer(pOutput->pLoad, ARROW_INT32, (ds_key_t)val, nullCheck(nColumn));
+		return;
+	}
+		
+	if (!nullCheck(nColumn))
+		pOutput->nUsed += fmt_key(print_reserve(MAX_FIELD_WIDTH), (ds_key_t)val);
 #ifdef _MYSQL
-		else fwrite("NULL", 1, 4, fpOutfile);
+		else print_bytes("NULL", 4);
 #endif
 	print_separator (sep);
 	
@@ -169,24 +683,30 @@ print_varchar (int nColumn, char *val, int sep)
 		
 	size_t nLength;
 
+	if (pOutput->pBatch)
+	{
+		arrow_string(pOutput->pBatch, val, (val)?(int)strlen(val):0, nullCheck(nColumn) || (val == NULL));
+		return;
+	}
+	if (pOutput->pLoad)
+	{
+		load_string(pOutput->pLoad, val, (val)?(int)strlen(val):0, nullCheck(nColumn) || (val == NULL));
+		return;
+	}
 	if (!nullCheck(nColumn) && (val != NULL))
 	{
       nLength = strlen(val);
 		
 #ifdef STR_QUOTES
-		if ((fwrite ("\"", 1, 1, fpOutfile) != 1) ||
-			(fwrite (val, 1, nLength, fpOutfile) != nLength) ||
-			(fwrite ("\"", 1, 1, fpOutfile)) != 1)
+		print_bytes("\"", 1);
+		print_bytes(val, (int)nLength);
+		print_bytes("\"", 1);
 #else
-		if (fwrite (val, 1, nLength, fpOutfile) != nLength)
+		print_bytes(val, (int)nLength);
 #endif
-			{
-				fprintf(stderr, "ERROR: Failed to write output for column %d\n", nColumn);
-				exit(-1);
-			}
 	}
 #ifdef _MYSQL
-		else fwrite("NULL", 1, 4, fpOutfile);
+		else print_bytes("NULL", 4);
 #endif
 	print_separator (sep);
 	
@@ -244,17 +764,21 @@ print_char (int nColumn, char val, int sep)
 {
 	if (!fpOutfile)
 		return;
-		
-	if (!nullCheck(nColumn))
+	if (pOutput->pBatch)
 	{
-		if (fwrite (&val, 1, 1, fpOutfile) != 1)
-		{
-			fprintf(stderr, "ERROR: Failed to write output for column %d\n", nColumn);
-			exit(-1);
-		}
+		arrow_string(pOutput->pBatch, &val, 1, nullCheck(nColumn));
+		return;
+	}
+	if (pOutput->pLoad)
+	{
+		load_string(pOutput->pLoad, &val, 1, nullCheck(nColumn));
+		return;
 	}
+		
+	if (!nullCheck(nColumn))
+		print_bytes(&val, 1);
 #ifdef _MYSQL
-		else fwrite("NULL", 1, 4, fpOutfile);
+		else print_bytes("NULL", 4);
 #endif
 	print_separator (sep);
 
@@ -266,25 +790,28 @@ print_date (int nColumn, ds_key_t val, int sep)
 {
 	if (!fpOutfile)
 		return;
+	if (pOutput->pBatch)
+	{
+		arrow_integer(pOutput->pBatch, ARROW_DATE32, val, nullCheck(nColumn) || (val <= 0));
+		return;
+	}
+	if (pOutput->pLoad)
+	{
+		load_integer(pOutput->pLoad, ARROW_DATE32, val, nullCheck(nColumn) || (val <= 0));
+		return;
+	}
 		
 	if (!nullCheck(nColumn))
 	{
 		if (val > 0)
-		{
-			if (print_jdate(fpOutfile, val))
-			{
-				fprintf(stderr, "ERROR: Failed to write output for column %d\n", nColumn);
-				exit(-1);
-			}
-			
-		}
+			pOutput->nUsed += fmt_date(print_reserve(MAX_FIELD_WIDTH), val);
 #ifdef _MYSQL
-		else fwrite("NULL", 1, 4, fpOutfile);
+		else print_bytes("NULL", 4);
 #endif
 	}
 	
 #ifdef _MYSQL
-		else fwrite("NULL", 1, 4, fpOutfile);
+		else print_bytes("NULL", 4);
 #endif
 	print_separator (sep);
 	   
@@ -298,6 +825,18 @@ print_time (int nColumn, ds_key_t val, int sep)
 		return;
 		
 	int nHours, nMinutes, nSeconds;
+	char *cp;
+
+	if (pOutput->pBatch)
+	{
+		arrow_integer(pOutput->pBatch, ARROW_TIME32, val, nullCheck(nColumn) || (val < 0));
+		return;
+	}
+	if (pOutput->pLoad)
+	{
+		load_integer(pOutput->pLoad, ARROW_TIME32, val, nullCheck(nColumn) || (val < 0));
+		return;
+	}
 
 	nHours = (int)(val / 3600);
 	val -= 3600 * nHours;
@@ -309,14 +848,25 @@ print_time (int nColumn, ds_key_t val, int sep)
 	{
 		if (val != -1)
 		{
-			fprintf(fpOutfile, "%02d:%02d:%02d", nHours, nMinutes, nSeconds);
+			cp = print_reserve(MAX_FIELD_WIDTH);
+			if ((nHours | nMinutes | nSeconds) >= 0 && nHours < 100)
+			{
+				fmt_2digit(cp, nHours);
+				cp[2] = ':';
+				fmt_2digit(cp + 3, nMinutes);
+				cp[5] = ':';
+				fmt_2digit(cp + 6, nSeconds);
+				pOutput->nUsed += 8;
+			}
+			else
+				pOutput->nUsed += sprintf(cp, "%02d:%02d:%02d", nHours, nMinutes, nSeconds);
 		}
 #ifdef _MYSQL
-		else fwrite("NULL", 1, 4, fpOutfile);
+		else print_bytes("NULL", 4);
 #endif
 	}
 #ifdef _MYSQL
-		else fwrite("NULL", 1, 4, fpOutfile);
+		else print_bytes("NULL", 4);
 #endif
 	
 	print_separator (sep);
@@ -329,30 +879,21 @@ print_decimal (int nColumn, decimal_t * val, int sep)
 {
 	if (!fpOutfile)
 		return;
-		
-	int i;
-	double dTemp;
-
-	if (!nullCheck(nColumn))
+	if (pOutput->pBatch)
 	{
-#ifdef WIN32
-#pragma warning(disable: 4244)
-#endif
-	dTemp = val->number;
-#ifdef WIN32
-#pragma warning(default: 4244)
-#endif
-		for (i=0; i < val->precision; i++)
-			dTemp /= 10.0;
-
-		if (fprintf(fpOutfile, "%.*f", val->precision, dTemp) < 0)
-		{
-			fprintf(stderr, "ERROR: Failed to write output for column %d\n", nColumn);
-			exit(-1);
-		}
+		arrow_decimal(pOutput->pBatch, val, nullCheck(nColumn));
+		return;
+	}
+	if (pOutput->pLoad)
+	{
+		load_decimal(pOutput->pLoad, val, nullCheck(nColumn));
+		return;
 	}
+		
+	if (!nullCheck(nColumn))
+		pOutput->nUsed += dectoa(print_reserve(MAX_FIELD_WIDTH), val);
 #ifdef _MYSQL
-		else fwrite("NULL", 1, 4, fpOutfile);
+		else print_bytes("NULL", 4);
 #endif
 	print_separator (sep);
 	
@@ -364,23 +905,27 @@ print_key (int nColumn, ds_key_t val, int sep)
 {
 	if (!fpOutfile)
 		return;
+	if (pOutput->pBatch)
+	{
+		arrow_integer(pOutput->pBatch, ARROW_INT64, val, nullCheck(nColumn) || (val == (ds_key_t)-1));
+		return;
+	}
+	if (pOutput->pLoad)
+	{
+		load_integer(pOutput->pLoad, ARROW_INT64, val, nullCheck(nColumn) || (val == (ds_key_t)-1));
+		return;
+	}
 		
 	if (!nullCheck(nColumn))
 	{
 		if (val != (ds_key_t) -1) /* -1 is a special value, indicating NULL */
-		{
-			if (fprintf (fpOutfile, HUGE_FORMAT, val) < 0)
-			{
-				fprintf(stderr, "ERROR: Failed to write output for column %d\n", nColumn);
-				exit(-1);
-			}
-		}
+			pOutput->nUsed += fmt_key(print_reserve(MAX_FIELD_WIDTH), val);
 #ifdef _MYSQL
-		else fwrite("NULL", 1, 4, fpOutfile);
+		else print_bytes("NULL", 4);
 #endif
 	}
 #ifdef _MYSQL
-		else fwrite("NULL", 1, 4, fpOutfile);
+		else print_bytes("NULL", 4);
 #endif
 	print_separator (sep);
 	
@@ -395,29 +940,39 @@ print_id (int nColumn, ds_key_t val, int sep)
       
    char szID[RS_BKEY + 1];
    
+   if (pOutput->pBatch)
+   {
+      if (val != (ds_key_t) -1)
+         mk_bkey(szID, val, 0);
+      arrow_string(pOutput->pBatch, szID, RS_BKEY, nullCheck(nColumn) || (val == (ds_key_t)-1));
+      return;
+   }
+   if (pOutput->pLoad)
+   {
+      if (val != (ds_key_t) -1)
+         mk_bkey(szID, val, 0);
+      load_string(pOutput->pLoad, szID, RS_BKEY, nullCheck(nColumn) || (val == (ds_key_t)-1));
+      return;
+   }
    if (!nullCheck(nColumn))
    {
       if (val != (ds_key_t) -1) /* -1 is a special value, indicating NULL */
       {
          mk_bkey(szID, val, 0);
 #ifdef STR_QUOTES
-         if ((fwrite ("\"", 1, 1, fpOutfile) < 1) ||
-            (fwrite (szID, 1, RS_BKEY, fpOutfile) < RS_BKEY) ||
-			(fwrite ("\"", 1, 1, fpOutfile) < 1))
+         print_bytes("\"", 1);
+         print_bytes(szID, RS_BKEY);
+         print_bytes("\"", 1);
 #else
-            if (fwrite (szID, 1, RS_BKEY, fpOutfile) < RS_BKEY)
+         print_bytes(szID, RS_BKEY);
 #endif
-            {
-               fprintf(stderr, "ERROR: Failed to write output for column %d\n", nColumn);
-               exit(-1);
-            }
       }
 #ifdef _MYSQL
-		else fwrite("NULL", 1, 4, fpOutfile);
+		else print_bytes("NULL", 4);
 #endif
    }
  #ifdef _MYSQL
-		else fwrite("NULL", 1, 4, fpOutfile);
+		else print_bytes("NULL", 4);
 #endif
   print_separator (sep);
    
@@ -429,22 +984,28 @@ print_boolean (int nColumn, int val, int sep)
 {
 	if (!fpOutfile)
 		return;
+	if (pOutput->pBatch)
+	{
+		arrow_string(pOutput->pBatch, (val)?"Y":"N", 1, nullCheck(nColumn));
+		return;
+	}
+	if (pOutput->pLoad)
+	{
+		load_string(pOutput->pLoad, (val)?"Y":"N", 1, nullCheck(nColumn));
+		return;
+	}
 		
 	if (!nullCheck(nColumn))
 	{
 
 #ifdef STR_QUOTES
-		if (fwrite ((val?"\"Y\"":"\"N\""), 1, 3, fpOutfile) != 3)
+		print_bytes((val?"\"Y\"":"\"N\""), 3);
 #else
-		if (fwrite ( ((val)?"Y":"N"), 1, 1, fpOutfile) != 1)
+		print_bytes(((val)?"Y":"N"), 1);
 #endif
-		{
-			fprintf(stderr, "ERROR: Failed to write output for column %d\n", nColumn);
-			exit(-1);
-		}
 	}
 #ifdef _MYSQL
-		else fwrite("NULL", 1, 4, fpOutfile);
+		else print_bytes("NULL", 4);
 #endif
 
 	print_separator (sep);
@@ -452,6 +1013,285 @@ print_boolean (int nColumn, int val, int sep)
 	return;
 }
 
+/*
+* Routine: print_path(int tbl, char *path)
+* Purpose: build the name of the output file for a given table
+* Algorithm:
+* Data Structures:
+*
+* Params:
+* Returns:
+* Called By: print_start(), print_merge()
+* Calls: 
+* Assumptions: path has room for at least 256 characters
+* Side Effects:
+* TODO: None
+*/
+static void
+print_path(int tbl, char *path)
+{
+	if (is_set("PARALLEL"))
+		sprintf (path, "%s%c%s_%d_%d%s",
+		get_str ("DIR"),
+		PATH_SEP, getTableNameByID (tbl), 
+		get_int("CHILD"), get_int("PARALLEL"), (is_set("VALIDATE"))?get_str ("VSUFFIX"):get_str ("SUFFIX"));
+	else 
+	{
+		if (is_set("UPDATE"))
+			sprintf (path, "%s%c%s_%d%s",
+			get_str ("DIR"),
+			PATH_SEP, getTableNameByID (tbl), get_int("UPDATE"), (is_set("VALIDATE"))?get_str ("VSUFFIX"):get_str ("SUFFIX"));
+		else
+			sprintf (path, "%s%c%s%s",
+			get_str ("DIR"),
+			PATH_SEP, getTableNameByID (tbl), (is_set("VALIDATE"))?get_str ("VSUFFIX"):get_str ("SUFFIX"));
+	}
+
+	return;
+}
+
+/*
+* Routine: print_spool(int nChunk)
+* Purpose: send the output of the calling thread to a numbered spool file
+* Algorithm:
+* Data Structures:
+*
+* Params: nChunk of 0 writes to the normal output file; -1 stops spooling, 
+*	for a table that is built as a single chunk
+* Returns:
+* Called By: gen_chunk()
+* Calls: 
+* Assumptions:
+* Side Effects:
+* TODO: None
+*/
+void
+print_spool(int nChunk)
+{
+	bSpooling = (nChunk >= 0);
+	nSpoolChunk = (bSpooling)?nChunk:0;
+
+	return;
+}
+
+/*
+* Routine: print_merge_open(char *path)
+* Purpose: open the output of a table for print_merge()
+* Algorithm:
+* Data Structures:
+*
+* Params:
+* Returns:
+* Called By: print_merge()
+* Calls: 
+* Assumptions:
+* Side Effects:
+* TODO: None
+*/
+static FILE *
+print_merge_open(char *path)
+{
+	FILE *pDest;
+
+	if (is_set ("_FILTER") || is_set ("STDOUT"))
+		pDest = stdout;
+	else if ((pDest = fopen(path, "ab")) == NULL)
+	{
+		INTERNAL ("Failed to open output file!");
+		exit(-1);
+	}
+
+	return(pDest);
+}
+
+/*
+* Routine: print_merge_write(FILE *pDest, char *pData, size_t nBytes, int tbl)
+* Purpose: add bytes of print_merge()'s own to the output of a table
+* Algorithm:
+* Data Structures:
+*
+* Params:
+* Returns:
+* Called By: print_merge()
+* Calls: 
+* Assumptions:
+* Side Effects:
+* TODO: None
+*/
+static void
+print_merge_write(FILE *pDest, char *pData, size_t nBytes, int tbl)
+{
+	if (fwrite(pData, 1, nBytes, pDest) != nBytes)
+	{
+		fprintf(stderr, "ERROR: Failed to write output for %s\n", getTableNameByID(tbl));
+		exit(-1);
+	}
+
+	return;
+}
+
+/*
+* Routine: print_merge_parquet(int tbl, int nChunk)
+* Purpose: claim the row group metadata that a worker left for print_merge()
+* Algorithm:
+* Data Structures:
+*
+* Params:
+* Returns: the metadata, or NULL if the chunk had no rows for the table
+* Called By: print_merge()
+* Calls: 
+* Assumptions:
+* Side Effects:
+* TODO: None
+*/
+static parquet_file_t *
+print_merge_parquet(int tbl, int nChunk)
+{
+	parquet_file_t **ppFile,
+		*pFile = NULL;
+
+	LOCK(ParquetLock);
+	for (ppFile = &arParquetSpool[tbl]; *ppFile; ppFile = &(*ppFile)->pNext)
+		if ((*ppFile)->nChunk == nChunk)
+		{
+			pFile = *ppFile;
+			*ppFile = pFile->pNext;
+			break;
+		}
+	UNLOCK(ParquetLock);
+
+	return(pFile);
+}
+
+/*
+* Routine: print_merge(int tbl, int nChunks)
+* Purpose: append the spool files written by worker threads to the output for a table
+* Algorithm: spool files are appended in chunk order and then removed, so the
+*	result is the same as a single threaded run. Under -FORMAT arrow each 
+*	spool file starts with its own schema message, which is dropped if the
+*	output already has one, and the end of stream marker is added last. 
+*	Under -DBLOAD only the output carries the COPY header, and the 
+*	trailer is added last. Under -FORMAT parquet the spool files hold bare
+*	row groups; their 
+*	metadata is moved to the offset where each one lands, and the footer is
+*	added last.
+* Data Structures:
+*
+* Params:
+* Returns:
+* Called By: gen_tbl()
+* Calls: 
+* Assumptions: all of the worker threads have finished
+* Side Effects:
+* TODO: None
+*/
+int
+print_merge(int tbl, int nChunks)
+{
+	char path[256],
+		spool[280],
+		*pBuffer,
+		*pData;
+	int i,
+		bHeader = arHeader[tbl];
+	size_t nBytes;
+	ds_key_t kStart = 0;
+	FILE *pSpool,
+		*pDest = NULL;
+	unsigned char *pLength;
+	parquet_file_t *pParquet = NULL,
+		*pChunk;
+
+	print_path(tbl, path);
+	pBuffer = (char *)malloc(MERGE_BUFFER_SIZE);
+	MALLOC_CHECK(pBuffer);
+
+	/* the first chunk went straight to the output file */
+	if ((g_Runtime.nFormat == FORMAT_PARQUET) && ((pParquet = print_merge_parquet(tbl, 0)) == NULL))
+		pParquet = parquet_new(tbl, 0);
+
+	for (i=1; i < nChunks; i++)
+	{
+		sprintf(spool, "%s.%d", path, i);
+		if ((pSpool = fopen(spool, "rb")) == NULL)
+			continue;	/* this chunk produced no rows for the table */
+
+		if (pDest == NULL)
+			pDest = print_merge_open(path);
+
+		if (g_Runtime.nFormat == FORMAT_ARROW)
+		{
+			/* skip the continuation marker, the metadata length and the metadata */
+			if (bHeader && (fread(pBuffer, 1, 8, pSpool) == 8))
+			{
+				pLength = (unsigned char *)pBuffer + 4;
+				fseek(pSpool, pLength[0] | (pLength[1] << 8) | (pLength[2] << 16) | ((long)pLength[3] << 24), SEEK_CUR);
+			}
+			bHeader = 1;
+		}
+		else if ((g_Runtime.nFormat == FORMAT_PGCOPY) && !bHeader)
+		{
+			nBytes = load_header(&pData);
+			print_merge_write(pDest, pData, nBytes, tbl);
+			bHeader = 1;
+		}
+		else if (g_Runtime.nFormat == FORMAT_PARQUET)
+		{
+			if (pParquet->kOffset == 0)
+			{
+				nBytes = parquet_magic(pParquet, &pData);
+				print_merge_write(pDest, pData, nBytes, tbl);
+			}
+			if ((pChunk = print_merge_parquet(tbl, i)) != NULL)
+			{
+				parquet_append(pParquet, pChunk);
+				parquet_free(pChunk);
+			}
+		}
+
+		while ((nBytes = fread(pBuffer, 1, MERGE_BUFFER_SIZE, pSpool)) > 0)
+		{
+			if (g_Runtime.bStats)
+				kStart = stats_clock();
+			print_merge_write(pDest, pBuffer, nBytes, tbl);
+			if (g_Runtime.bStats)
+				stats_write(nBytes, stats_clock() - kStart);
+		}
+		fclose(pSpool);
+		unlink(spool);
+	}
+
+	if (bHeader && ((g_Runtime.nFormat == FORMAT_ARROW) || (g_Runtime.nFormat == FORMAT_PGCOPY)))
+	{
+		if (pDest == NULL)
+			pDest = print_merge_open(path);
+		if (g_Runtime.nFormat == FORMAT_ARROW)
+			nBytes = arrow_eos(&pData);
+		else
+			nBytes = load_trailer(&pData);
+		print_merge_write(pDest, pData, nBytes, tbl);
+	}
+	if (pParquet)
+	{
+		if (pParquet->kOffset)
+		{
+			if (pDest == NULL)
+				pDest = print_merge_open(path);
+			nBytes = parquet_footer(pParquet, &pData);
+			print_merge_write(pDest, pData, nBytes, tbl);
+		}
+		parquet_free(pParquet);
+	}
+
+	if (pDest && pDest != stdout)
+		fclose(pDest);
+	else if (pDest)
+		fflush(pDest);
+	free(pBuffer);
+
+	return(0);
+}
+
 /*
 * Routine: print_start(tbl)
 * Purpose: open the output file for a given table
@@ -469,35 +1309,42 @@ print_boolean (int nColumn, int val, int sep)
 int
 print_start (int tbl)
 {
-   int res = 0;
-   char path[256];
+   int res = 0,
+      nBytes;
+   char path[256],
+      *pData;
    tdef *pTdef = getSimpleTdefsByNumber(tbl);
 
-   if (is_set ("_FILTER") || is_set ("STDOUT"))
+   if (nSpoolChunk)
+   {
+	   if (pTdef->outfile == NULL)
+	   {
+		   print_path(tbl, path);
+		   sprintf(path + strlen(path), ".%d", nSpoolChunk);
+#ifdef WIN32
+		   pTdef->outfile = fopen (path, "wt");
+#else
+		   pTdef->outfile = fopen (path, "w");
+#endif
+	   }
+	   fpOutfile = pTdef->outfile;
+   }
+   else if (is_set ("_FILTER") || is_set ("STDOUT"))
    {
 	   fpOutfile = stdout;
 	   pTdef->outfile = stdout;
    }
+   else if (g_Runtime.nShards)
+   {
+	   if (pTdef->outfile == NULL)
+		   pTdef->outfile = print_shards(tbl);
+	   fpOutfile = pTdef->outfile;
+   }
    else
    {
 	   if (pTdef->outfile == NULL)
 	   {
-		   if (is_set("PARALLEL"))
-			   sprintf (path, "%s%c%s_%d_%d%s",
-			   get_str ("DIR"),
-			   PATH_SEP, getTableNameByID (tbl), 
-			   get_int("CHILD"), get_int("PARALLEL"), (is_set("VALIDATE"))?get_str ("VSUFFIX"):get_str ("SUFFIX"));
-		   else 
-		   {
-			   if (is_set("UPDATE"))
-				   sprintf (path, "%s%c%s_%d%s",
-				   get_str ("DIR"),
-				   PATH_SEP, getTableNameByID (tbl), get_int("UPDATE"), (is_set("VALIDATE"))?get_str ("VSUFFIX"):get_str ("SUFFIX"));
-			   else
-				   sprintf (path, "%s%c%s%s",
-				   get_str ("DIR"),
-				   PATH_SEP, getTableNameByID (tbl), (is_set("VALIDATE"))?get_str ("VSUFFIX"):get_str ("SUFFIX"));
-		   }
+		   print_path(tbl, path);
 		   if ((access (path, F_OK) != -1) && !is_set ("FORCE"))
 		   {
 			   fprintf (stderr,
@@ -511,11 +1358,11 @@ print_start (int tbl)
 		   pTdef->outfile = fopen (path, "w");
 #endif
 	   }
-	   fpOutfile = pTdef->outfile;
+   fpOutfile = pTdef->outfile;
    }
    
    /* If fpOutfile is NULL in FILTER mode, it means we're skipping this table */
-   if ((is_set("_FILTER") || is_set("STDOUT")) && fpOutfile == NULL)
+   if (g_Runtime.bStdout && fpOutfile == NULL)
       return 0;
       
    res = (fpOutfile != NULL);
@@ -533,6 +1380,45 @@ print_start (int tbl)
 #endif
 
    pTdef->flags |= FL_OPEN;
+   if (g_Runtime.bStats)
+      stats_print_start();
+
+   pOutput = &arOutput[tbl];
+   if (pOutput->pData == NULL)
+   {
+      if (fpOutfile == stdout)
+         fflush(stdout);	/* keep anything already queued by stdio in front of the data */
+      pOutput->nFile = fileno(fpOutfile);
+      pOutput->nUsed = 0;
+      if (g_Runtime.bPipeline && !pOutput->arShard)
+         pOutput->pPipe = pipeline_open(pOutput->nFile, OUTPUT_BUFFER_SIZE);
+      if (pOutput->pPipe)
+         pOutput->pData = pipeline_block(pOutput->pPipe);
+      else
+      {
+         pOutput->pData = (char *)malloc(OUTPUT_BUFFER_SIZE);
+         MALLOC_CHECK(pOutput->pData);
+      }
+      if (g_Runtime.nFormat == FORMAT_ARROW)
+         pOutput->pBatch = arrow_new(tbl, ARROW_BATCH_ROWS);
+      else if (g_Runtime.nFormat == FORMAT_PARQUET)
+      {
+         pOutput->pBatch = arrow_new(tbl, PARQUET_GROUP_ROWS);
+         pOutput->pBatch->bDictionary = 1;
+         pOutput->pParquet = parquet_new(tbl, nSpoolChunk);
+      }
+      else if (g_Runtime.nFormat == FORMAT_PGCOPY)
+      {
+         pOutput->pLoad = load_open(tbl);
+         /* spool files are appended to the output, behind its header */
+         if (!nSpoolChunk)
+         {
+            nBytes = load_header(&pData);
+            print_bytes(pData, nBytes);
+            arHeader[tbl] = 1;
+         }
+      }
+   }
 
    return (0);
 }
@@ -554,28 +1440,44 @@ print_start (int tbl)
 int
 print_end (int tbl)
 {
-   int res = 0;
-   static int init = 0;
-   static int add_term = 0;
-   static char term[10];
+   int res = 0,
+      nBytes;
+   char *pData;
+   static THREAD int init = 0;
+   static THREAD int add_term = 0;
+   static THREAD char term[10];
 
    if (!init)
      {
-        if (is_set ("TERMINATE"))
+        if (g_Runtime.bTerminate)
           {
-             strncpy (term, get_str ("DELIMITER"), 9);
+             strncpy (term, g_Runtime.szDelimiter, 9);
              add_term = strlen(term);
           }
         init = 1;
      }
 
-   if (fpOutfile && add_term)
-      fwrite(term, 1, add_term, fpOutfile);
-   if (fpOutfile)
+   if (fpOutfile && pOutput->pBatch)
+   {
+      if (arrow_end_row(pOutput->pBatch))
+         print_batch(0);
+   }
+   else if (fpOutfile && pOutput->pLoad)
    {
-      fprintf (fpOutfile, "\n");
-      fflush(fpOutfile);
+      nBytes = load_end_row(pOutput->pLoad, &pData);
+      print_bytes(pData, nBytes);
    }
+   else
+   {
+      if (fpOutfile && add_term)
+         print_bytes(term, add_term);
+      if (fpOutfile)
+         print_bytes("\n", 1);
+      if (fpOutfile && pOutput->arShard)
+         print_shard_row();
+   }
+   if (fpOutfile && g_Runtime.bStats)
+      stats_print_end(tbl);
 
    return (res);
 }
@@ -656,15 +1558,63 @@ print_string (char *szMessage, ds_key_t val)
 	if (!fpOutfile)
 		return;
 		
-	if (fprintf (fpOutfile, szMessage, val) < 0)
+	char szTemp[256];
+	int nLength;
+
+	nLength = snprintf(szTemp, sizeof(szTemp), szMessage, val);
+	if (nLength < 0)
 	{
 		fprintf(stderr, "ERROR: Failed to write string\n");
 		exit(-1);
 	}
+	print_bytes(szTemp, (nLength < (int)sizeof(szTemp))?nLength:(int)sizeof(szTemp) - 1);
 
 	return;
 }
 
+/*
+* Routine: fmt_date(char *pDest, ds_key_t kValue)
+* Purpose: format a julian date as YYYY-MM-DD; equivalent to print_jdate()
+* Algorithm:
+* Data Structures:
+*
+* Params:
+* Returns: the number of characters written
+* Called By: 
+* Calls: 
+* Assumptions:
+* Side Effects:
+* TODO: None
+*/
+static int
+fmt_date (char *pDest, ds_key_t kValue)
+{
+	date_t dTemp;
+	char *cp = pDest;
+
+	jtodt (&dTemp, (int) kValue);
+#if (defined(STR_QUOTES) && !defined(_MYSQL))
+	*cp++ = '"';
+#endif
+	if ((dTemp.year >= 1000) && (dTemp.year <= 9999))
+	{
+		fmt_2digit(cp, dTemp.year / 100);
+		fmt_2digit(cp + 2, dTemp.year % 100);
+		cp[4] = '-';
+		fmt_2digit(cp + 5, dTemp.month);
+		cp[7] = '-';
+		fmt_2digit(cp + 8, dTemp.day);
+	}
+	else
+		memcpy(cp, dttostr(&dTemp), 10);
+	cp += 10;
+#if (defined(STR_QUOTES) && !defined(_MYSQL))
+	*cp++ = '"';
+#endif
+
+	return((int)(cp - pDest));
+}
+
 /*
 * Routine: print_jdate()
 * Purpose: genralized data print routine
@@ -716,8 +1666,8 @@ print_validation(ds_key_t kRowNumber)
 	if (!fpOutfile)
 		return;
 		
-	static int bInit = 0;
-	static char szValidateFormat[20];
+	static THREAD int bInit = 0;
+	static THREAD char szValidateFormat[20];
 
 	if (!bInit)
 	{
@@ -725,7 +1675,7 @@ print_validation(ds_key_t kRowNumber)
 		bInit = 1;
 	}
 	
-	if (is_set("VALIDATE"))
+	if (g_Runtime.bValidate)
 	{
 		print_string(szValidateFormat, kRowNumber);
 	}
@@ -42,6 +42,9 @@ int		print_start(int tbl);
 int      openDeleteFile(int bOpen);
 int		print_end(int tbl);
 void	print_close(int tbl);
+void	print_spool(int nChunk);
+int		print_merge(int tbl, int nChunks);
+ds_key_t	print_written(void);
 
 void print_integer(int nColumn, int col, int s);
 void print_char(int nColumn, char col, int s);
@@ -0,0 +1,324 @@
+/* 
+ * Legal Notice 
+ * 
+ * This document and associated source code (the "Work") is a part of a 
+ * benchmark specification maintained by the TPC. 
+ * 
+ * The TPC reserves all right, title, and interest to the Work as provided 
+ * under U.S. and international laws, including without limitation all patent 
+ * and trademark rights therein. 
+ * 
+ * No Warranty 
+ * 
+ * 1.1 TO THE MAXIMUM EXTENT PERMITTED BY APPLICABLE LAW, THE INFORMATION 
+ *     CONTAINED HEREIN IS PROVIDED "AS IS" AND WITH ALL FAULTS, AND THE 
+ *     AUTHORS AND DEVELOPERS OF THE WORK HEREBY DISCLAIM ALL OTHER 
+ *     WARRANTIES AND CONDITIONS, EITHER EXPRESS, IMPLIED OR STATUTORY, 
+ *     INCLUDING, BUT NOT LIMITED TO, ANY (IF ANY) IMPLIED WARRANTIES, 
+ *     DUTIES OR CONDITIONS OF MERCHANTABILITY, OF FITNESS FOR A PARTICULAR 
+ *     PURPOSE, OF ACCURACY OR COMPLETENESS OF RESPONSES, OF RESULTS, OF 
+ *     WORKMANLIKE EFFORT, OF LACK OF VIRUSES, AND OF LACK OF NEGLIGENCE. 
+ *     ALSO, THERE IS NO WARRANTY OR CONDITION OF TITLE, QUIET ENJOYMENT, 
+ *     QUIET POSSESSION, CORRESPONDENCE TO DESCRIPTION OR NON-INFRINGEMENT 
+ *     WITH REGARD TO THE WORK. 
+ * 1.2 IN NO EVENT WILL ANY AUTHOR OR DEVELOPER OF THE WORK BE LIABLE TO 
+ *     ANY OTHER PARTY FOR ANY DAMAGES, INCLUDING BUT NOT LIMITED TO THE 
+ *     COST OF PROCURING SUBSTITUTE GOODS OR SERVICES, LOST PROFITS, LOSS 
+ *     OF USE, LOSS OF DATA, OR ANY INCIDENTAL, CONSEQUENTIAL, DIRECT, 
+ *     INDIRECT, OR SPECIAL DAMAGES WHETHER UNDER CONTRACT, TORT, WARRANTY,
+ *     OR OTHERWISE, ARISING IN ANY WAY OUT OF THIS OR ANY OTHER AGREEMENT 
+ *     RELATING TO THE WORK, WHETHER OR NOT SUCH AUTHOR OR DEVELOPER HAD 
+ *     ADVANCE NOTICE OF THE POSSIBILITY OF SUCH DAMAGES. 
+ * 
+ * Contributors:
+ * Gradient Systems
+ */ 
+#include "config.h"
+#include "porting.h"
+#include <stdio.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <signal.h>
+#ifdef WIN32
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+#include "r_params.h"
+#include "tables.h"
+#include "tdefs.h"
+#include "print.h"
+#include "runtime.h"
+#include "stats.h"
+#include "progress.h"
+
+static int nProgressFile = -1;
+static ds_key_t kInterval;
+
+/*
+ * the tables being built; several are under way at once when -THREADS 
+ * schedules a whole schema, and threads add to them under ProgressLock
+ */
+typedef struct PROGRESS_T {
+	int nTable;
+	ds_key_t kExpected;	/* rows assigned to this child by split_work() */
+	ds_key_t kDone;
+	ds_key_t kBytes;
+	ds_key_t kStart;
+	ds_key_t kNext;	/* when the next record is due */
+} progress_t;
+static progress_t arProgress[MAX_TABLE + 1];
+DECLARE_LOCK(ProgressLock);
+
+static THREAD int nPending = 0;
+static THREAD ds_key_t kBytesSeen = 0;
+static THREAD int nProgressTable = 0;	/* the table the calling thread is building */
+
+/*
+* Routine: progress_init()
+* Purpose: open the destination named by -MONITOR
+* Algorithm: a value made up of digits is taken to be a descriptor that the
+*	caller has left open for us; anything else is opened as a file, which
+*	may be a FIFO (in which case the open waits for a reader)
+* Data Structures:
+*
+* Params:
+* Returns:
+* Called By: main()
+* Calls: 
+* Assumptions:
+* Side Effects: SIGPIPE is ignored, so that a scheduler that goes away does
+*	not take the generator with it; records are simply no longer written
+* TODO: None
+*/
+void
+progress_init(void)
+{
+	char *szDest,
+		*cp;
+
+	if (!g_Runtime.bProgress)
+		return;
+
+	szDest = get_str("MONITOR");
+	for (cp = szDest; *cp && (*cp >= '0') && (*cp <= '9'); cp++);
+	if (*szDest && !*cp)
+		nProgressFile = atoi(szDest);
+	else if ((nProgressFile = open(szDest, O_WRONLY|O_CREAT|O_APPEND, 0666)) < 0)
+	{
+		fprintf(stderr, "ERROR: Failed to open %s for progress records\n", szDest);
+		exit(-1);
+	}
+#ifdef SIGPIPE
+	signal(SIGPIPE, SIG_IGN);
+#endif
+
+	kInterval = (ds_key_t)get_int("INTERVAL") * 1000000000;
+
+	return;
+}
+
+/*
+* Routine: progress_write(progress_t *pProgress, char *szEvent, ds_key_t kNow)
+* Purpose: write one progress record
+* Algorithm:
+* Data Structures:
+*
+* Params:
+* Returns:
+* Called By: 
+* Calls: 
+* Assumptions: ProgressLock is held
+* Side Effects: the channel is dropped if the reader has gone away
+* TODO: None
+*/
+static void
+progress_write(progress_t *pProgress, char *szEvent, ds_key_t kNow)
+{
+	char szRecord[512];
+	int nLength;
+	double dElapsed,
+		dETA = -1;
+
+	if (nProgressFile < 0)
+		return;
+
+	dElapsed = (kNow - pProgress->kStart) / 1e9;
+	if (pProgress->kDone > 0)
+		dETA = dElapsed * (pProgress->kExpected - pProgress->kDone) / pProgress->kDone;
+
+	nLength = sprintf(szRecord, 
+		"{\"event\":\"%s\",\"table\":\"%s\",\"child\":%d,\"children\":%d,"
+		"\"rows\":" HUGE_FORMAT ",\"expected\":" HUGE_FORMAT ",\"bytes\":" HUGE_FORMAT ","
+		"\"elapsed\":%.3f,\"eta\":%.3f}\n",
+		szEvent, getTableNameByID(pProgress->nTable),
+		is_set("PARALLEL")?get_int("CHILD"):1, is_set("PARALLEL")?get_int("PARALLEL"):1,
+		(long long)pProgress->kDone, (long long)pProgress->kExpected, 
+		(long long)pProgress->kBytes, dElapsed, dETA);
+
+	while (write(nProgressFile, szRecord, nLength) < 0)
+	{
+		if (errno == EINTR)
+			continue;
+		close(nProgressFile);
+		nProgressFile = -1;
+		break;
+	}
+
+	return;
+}
+
+/*
+* Routine: progress_start(int nTable, ds_key_t kExpected)
+* Purpose: begin reporting on a table
+* Algorithm:
+* Data Structures:
+*
+* Params:
+* Returns:
+* Called By: gen_tbl(), gen_task()
+* Calls: 
+* Assumptions:
+* Side Effects: the rows of the calling thread are counted against nTable
+* TODO: None
+*/
+void
+progress_start(int nTable, ds_key_t kExpected)
+{
+	progress_t *pProgress = &arProgress[nTable];
+
+	if (!g_Runtime.bProgress)
+		return;
+
+	LOCK(ProgressLock);
+	pProgress->nTable = nTable;
+	pProgress->kExpected = kExpected;
+	pProgress->kDone = 0;
+	pProgress->kBytes = 0;
+	pProgress->kStart = stats_clock();
+	pProgress->kNext = pProgress->kStart + kInterval;
+	progress_write(pProgress, "start", pProgress->kStart);
+	UNLOCK(ProgressLock);
+	nProgressTable = nTable;
+
+	return;
+}
+
+/*
+* Routine: progress_flush()
+* Purpose: add the rows and bytes of the calling thread to the table's total,
+*	and write a record if one is due
+* Algorithm:
+* Data Structures:
+*
+* Params:
+* Returns:
+* Called By: progress_row(), gen_tbl(), gen_chunk()
+* Calls: 
+* Assumptions:
+* Side Effects:
+* TODO: None
+*/
+void
+progress_flush(void)
+{
+	ds_key_t kBytes,
+		kNow;
+	progress_t *pProgress;
+
+	if (!g_Runtime.bProgress)
+		return;
+
+	kBytes = print_written();
+	kNow = stats_clock();
+
+	pProgress = &arProgress[nProgressTable];
+	LOCK(ProgressLock);
+	pProgress->kDone += nPending;
+	pProgress->kBytes += kBytes - kBytesSeen;
+	if (kNow >= pProgress->kNext)
+	{
+		progress_write(pProgress, "progress", kNow);
+		pProgress->kNext = kNow + kInterval;
+	}
+	UNLOCK(ProgressLock);
+
+	nPending = 0;
+	kBytesSeen = kBytes;
+
+	return;
+}
+
+/*
+* Routine: progress_thread(int nTable)
+* Purpose: count the rows of a worker thread against nTable
+* Algorithm:
+* Data Structures:
+*
+* Params:
+* Returns:
+* Called By: gen_chunk()
+* Calls: 
+* Assumptions: progress_start() has been called for nTable
+* Side Effects:
+* TODO: None
+*/
+void
+progress_thread(int nTable)
+{
+	nProgressTable = nTable;
+
+	return;
+}
+
+/*
+* Routine: progress_row()
+* Purpose: count a row; the clock is only read every PROGRESS_ROWS rows
+* Algorithm:
+* Data Structures:
+*
+* Params:
+* Returns:
+* Called By: gen_tbl(), gen_chunk()
+* Calls: progress_flush()
+* Assumptions:
+* Side Effects:
+* TODO: None
+*/
+void
+progress_row(void)
+{
+	if (++nPending == PROGRESS_ROWS)
+		progress_flush();
+
+	return;
+}
+
+/*
+* Routine: progress_end(int nTable)
+* Purpose: write the final record for a table
+* Algorithm:
+* Data Structures:
+*
+* Params:
+* Returns:
+* Called By: gen_tbl(), gen_task()
+* Calls: 
+* Assumptions: every thread that built part of nTable has called 
+*	progress_flush()
+* Side Effects:
+* TODO: None
+*/
+void
+progress_end(int nTable)
+{
+	if (!g_Runtime.bProgress)
+		return;
+
+	progress_flush();
+	LOCK(ProgressLock);
+	progress_write(&arProgress[nTable], "done", stats_clock());
+	UNLOCK(ProgressLock);
+
+	return;
+}
@@ -0,0 +1,186 @@
+/* 
+ * Legal Notice 
+ * 
+ * This document and associated source code (the "Work") is a part of a 
+ * benchmark specification maintained by the TPC. 
+ * 
+ * The TPC reserves all right, title, and interest to the Work as provided 
+ * under U.S. and international laws, including without limitation all patent 
+ * and trademark rights therein. 
+ * 
+ * No Warranty 
+ * 
+ * 1.1 TO THE MAXIMUM EXTENT PERMITTED BY APPLICABLE LAW, THE INFORMATION 
+ *     CONTAINED HEREIN IS PROVIDED "AS IS" AND WITH ALL FAULTS, AND THE 
+ *     AUTHORS AND DEVELOPERS OF THE WORK HEREBY DISCLAIM ALL OTHER 
+ *     WARRANTIES AND CONDITIONS, EITHER EXPRESS, IMPLIED OR STATUTORY, 
+ *     INCLUDING, BUT NOT LIMITED TO, ANY (IF ANY) IMPLIED WARRANTIES, 
+ *     DUTIES OR CONDITIONS OF MERCHANTABILITY, OF FITNESS FOR A PARTICULAR 
+ *     PURPOSE, OF ACCURACY OR COMPLETENESS OF RESPONSES, OF RESULTS, OF 
+ *     WORKMANLIKE EFFORT, OF LACK OF VIRUSES, AND OF LACK OF NEGLIGENCE. 
+ *     ALSO, THERE IS NO WARRANTY OR CONDITION OF TITLE, QUIET ENJOYMENT, 
+ *     QUIET POSSESSION, CORRESPONDENCE TO DESCRIPTION OR NON-INFRINGEMENT 
+ *     WITH REGARD TO THE WORK. 
+ * 1.2 IN NO EVENT WILL ANY AUTHOR OR DEVELOPER OF THE WORK BE LIABLE TO 
+ *     ANY OTHER PARTY FOR ANY DAMAGES, INCLUDING BUT NOT LIMITED TO THE 
+ *     COST OF PROCURING SUBSTITUTE GOODS OR SERVICES, LOST PROFITS, LOSS 
+ *     OF USE, LOSS OF DATA, OR ANY INCIDENTAL, CONSEQUENTIAL, DIRECT, 
+ *     INDIRECT, OR SPECIAL DAMAGES WHETHER UNDER CONTRACT, TORT, WARRANTY,
+ *     OR OTHERWISE, ARISING IN ANY WAY OUT OF THIS OR ANY OTHER AGREEMENT 
+ *     RELATING TO THE WORK, WHETHER OR NOT SUCH AUTHOR OR DEVELOPER HAD 
+ *     ADVANCE NOTICE OF THE POSSIBILITY OF SUCH DAMAGES. 
+ * 
+ * Contributors:
+ * Gradient Systems
+ */ 
+#include "config.h"
+#include "porting.h"
+#include <stdio.h>
+#include "r_params.h"
+#include "tables.h"
+#include "runtime.h"
+
+runtime_t g_Runtime;
+
+/*
+ * the sales and returns tables whose rows are printed selectively by
+ * the sales builders; names must match -TABLE exactly
+ */
+static struct {
+	char *szName;
+	int nTable;
+} arPrintedTables[] = {
+	{"web_sales", WEB_SALES},
+	{"web_returns", WEB_RETURNS},
+	{"catalog_sales", CATALOG_SALES},
+	{"catalog_returns", CATALOG_RETURNS},
+	{"store_sales", STORE_SALES},
+	{"store_returns", STORE_RETURNS},
+	{NULL, -1}
+};
+
+/*
+* Routine: check_options(char *szMsg)
+* Purpose: check the combination of options, once they have been processed
+* Algorithm:
+* Data Structures:
+*
+* Params: szMsg receives one line for each problem found; 1024 bytes is ample
+* Returns: the number of characters in szMsg; 0 if the options are usable
+* Called By: validate_options(), dsdgen_open()
+* Calls: 
+* Assumptions:
+* Side Effects:
+* TODO: None
+*/
+int
+check_options(char *szMsg)
+{
+	char *szValue;
+
+	szMsg[0] = '\0';
+	if (is_set("PARALLEL"))
+	{
+		if (get_int("PARALLEL") < 2) strcat(szMsg, "PARALLEL must be >= 2\n");
+		if (get_int("CHILD") < 1) strcat(szMsg, "CHILD must be >= 1\n");
+	}
+	if (is_set("THREADS"))
+	{
+		if (get_int("THREADS") < 1) strcat(szMsg, "THREADS must be >= 1\n");
+#ifndef USE_THREADS
+		if (get_int("THREADS") > 1) strcat(szMsg, "THREADS is not supported on this platform\n");
+#endif
+	}
+	szValue = get_str("FORMAT");
+	if (strcasecmp(szValue, "text") && strcasecmp(szValue, "arrow") && strcasecmp(szValue, "parquet"))
+		strcat(szMsg, "FORMAT must be text, arrow or parquet\n");
+	szValue = get_str("COMPRESS");
+	if (strcasecmp(szValue, "none") && strcasecmp(szValue, "snappy"))
+		strcat(szMsg, "COMPRESS must be none or snappy\n");
+	if (is_set("DBLOAD") && strcasecmp(get_str("FORMAT"), "text"))
+		strcat(szMsg, "DBLOAD cannot be combined with FORMAT\n");
+	/* shards are picked from the printed text of a field, and need files */
+	if (is_set("SHARDS") && !is_set("VALIDATE"))
+	{
+		if (get_int("SHARDS") < 1) strcat(szMsg, "SHARDS must be >= 1\n");
+		if (strcasecmp(get_str("FORMAT"), "text") || is_set("DBLOAD") || is_set("_FILTER") || is_set("STDOUT"))
+			strcat(szMsg, "SHARDS requires text output to files\n");
+	}
+
+	return(strlen(szMsg));
+}
+
+/*
+* Routine: init_runtime()
+* Purpose: resolve the per-row settings in g_Runtime from the command line
+* Algorithm:
+* Data Structures:
+*
+* Params:
+* Returns:
+* Called By: main()
+* Calls: 
+* Assumptions: process_options() has been called
+* Side Effects: g_Runtime is read by every thread, and must not change once
+*	generation starts
+* TODO: None
+*/
+void
+init_runtime(void)
+{
+	int i;
+	char *szTable,
+		*szFormat;
+
+	g_Runtime.nScale = get_int("SCALE");
+
+	szTable = get_str("TABLE");
+	g_Runtime.nTable = -1;
+	for (i=0; arPrintedTables[i].szName; i++)
+		if (!strcmp(szTable, arPrintedTables[i].szName))
+		{
+			g_Runtime.nTable = arPrintedTables[i].nTable;
+			break;
+		}
+
+	/* a whole schema run writes both halves of every sales/returns pair */
+	g_Runtime.bReturns = is_set("RETURNS") || 
+		(!strcmp(szTable, "ALL") && !is_set("ABREVIATION"));
+	g_Runtime.szDelimiter = get_str("DELIMITER");
+	g_Runtime.bTerminate = is_set("TERMINATE");
+	g_Runtime.bStdout = is_set("_FILTER") || is_set("STDOUT");
+	g_Runtime.bValidate = is_set("VALIDATE");
+	g_Runtime.bStateless = is_set("STATELESS");
+	g_Runtime.bStats = is_set("STATS");
+	g_Runtime.bProgress = is_set("MONITOR");
+	g_Runtime.bPipeline = is_set("PIPELINE");
+
+	/* validation rows carry a row number, so they are always text */
+	szFormat = get_str("FORMAT");
+	if (!strcasecmp(szFormat, "arrow"))
+		g_Runtime.nFormat = FORMAT_ARROW;
+	else if (!strcasecmp(szFormat, "parquet"))
+		g_Runtime.nFormat = FORMAT_PARQUET;
+	else	/* validate_options() has rejected anything else */
+		g_Runtime.nFormat = FORMAT_TEXT;
+	if (is_set("DBLOAD"))
+		g_Runtime.nFormat = FORMAT_PGCOPY;
+	if (g_Runtime.bValidate)
+		g_Runtime.nFormat = FORMAT_TEXT;
+	if ((g_Runtime.nFormat == FORMAT_ARROW) && !strcmp(get_str("SUFFIX"), ".dat"))
+		set_str("SUFFIX", ".arrow");
+	if ((g_Runtime.nFormat == FORMAT_PARQUET) && !strcmp(get_str("SUFFIX"), ".dat"))
+		set_str("SUFFIX", ".parquet");
+	if ((g_Runtime.nFormat == FORMAT_PGCOPY) && !strcmp(get_str("SUFFIX"), ".dat"))
+		set_str("SUFFIX", ".copy");
+
+	szFormat = get_str("COMPRESS");
+	if (!strcasecmp(szFormat, "snappy"))
+		g_Runtime.nCompress = COMPRESS_SNAPPY;
+	else
+		g_Runtime.nCompress = COMPRESS_NONE;
+
+	g_Runtime.nShards = (is_set("SHARDS") && !g_Runtime.bValidate)?get_int("SHARDS"):0;
+
+	return;
+}
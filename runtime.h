@@ -0,0 +1,76 @@
+/* 
+ * Legal Notice 
+ * 
+ * This document and associated source code (the "Work") is a part of a 
+ * benchmark specification maintained by the TPC. 
+ * 
+ * The TPC reserves all right, title, and interest to the Work as provided 
+ * under U.S. and international laws, including without limitation all patent 
+ * and trademark rights therein. 
+ * 
+ * No Warranty 
+ * 
+ * 1.1 TO THE MAXIMUM EXTENT PERMITTED BY APPLICABLE LAW, THE INFORMATION 
+ *     CONTAINED HEREIN IS PROVIDED "AS IS" AND WITH ALL FAULTS, AND THE 
+ *     AUTHORS AND DEVELOPERS OF THE WORK HEREBY DISCLAIM ALL OTHER 
+ *     WARRANTIES AND CONDITIONS, EITHER EXPRESS, IMPLIED OR STATUTORY, 
+ *     INCLUDING, BUT NOT LIMITED TO, ANY (IF ANY) IMPLIED WARRANTIES, 
+ *     DUTIES OR CONDITIONS OF MERCHANTABILITY, OF FITNESS FOR A PARTICULAR 
+ *     PURPOSE, OF ACCURACY OR COMPLETENESS OF RESPONSES, OF RESULTS, OF 
+ *     WORKMANLIKE EFFORT, OF LACK OF VIRUSES, AND OF LACK OF NEGLIGENCE. 
+ *     ALSO, THERE IS NO WARRANTY OR CONDITION OF TITLE, QUIET ENJOYMENT, 
+ *     QUIET POSSESSION, CORRESPONDENCE TO DESCRIPTION OR NON-INFRINGEMENT 
+ *     WITH REGARD TO THE WORK. 
+ * 1.2 IN NO EVENT WILL ANY AUTHOR OR DEVELOPER OF THE WORK BE LIABLE TO 
+ *     ANY OTHER PARTY FOR ANY DAMAGES, INCLUDING BUT NOT LIMITED TO THE 
+ *     COST OF PROCURING SUBSTITUTE GOODS OR SERVICES, LOST PROFITS, LOSS 
+ *     OF USE, LOSS OF DATA, OR ANY INCIDENTAL, CONSEQUENTIAL, DIRECT, 
+ *     INDIRECT, OR SPECIAL DAMAGES WHETHER UNDER CONTRACT, TORT, WARRANTY,
+ *     OR OTHERWISE, ARISING IN ANY WAY OUT OF THIS OR ANY OTHER AGREEMENT 
+ *     RELATING TO THE WORK, WHETHER OR NOT SUCH AUTHOR OR DEVELOPER HAD 
+ *     ADVANCE NOTICE OF THE POSSIBILITY OF SUCH DAMAGES. 
+ * 
+ * Contributors:
+ * Gradient Systems
+ */ 
+#ifndef RUNTIME_H
+#define RUNTIME_H
+
+/*
+ * run time settings that are consulted on every row; they are resolved from
+ * the command line once, so that the builders and the print routines do not
+ * have to search options[] each time
+ */
+typedef struct RUNTIME_T {
+	int nScale;		/* -SCALE */
+	int nTable;		/* sales or returns table named by -TABLE; -1 otherwise */
+	int bReturns;	/* -RETURNS, or -TABLE ALL: print sales and returns together */
+	char *szDelimiter;	/* -DELIMITER */
+	int bTerminate;	/* -TERMINATE */
+	int bStdout;	/* -_FILTER or -STDOUT: rows go to stdout */
+	int bValidate;	/* -VALIDATE */
+	int bStats;	/* -STATS */
+	int bProgress;	/* -MONITOR */
+	int bStateless;	/* -STATELESS: permutations and sparse keys are computed, not stored */
+	int nFormat;	/* -FORMAT */
+	int nCompress;	/* -COMPRESS, for -FORMAT parquet */
+	int bPipeline;	/* -PIPELINE: output is written by a separate thread */
+	int nShards;	/* -SHARDS; 0 when rows are not sharded */
+} runtime_t;
+
+/* output formats */
+#define FORMAT_TEXT		0	/* delimited text */
+#define FORMAT_ARROW	1	/* Arrow IPC stream */
+#define FORMAT_PARQUET	2	/* Parquet file */
+#define FORMAT_PGCOPY	3	/* -DBLOAD: PostgreSQL binary COPY */
+
+/* -COMPRESS; the values are Parquet's CompressionCodec */
+#define COMPRESS_NONE	0
+#define COMPRESS_SNAPPY	1
+
+extern runtime_t g_Runtime;
+
+int check_options(char *szMsg);
+void init_runtime(void);
+
+#endif /* RUNTIME_H */
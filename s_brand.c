@@ -61,7 +61,7 @@ struct S_BRAND_TBL g_s_brand;
 * TODO: None
 */
 int
-mk_s_brand(void *pDest, ds_key_t kIndex)
+mk_s_brand(gen_ctx_t *pCtx, void *pDest, ds_key_t kIndex)
 {
 	static int bInit = 0;
 	struct S_BRAND_TBL *r;
@@ -146,6 +146,6 @@ ld_s_brand(void *pSrc)
 	else
 		r = pSrc;
 	
-	return(0);
+	return(pr_s_brand(r));
 }
 
@@ -35,6 +35,7 @@
  */ 
 #ifndef s_brand_H
 #define s_brand_H
+#include "context.h"
 
 #define RS_BRAND_NAME	30
 #define BRAND_SUBCLASS_COUNT	5	/* number of subrands per brand */
@@ -47,7 +48,7 @@ struct S_BRAND_TBL {
 	char		brand_name[RS_BRAND_NAME + 1];
 };
 
-int mk_s_brand(void *pDest, ds_key_t kIndex);
+int mk_s_brand(gen_ctx_t *pCtx, void *pDest, ds_key_t kIndex);
 int pr_s_brand(void *pSrc);
 int ld_s_brand(void *pSrc);
 #endif
@@ -53,7 +53,7 @@
 #include "permute.h"
 #include "scd.h"
 
-extern struct CALL_CENTER_TBL g_w_call_center;
+extern THREAD struct CALL_CENTER_TBL g_w_call_center;
 
 /*
 * Routine: 
@@ -70,7 +70,7 @@ extern struct CALL_CENTER_TBL g_w_call_center;
 * TODO: None
 */
 int
-mk_s_call_center (void* row, ds_key_t index)
+mk_s_call_center (gen_ctx_t *pCtx, void* row, ds_key_t index)
 {
    static int bInit = 0;
    static int *pPermutation;
@@ -83,7 +83,7 @@ mk_s_call_center (void* row, ds_key_t index)
    }
 
    kIndex = getPermutationEntry(pPermutation, (int)index);
-   mk_w_call_center(NULL, getSKFromID(kIndex, S_CALL_CENTER_ID));
+   mk_w_call_center(pCtx, NULL, getSKFromID(kIndex, S_CALL_CENTER_ID));
 
    return(0);
 }
@@ -146,6 +146,6 @@ pr_s_call_center(void *row)
 int
 ld_s_call_center(void *r)
 {
-	return(0);
+	return(pr_s_call_center(r));
 }
 
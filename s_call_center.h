@@ -35,8 +35,9 @@
  */ 
 #ifndef S_CALL_CENTER_H
 #define S_CALL_CENTER_H
+#include "context.h"
 
-int mk_s_call_center(void *row,ds_key_t kIndex);
+int mk_s_call_center(gen_ctx_t *pCtx, void *row,ds_key_t kIndex);
 int pr_s_call_center(void *pSrc);
 int ld_s_call_center(void *pSrc);
 #endif
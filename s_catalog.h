@@ -36,6 +36,7 @@
 #ifndef S_CATALOG_H
 #define S_CATALOG_H
 #include "date.h"
+#include "context.h"
 
 #define RS_S_CATALOG_DESC	50
 #define S_CATALOG_DURATION_MIN	50		/* days a catlog is active */
@@ -55,7 +56,7 @@ struct S_CATALOG_TBL {
 	int			s_catalog_catalog_type;
 	};
 
-int mk_s_catalog(void *pDest, ds_key_t kIndex);
+int mk_s_catalog(gen_ctx_t *pCtx, void *pDest, ds_key_t kIndex);
 int pr_s_catalog(void *pSrc);
 int ld_s_catalog(void *pSrc);
 #endif
@@ -70,7 +70,7 @@ int nItemIndex;
 * TODO: None
 */
 static int
-mk_master(void *pDest, ds_key_t kIndex)
+mk_master(gen_ctx_t *pCtx, void *pDest, ds_key_t kIndex)
 {
 	static int bInit = 0;
 	struct S_CATALOG_ORDER_TBL *r;
@@ -101,17 +101,17 @@ mk_master(void *pDest, ds_key_t kIndex)
 	else
 		r->kShipCustomerID = r->kBillCustomerID;
 	r->kShipModeID = mk_join(S_CORD_SHIP_MODE_ID, SHIP_MODE, 1);
-	gen_text(&r->szComment[0], (int)(RS_S_CATALOG_ORDER_COMMENT * 0.6), RS_S_CATALOG_ORDER_COMMENT, S_CORD_COMMENT);
+	gen_text(pCtx, &r->szComment[0], (int)(RS_S_CATALOG_ORDER_COMMENT * 0.6), RS_S_CATALOG_ORDER_COMMENT, S_CORD_COMMENT);
 
    return(0);
 }
 
 static int
-mk_detail(void *pDest, int nLine, int bPrint)
+mk_detail(gen_ctx_t *pCtx, void *pDest, int nLine, int bPrint)
 {
 	int nTemp;
 
-	mk_s_catalog_order_lineitem(pDest, nLine);
+	mk_s_catalog_order_lineitem(pCtx, pDest, nLine);
 	if (bPrint)
 		pr_s_catalog_order_lineitem(pDest);
 
@@ -119,7 +119,7 @@ mk_detail(void *pDest, int nLine, int bPrint)
 	genrand_integer(&nTemp, DIST_UNIFORM, 0, 9999, 0, S_CLIN_IS_RETURNED);
 	if ((nTemp < S_CATALOG_RETURN_PCT) && (g_s_catalog_order_lineitem.dtShipDate.julian != -1))
 	{
-		mk_s_catalog_returns(&g_s_catalog_return, nLine);
+		mk_s_catalog_returns(pCtx, &g_s_catalog_return, nLine);
 		if (bPrint)
 			pr_s_catalog_returns(&g_s_catalog_return);
 	}
@@ -128,15 +128,15 @@ mk_detail(void *pDest, int nLine, int bPrint)
 }
 
 int
-mk_s_catalog_order(void *pDest, ds_key_t kIndex)
+mk_s_catalog_order(gen_ctx_t *pCtx, void *pDest, ds_key_t kIndex)
 {
    int i;
 
-   mk_master(pDest, kIndex);
+   mk_master(pCtx, pDest, kIndex);
    genrand_integer(&nItemIndex, DIST_UNIFORM, 1, (int)getIDCount(ITEM), 0, S_CLIN_ITEM_ID);
 	for (i=1; i <= 9; i++)
 	{
-      mk_detail(&g_s_catalog_order_lineitem, i, 1);
+      mk_detail(pCtx, &g_s_catalog_order_lineitem, i, 1);
    }
 
    return(0);
@@ -204,11 +204,11 @@ ld_s_catalog_order(void *pSrc)
 	else
 		r = pSrc;
 	
-	return(0);
+	return(pr_s_catalog_order(r));
 }
 
 int 
-vld_s_catalog_order(int nTable, ds_key_t kRow, int* bPermutation)
+vld_s_catalog_order(gen_ctx_t *pCtx, int nTable, ds_key_t kRow, int* bPermutation)
 {
    int nLineitem,
       i;
@@ -217,14 +217,14 @@ vld_s_catalog_order(int nTable, ds_key_t kRow, int* bPermutation)
    row_skip(S_CATALOG_ORDER_LINEITEM, (kRow - 1)*9);
    row_skip(S_CATALOG_RETURNS, kRow - 1);
 
-   mk_master(NULL, kRow);
+   mk_master(pCtx, NULL, kRow);
    genrand_integer(&nLineitem, DIST_UNIFORM, 1, 9, 0, S_CLIN_LINE_NUMBER);
    genrand_integer(&nItemIndex, DIST_UNIFORM, 1, (int)getIDCount(ITEM), 0, S_CLIN_ITEM_ID);
    for (i=1; i < nLineitem; i++)
-      mk_detail(&g_s_catalog_order_lineitem, i, 0);
+      mk_detail(pCtx, &g_s_catalog_order_lineitem, i, 0);
    print_start(S_CATALOG_ORDER_LINEITEM);
    print_key(0, (kRow - 1) * 9 + nLineitem, 1);
-   mk_detail(&g_s_catalog_order_lineitem, nLineitem, 1);
+   mk_detail(pCtx, &g_s_catalog_order_lineitem, nLineitem, 1);
 
    return(0);
 }
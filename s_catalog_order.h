@@ -35,6 +35,7 @@
  */ 
 #ifndef S_CATALOG_ORDER_H
 #define S_CATALOG_ORDER_H
+#include "context.h"
 
 #define RS_S_CATALOG_ORDER_COMMENT	100
 #define S_CATALOG_RETURN_PCT	1030
@@ -50,8 +51,8 @@ struct S_CATALOG_ORDER_TBL {
 	char		szComment[RS_S_CATALOG_ORDER_COMMENT + 1];
 };
 
-int mk_s_catalog_order(void *pDest, ds_key_t kIndex);
+int mk_s_catalog_order(gen_ctx_t *pCtx, void *pDest, ds_key_t kIndex);
 int pr_s_catalog_order(void *pSrc);
 int ld_s_catalog_order(void *pSrc);
-int vld_s_catalog_order(int nTable, ds_key_t kRow, int *pPermuatation);
+int vld_s_catalog_order(gen_ctx_t *pCtx, int nTable, ds_key_t kRow, int *pPermuatation);
 #endif
@@ -70,7 +70,7 @@ extern int nItemIndex;
 * TODO: None
 */
 int
-mk_s_catalog_order_lineitem(void *pDest, ds_key_t kIndex)
+mk_s_catalog_order_lineitem(gen_ctx_t *pCtx, void *pDest, ds_key_t kIndex)
 {
 	static int bInit = 0;
 	struct S_CATALOG_ORDER_LINEITEM_TBL *r;
@@ -120,7 +120,7 @@ mk_s_catalog_order_lineitem(void *pDest, ds_key_t kIndex)
 	r->kCatalogPage = mk_join(S_CLIN_CATALOG_PAGE_ID, CATALOG_PAGE, g_s_catalog_order.dtOrderDate.julian);
 	r->kCatalogID = getCatalogNumberFromPage(r->kCatalogPage);
 	// genrand_integer(&r->Pricing.quantity, DIST_UNIFORM, 1, 100, 0, S_CLIN_QUANTITY);
-	set_pricing(S_CLIN_PRICING, &r->Pricing);
+	set_pricing(pCtx, S_CLIN_PRICING, &r->Pricing);
 	
 	return(0);
 
@@ -192,6 +192,6 @@ ld_s_catalog_order_lineitem(void *pSrc)
 	else
 		r = pSrc;
 	
-	return(0);
+	return(pr_s_catalog_order_lineitem(r));
 }
 
@@ -37,6 +37,7 @@
 #define S_CATALOG_ORDER_LINEITEM_H
 
 #include "pricing.h"
+#include "context.h"
 
 #define PAGES_PER_CATALOG	50
 
@@ -54,7 +55,7 @@ struct S_CATALOG_ORDER_LINEITEM_TBL {
 	ds_pricing_t	Pricing;
 };
 
-int mk_s_catalog_order_lineitem(void *pDest, ds_key_t kIndex);
+int mk_s_catalog_order_lineitem(gen_ctx_t *pCtx, void *pDest, ds_key_t kIndex);
 int pr_s_catalog_order_lineitem(void *pSrc);
 int ld_s_catalog_order_lineitem(void *pSrc);
 #endif
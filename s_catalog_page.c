@@ -48,12 +48,12 @@
 #include "validate.h"
 #include "parallel.h"
 
-struct CATALOG_PAGE_TBL g_w_catalog_page;
+extern THREAD struct CATALOG_PAGE_TBL g_w_catalog_page;
 
 int
-mk_s_catalog_page(void *pDest, ds_key_t kRow)
+mk_s_catalog_page(gen_ctx_t *pCtx, void *pDest, ds_key_t kRow)
 {
-   mk_w_catalog_page(pDest, kRow);
+   mk_w_catalog_page(pCtx, pDest, kRow);
    row_stop(CATALOG_PAGE);
 
    return(0);
@@ -121,11 +121,11 @@ ld_s_catalog_page(void *pSrc)
 	else
 		r = pSrc;
 	
-	return(0);
+	return(pr_s_catalog_page(r));
 }
 
 int 
-vld_s_catalog_page(int nTable, ds_key_t kRow, int *Permutation)
+vld_s_catalog_page(gen_ctx_t *pCtx, int nTable, ds_key_t kRow, int *Permutation)
 {
-   return(validateGeneric(S_CATALOG_PAGE, kRow, NULL));
+   return(validateGeneric(pCtx, S_CATALOG_PAGE, kRow, NULL));
 }
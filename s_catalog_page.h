@@ -35,8 +35,9 @@
  */ 
 #ifndef S_CATALOG_PAGE_H
 #define S_CATALOG_PAGE_H
-int mk_s_catalog_page(void *pDest, ds_key_t kIndex);
+#include "context.h"
+int mk_s_catalog_page(gen_ctx_t *pCtx, void *pDest, ds_key_t kIndex);
 int pr_s_catalog_page(void *pSrc);
 int ld_s_catalog_page(void *pSrc);
-int vld_s_catalog_page(int nTable, ds_key_t kRow, int *Permutation);
+int vld_s_catalog_page(gen_ctx_t *pCtx, int nTable, ds_key_t kRow, int *Permutation);
 #endif
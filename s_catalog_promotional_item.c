@@ -60,7 +60,7 @@ struct S_CATALOG_PROMOTIONAL_ITEM_TBL g_s_catalog_promotional_item;
 * TODO: None
 */
 int
-mk_s_catalog_promotional_item(void *pDest, ds_key_t kIndex)
+mk_s_catalog_promotional_item(gen_ctx_t *pCtx, void *pDest, ds_key_t kIndex)
 {
 	struct S_CATALOG_PROMOTIONAL_ITEM_TBL *r;
 	static int bInit = 0;
@@ -141,6 +141,6 @@ ld_s_catalog_promotional_item(void *pSrc)
 	else
 		r = pSrc;
 	
-	return(0);
+	return(pr_s_catalog_promotional_item(r));
 
 }
@@ -35,6 +35,7 @@
  */ 
 #ifndef S_CATALOG_PROMOTIONAL_ITEM_H
 #define S_CATALOG_PROMOTIONAL_ITEM_H
+#include "context.h"
 
 #define PAGES_PER_CATALOG	50
 #define ITEMS_PER_PROMOTION	50
@@ -49,7 +50,7 @@ struct S_CATALOG_PROMOTIONAL_ITEM_TBL {
 	ds_key_t	catalog_promotional_item_promotion_id;
 	};
 
-int mk_s_catalog_promotional_item(void *pDest, ds_key_t kIndex);
+int mk_s_catalog_promotional_item(gen_ctx_t *pCtx, void *pDest, ds_key_t kIndex);
 int pr_s_catalog_promotional_item(void *pSrc);
 int ld_s_catalog_promotional_item(void *pSrc);
 #endif
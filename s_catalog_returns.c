@@ -65,7 +65,7 @@ extern struct S_CATALOG_ORDER_TBL g_s_catalog_order;
 * TODO: None
 */
 int
-mk_s_catalog_returns(void *pDest, ds_key_t kIndex)
+mk_s_catalog_returns(gen_ctx_t *pCtx, void *pDest, ds_key_t kIndex)
 {
 	static int bInit = 0;
 	struct S_CATALOG_RETURNS_TBL *r;
@@ -96,7 +96,7 @@ mk_s_catalog_returns(void *pDest, ds_key_t kIndex)
 	r->kRefundCustomerID = g_s_catalog_order.kShipCustomerID;
    r->Pricing = g_s_catalog_order_lineitem.Pricing;
    genrand_integer(&r->Pricing.quantity, DIST_UNIFORM, 1, g_s_catalog_order_lineitem.Pricing.quantity, 0, S_CRET_PRICING);
-   set_pricing(S_CRET_PRICING, &r->Pricing);
+   set_pricing(pCtx, S_CRET_PRICING, &r->Pricing);
 	r->kShipModeID = mk_join (S_CRET_SHIPMODE_ID, SHIP_MODE, 1);
 	r->kWarehouseID = mk_join (S_CRET_WAREHOUSE_ID, WAREHOUSE, 1);
    r->kCatalogPageID = g_s_catalog_order_lineitem.kCatalogPage;
@@ -178,6 +178,6 @@ ld_s_catalog_returns(void *pSrc)
 	else
 		r = pSrc;
 	
-	return(0);
+	return(pr_s_catalog_returns(r));
 }
 
@@ -37,6 +37,7 @@
 #define S_CATALOG_RETURNS_H
 
 #include "pricing.h"
+#include "context.h"
 
 struct S_CATALOG_RETURNS_TBL {
 	ds_key_t	kCallCenterID;
@@ -55,7 +56,7 @@ struct S_CATALOG_RETURNS_TBL {
 	ds_key_t	kWarehouseID;
 };
 
-int mk_s_catalog_returns(void *pDest, ds_key_t kIndex);
+int mk_s_catalog_returns(gen_ctx_t *pCtx, void *pDest, ds_key_t kIndex);
 int pr_s_catalog_returns(void *pSrc);
 int ld_s_catalog_returns(void *pSrc);
 #endif
@@ -62,7 +62,7 @@ struct S_CATEGORY_TBL g_s_category;
 * 20031022 jms RNGUsage for description is an estimate
 */
 int
-mk_s_category(void *pDest, ds_key_t kIndex)
+mk_s_category(gen_ctx_t *pCtx, void *pDest, ds_key_t kIndex)
 {
 	struct S_CATEGORY_TBL *r;
 	static int bInit = 0;
@@ -79,7 +79,7 @@ mk_s_category(void *pDest, ds_key_t kIndex)
 	}
 	r->category_id = kIndex;
 	mk_word(r->category_name, "Syllables", kIndex, RS_CATEGORY_NAME, S_CATEGORY_NAME);
-	gen_text(r->category_desc, S_CATEGORY_DESC_MIN, RS_CATEGORY_DESC, S_CATEGORY_DESC);
+	gen_text(pCtx, r->category_desc, S_CATEGORY_DESC_MIN, RS_CATEGORY_DESC, S_CATEGORY_DESC);
 	
 	return(0);
 }
@@ -141,6 +141,6 @@ ld_s_category(void *pSrc)
 	else
 		r = pSrc;
 	
-	return(0);
+	return(pr_s_category(r));
 }
 
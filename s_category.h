@@ -35,6 +35,7 @@
  */ 
 #ifndef S_CATEGORY_H
 #define S_CATEGORY_H
+#include "context.h"
 
 #define RS_CATEGORY_NAME	25
 #define RS_CATEGORY_DESC	50
@@ -49,7 +50,7 @@ struct S_CATEGORY_TBL {
 	char		category_desc[RS_CATEGORY_DESC + 1];
 };
 
-int mk_s_category(void *pDest, ds_key_t kIndex);
+int mk_s_category(gen_ctx_t *pCtx, void *pDest, ds_key_t kIndex);
 int pr_s_category(void *pSrc);
 int ld_s_category(void *pSrc);
 #endif
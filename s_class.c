@@ -63,7 +63,7 @@ struct S_CLASS_TBL g_s_class;
 * 20031022 jms RNGUsage for descrition is an estimate
 */
 int
-mk_s_class(void *pDest, ds_key_t kIndex)
+mk_s_class(gen_ctx_t *pCtx, void *pDest, ds_key_t kIndex)
 {
 	struct S_CLASS_TBL *r;
 	static int bInit = 0;
@@ -81,7 +81,7 @@ mk_s_class(void *pDest, ds_key_t kIndex)
 	
 	r->id = kIndex;
 	r->subcat_id = mk_join(S_CLASS_SUBCAT_ID, S_SUBCATEGORY, 1);
-	gen_text(r->desc, S_CLASS_DESC_MIN, RS_CLASS_DESC, S_CLASS_DESC);
+	gen_text(pCtx, r->desc, S_CLASS_DESC_MIN, RS_CLASS_DESC, S_CLASS_DESC);
 	row_stop(S_CLASS);
 
 	return(0);
@@ -144,6 +144,6 @@ ld_s_class(void *pSrc)
 	else
 		r = pSrc;
 	
-	return(0);
+	return(pr_s_class(r));
 }
 
@@ -35,6 +35,7 @@
  */ 
 #ifndef S_CLASS_H
 #define S_CLASS_H
+#include "context.h"
 
 #define RS_CLASS_DESC	50
 #define S_CLASS_DESC_MIN	35
@@ -48,7 +49,7 @@ struct S_CLASS_TBL {
 	char		desc[RS_CLASS_DESC + 1];
 };
 
-int mk_s_class(void *pDest, ds_key_t kIndex);
+int mk_s_class(gen_ctx_t *pCtx, void *pDest, ds_key_t kIndex);
 int pr_s_class(void *pSrc);
 int ld_s_class(void *pSrc);
 #endif
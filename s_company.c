@@ -61,7 +61,7 @@ struct S_COMPANY_TBL g_s_company;
 * TODO: None
 */
 int
-mk_s_company(void *pDest, ds_key_t kIndex)
+mk_s_company(gen_ctx_t *pCtx, void *pDest, ds_key_t kIndex)
 {
 	struct S_COMPANY_TBL *r;
 	static int bInit = 0;
@@ -140,6 +140,6 @@ ld_s_company(void *pSrc)
 	else
 		r = pSrc;
 	
-	return(0);
+	return(pr_s_company(r));
 }
 
@@ -35,6 +35,7 @@
  */ 
 #ifndef S_COMPANY_H
 #define S_COMPANY_H
+#include "context.h"
 
 #define RS_COMPANY_NAME		50
 
@@ -46,7 +47,7 @@ struct S_COMPANY_TBL {
 	char		company_name[RS_COMPANY_NAME + 1];
 };
 
-int mk_s_company(void *pDest, ds_key_t kIndex);
+int mk_s_company(gen_ctx_t *pCtx, void *pDest, ds_key_t kIndex);
 int pr_s_company(void *pSrc);
 int ld_s_company(void *pSrc);
 #endif
@@ -50,7 +50,7 @@
 #include "permute.h"
 
 struct S_CUSTOMER_TBL g_s_customer;
-extern struct W_CUSTOMER_ADDRESS_TBL g_w_customer_address;
+extern THREAD struct W_CUSTOMER_ADDRESS_TBL g_w_customer_address;
 
 /*
 * Routine: 
@@ -67,7 +67,7 @@ extern struct W_CUSTOMER_ADDRESS_TBL g_w_customer_address;
 * TODO: None
 */
 int
-mk_s_customer (void *pDest, ds_key_t kIndex)
+mk_s_customer (gen_ctx_t *pCtx, void *pDest, ds_key_t kIndex)
 {
   static int bInit = 0;
   struct S_CUSTOMER_TBL *r;
@@ -169,7 +169,7 @@ mk_s_customer (void *pDest, ds_key_t kIndex)
 		   S_CUST_INCOME);
   pick_distribution (&r->pBuyPotential, "buy_potential", 1, 1,
 		     S_CUST_PURCHASE_ESTIMATE);
-  mk_w_customer_address (NULL, kIndex);
+  mk_w_customer_address (pCtx, NULL, kIndex);
 
   return (0);
 }
@@ -276,5 +276,5 @@ ld_s_customer (void *pSrc)
   else
     r = pSrc;
 
-  return (0);
+  return (pr_s_customer (r));
 }
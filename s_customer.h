@@ -35,6 +35,7 @@
  */ 
 #ifndef S_CUSTOMER_H
 #define S_CUSTOMER_H
+#include "context.h"
 
 #define RS_S_CUST_LOGIN	13
 #define RS_S_CUST_EMAIL	50
@@ -71,7 +72,7 @@ struct S_CUSTOMER_TBL {
    decimal_t	dIncome;
 };
 
-int mk_s_customer(void *pDest, ds_key_t kIndex);
+int mk_s_customer(gen_ctx_t *pCtx, void *pDest, ds_key_t kIndex);
 int pr_s_customer(void *pSrc);
 int ld_s_customer(void *pSrc);
 #endif
@@ -49,7 +49,7 @@
 #include "tdefs.h"
 #include "tdef_functions.h"
 
-extern struct W_CUSTOMER_ADDRESS_TBL g_w_customer_address;
+extern THREAD struct W_CUSTOMER_ADDRESS_TBL g_w_customer_address;
 
 /*
 * Routine: 
@@ -119,11 +119,11 @@ ld_s_customer_address(void *row)
 	else
 		r = row;
 
-	return(0);
+	return(pr_s_customer_address(r));
 }
 
 int
-vld_s_customer_address(int nTable, ds_key_t kRow, int *Permutation)
+vld_s_customer_address(gen_ctx_t *pCtx, int nTable, ds_key_t kRow, int *Permutation)
 {
-   return(validateGeneric(S_CUSTOMER_ADDRESS, kRow, Permutation));
+   return(validateGeneric(pCtx, S_CUSTOMER_ADDRESS, kRow, Permutation));
 }
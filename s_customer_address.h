@@ -35,9 +35,10 @@
  */ 
 #ifndef S_BUSINESS_ADDRESS_H
 #define S_BUSINESS_ADDRESS_H
+#include "context.h"
 
 
 int pr_s_customer_address(void *pSrc);
 int ld_s_customer_address(void *pSrc);
-int vld_s_customer_address(int nTable, ds_key_t kRow, int *Permutation);
+int vld_s_customer_address(gen_ctx_t *pCtx, int nTable, ds_key_t kRow, int *Permutation);
 #endif
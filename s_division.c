@@ -61,7 +61,7 @@ struct S_DIVISION_TBL g_s_division;
 * TODO: None
 */
 int
-mk_s_division(void *pDest, ds_key_t kIndex)
+mk_s_division(gen_ctx_t *pCtx, void *pDest, ds_key_t kIndex)
 {
 	static int bInit = 0;
 	struct S_DIVISION_TBL *r;
@@ -142,6 +142,6 @@ ld_s_division(void *pSrc)
 	else
 		r = pSrc;
 	
-	return(0);
+	return(pr_s_division(r));
 }
 
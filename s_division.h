@@ -35,6 +35,7 @@
  */ 
 #ifndef S_DIVISION_H
 #define S_DIVISION_H
+#include "context.h"
 
 #define RS_DIVISION_NAME		40
 #define RS_DIVISION_COMPANY_NAME			40
@@ -47,7 +48,7 @@ struct S_DIVISION_TBL {
 	char		szCompanyName[RS_DIVISION_COMPANY_NAME + 1];
 };
 
-int mk_s_division(void *pDest, ds_key_t kIndex);
+int mk_s_division(gen_ctx_t *pCtx, void *pDest, ds_key_t kIndex);
 int pr_s_division(void *pSrc);
 int ld_s_division(void *pSrc);
 #endif
@@ -64,7 +64,7 @@ struct S_INVENTORY_TBL g_s_inventory;
 * TODO: None
 */
 int
-mk_s_inventory(void *pDest, ds_key_t kIndex)
+mk_s_inventory(gen_ctx_t *pCtx, void *pDest, ds_key_t kIndex)
 {
 	static int bInit = 0;
 	struct S_INVENTORY_TBL *r;
@@ -162,6 +162,6 @@ ld_s_inventory(void *pSrc)
 	else
 		r = pSrc;
 	
-	return(0);
+	return(pr_s_inventory(r));
 }
 
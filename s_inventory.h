@@ -35,6 +35,7 @@
  */ 
 #ifndef S_INVENTORY_H
 #define S_INVENTORY_H
+#include "context.h"
 
 #define INVN_MIN_DATE	"1999-01-01"
 #define INVN_MAX_DATE	"2003-12-31"
@@ -50,7 +51,7 @@ struct S_INVENTORY_TBL {
 	int			quantity;
 };
 
-int mk_s_inventory(void *pDest, ds_key_t kIndex);
+int mk_s_inventory(gen_ctx_t *pCtx, void *pDest, ds_key_t kIndex);
 int pr_s_inventory(void *pSrc);
 int ld_s_inventory(void *pSrc);
 #endif
@@ -51,8 +51,7 @@
 #include "tdef_functions.h"
 #include "r_params.h"
 
-extern struct W_ITEM_TBL g_w_item;
-extern struct W_ITEM_TBL g_OldValues;
+extern THREAD struct W_ITEM_TBL g_w_item;
 /*
 * Routine: 
 * Purpose: 
@@ -68,7 +67,7 @@ extern struct W_ITEM_TBL g_OldValues;
 * TODO: None
 */
 int
-mk_s_item (void* row, ds_key_t index)
+mk_s_item (gen_ctx_t *pCtx, void* row, ds_key_t index)
 {
    static int bInit = 0;
    static int *pPermutation;
@@ -82,7 +81,7 @@ mk_s_item (void* row, ds_key_t index)
    }
 
    kIndex = getPermutationEntry(pPermutation, (int)index);
-   mk_w_item(NULL, getSKFromID(kIndex, S_ITEM_ID));
+   mk_w_item(pCtx, NULL, getSKFromID(kIndex, S_ITEM_ID));
    row_stop(ITEM);
 
    return(0);
@@ -152,11 +151,11 @@ ld_s_item(void *pSrc)
 	else
 		r = pSrc;
 	
-	return(0);
+	return(pr_s_item(r));
 }
 
 int
-vld_s_item(int nTable, ds_key_t kRow, int *Permutation)
+vld_s_item(gen_ctx_t *pCtx, int nTable, ds_key_t kRow, int *Permutation)
 {
    static int bInit = 0;
    static int *pPermutation;
@@ -169,8 +168,8 @@ vld_s_item(int nTable, ds_key_t kRow, int *Permutation)
       bInit = 1;
    }
 
-   memset(&g_OldValues, 0, sizeof(struct W_ITEM_TBL));
-   pTF->validate(S_ITEM, kRow, pPermutation);
+   memset(pCtx->Scd.pItem, 0, sizeof(struct W_ITEM_TBL));
+   pTF->validate(pCtx, S_ITEM, kRow, pPermutation);
 
    return(0);
 }
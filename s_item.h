@@ -35,9 +35,10 @@
  */ 
 #ifndef S_ITEM_H
 #define S_ITEM_H
+#include "context.h"
 
-int mk_s_item(void *row, ds_key_t kIndex);
+int mk_s_item(gen_ctx_t *pCtx, void *row, ds_key_t kIndex);
 int pr_s_item(void *pSrc);
 int ld_s_item(void *pSrc);
-int vld_s_item(int nTable, ds_key_t kIndex, int *Permutation);
+int vld_s_item(gen_ctx_t *pCtx, int nTable, ds_key_t kIndex, int *Permutation);
 #endif
@@ -61,7 +61,7 @@ struct S_MANAGER_TBL g_s_manager;
 * TODO: None
 */
 int
-mk_s_manager(void *pDest, ds_key_t kIndex)
+mk_s_manager(gen_ctx_t *pCtx, void *pDest, ds_key_t kIndex)
 {
 	static int bInit = 0;
 	struct S_MANAGER_TBL *r;
@@ -144,6 +144,6 @@ ld_s_manager(void *pSrc)
 	else
 		r = pSrc;
 	
-	return(0);
+	return(pr_s_manager(r));
 }
 
@@ -35,6 +35,7 @@
  */ 
 #ifndef S_MANAGER_H
 #define S_MANAGER_H
+#include "context.h"
 
 #define RS_S_MANAGER_NAME	500
 
@@ -43,7 +44,7 @@ struct S_MANAGER_TBL {
 	char		name[RS_S_MANAGER_NAME + 1];
 };
 
-int mk_s_manager(void *pDest, ds_key_t kIndex);
+int mk_s_manager(gen_ctx_t *pCtx, void *pDest, ds_key_t kIndex);
 int pr_s_manager(void *pSrc);
 int ld_s_manager(void *pSrc);
 #endif
@@ -61,7 +61,7 @@ struct S_MANUFACTURER_TBL g_s_manufacturer;
 * TODO: None
 */
 int
-mk_s_manufacturer(void *pDest, ds_key_t kIndex)
+mk_s_manufacturer(gen_ctx_t *pCtx, void *pDest, ds_key_t kIndex)
 {
 	static int bInit = 0;
 	struct S_MANUFACTURER_TBL *r;
@@ -140,6 +140,6 @@ ld_s_manufacturer(void *pSrc)
 	else
 		r = pSrc;
 	
-	return(0);
+	return(pr_s_manufacturer(r));
 }
 
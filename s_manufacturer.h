@@ -35,6 +35,7 @@
  */ 
 #ifndef S_MANUFACTURER_H
 #define S_MANUFACTURER_H
+#include "context.h"
 
 #define RS_S_MANUFACTURER_NAME	50
 
@@ -43,7 +44,7 @@ struct S_MANUFACTURER_TBL {
 	char		name [RS_S_MANUFACTURER_NAME + 1];
 };
 
-int mk_s_manufacturer(void *pDest, ds_key_t kIndex);
+int mk_s_manufacturer(gen_ctx_t *pCtx, void *pDest, ds_key_t kIndex);
 int pr_s_manufacturer(void *pSrc);
 int ld_s_manufacturer(void *pSrc);
 #endif
@@ -62,7 +62,7 @@ struct S_MARKET_TBL g_s_market;
 * TODO: None
 */
 int
-mk_s_market(void *pDest, ds_key_t kIndex)
+mk_s_market(gen_ctx_t *pCtx, void *pDest, ds_key_t kIndex)
 {
 	static int bInit = 0;
 	struct S_MARKET_TBL *r;
@@ -80,7 +80,7 @@ mk_s_market(void *pDest, ds_key_t kIndex)
 	
 	r->id = kIndex;
 	mk_word(r->class_name, "syllables", kIndex, RS_S_MARKET_CLASS_NAME, S_MARKET_CLASS_NAME);
-	gen_text(r->desc, 1, RS_S_MARKET_CLASS_DESC, S_MARKET_DESC);
+	gen_text(pCtx, r->desc, 1, RS_S_MARKET_CLASS_DESC, S_MARKET_DESC);
 	r->manager_id = mk_join(S_MARKET_MANAGER_ID, S_MANAGER, 1);
 	row_stop(S_MARKET);
 	
@@ -145,6 +145,6 @@ ld_s_market(void *pSrc)
 	else
 		r = pSrc;
 	
-	return(0);
+	return(pr_s_market(r));
 }
 
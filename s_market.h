@@ -35,6 +35,7 @@
  */ 
 #ifndef s_market_H
 #define s_market_H
+#include "context.h"
 
 #define RS_S_MARKET_CLASS_NAME	50
 #define RS_S_MARKET_CLASS_DESC		100
@@ -46,7 +47,7 @@ struct S_MARKET_TBL {
 	ds_key_t	manager_id;
 };
 
-int mk_s_market(void *pDest, ds_key_t kIndex);
+int mk_s_market(gen_ctx_t *pCtx, void *pDest, ds_key_t kIndex);
 int pr_s_market(void *pSrc);
 int ld_s_market(void *pSrc);
 #endif
@@ -68,7 +68,7 @@ extern int nItemIndex;
 * TODO: None
 */
 int
-mk_s_pline(void *pDest, ds_key_t kIndex)
+mk_s_pline(gen_ctx_t *pCtx, void *pDest, ds_key_t kIndex)
 {
 	static int bInit = 0;
 	struct S_PURCHASE_LINEITEM_TBL *r;
@@ -112,8 +112,8 @@ mk_s_pline(void *pDest, ds_key_t kIndex)
 
 	r->kPromotionID = mk_join(S_PLINE_PROMOTION_ID, PROMOTION, 1);
 	genrand_integer(&r->Pricing.quantity, DIST_UNIFORM, PLINE_MIN_QUANTITY, PLINE_MAX_QUANTITY, 0, S_PLINE_QUANTITY);
-	set_pricing(S_PLINE_PRICING, &r->Pricing);
-	gen_text(r->szComment, 1, RS_S_PLINE_COMMENT, S_PLINE_COMMENT);
+	set_pricing(pCtx, S_PLINE_PRICING, &r->Pricing);
+	gen_text(pCtx, r->szComment, 1, RS_S_PLINE_COMMENT, S_PLINE_COMMENT);
 	/* row_stop(S_PURCHASE_LINEITEM); */
 	
 	return(0);
@@ -181,6 +181,6 @@ ld_s_pline(void *pSrc)
 	else
 		r = pSrc;
 	
-	return(0);
+	return(pr_s_pline(r));
 }
 
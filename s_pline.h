@@ -36,6 +36,7 @@
 #ifndef S_PLINE_H
 #define S_PLINE_H
 #include "pricing.h"
+#include "context.h"
 
 #define RS_S_PLINE_COMMENT	100
 #define PLINE_MIN_QUANTITY	1
@@ -53,7 +54,7 @@ struct S_PURCHASE_LINEITEM_TBL {
 	ds_pricing_t	Pricing;
 };
 
-int mk_s_pline(void *pDest, ds_key_t kIndex);
+int mk_s_pline(gen_ctx_t *pCtx, void *pDest, ds_key_t kIndex);
 int pr_s_pline(void *pSrc);
 int ld_s_pline(void *pSrc);
 #endif
@@ -62,7 +62,7 @@ struct S_PRODUCT_TBL g_s_product;
 * TODO: None
 */
 int
-mk_s_product(void *pDest, ds_key_t kIndex)
+mk_s_product(gen_ctx_t *pCtx, void *pDest, ds_key_t kIndex)
 {
 	static int bInit = 0;
 	struct S_PRODUCT_TBL *r;
@@ -145,6 +145,6 @@ ld_s_product(void *pSrc)
 	else
 		r = pSrc;
 	
-	return(0);
+	return(pr_s_product(r));
 }
 
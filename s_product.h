@@ -35,6 +35,7 @@
  */ 
 #ifndef S_PRODUCT_H
 #define S_PRODUCT_H
+#include "context.h"
 
 #define RS_S_PRODUCT_NAME	50
 
@@ -45,7 +46,7 @@ struct S_PRODUCT_TBL {
 	char*		type;
 };
 
-int mk_s_product(void *pDest, ds_key_t kIndex);
+int mk_s_product(gen_ctx_t *pCtx, void *pDest, ds_key_t kIndex);
 int pr_s_product(void *pSrc);
 int ld_s_product(void *pSrc);
 #endif
@@ -52,7 +52,7 @@
 #include "scd.h"
 #include "r_params.h"
 
-extern struct W_PROMOTION_TBL g_w_promotion;
+extern THREAD struct W_PROMOTION_TBL g_w_promotion;
 
 
 /*
@@ -70,7 +70,7 @@ extern struct W_PROMOTION_TBL g_w_promotion;
 * TODO: None
 */
 int
-mk_s_promotion (void* row, ds_key_t index)
+mk_s_promotion (gen_ctx_t *pCtx, void* row, ds_key_t index)
 {
    static int bInit = 0;
    static int *pPermutation;
@@ -83,7 +83,7 @@ mk_s_promotion (void* row, ds_key_t index)
    }
 
    kIndex = getPermutationEntry(pPermutation, (int)index);
-   mk_w_promotion(NULL, kIndex);
+   mk_w_promotion(pCtx, NULL, kIndex);
    row_stop(PROMOTION);
 
    return(0);
@@ -161,12 +161,12 @@ ld_s_promotion(void *pSrc)
 	else
 		r = pSrc;
 	
-	return(0);
+	return(pr_s_promotion(r));
 }
 
 
 int
-vld_s_promotion(int nTable, ds_key_t kRow, int *Permutation)
+vld_s_promotion(gen_ctx_t *pCtx, int nTable, ds_key_t kRow, int *Permutation)
 {
    static int bInit = 0;
    static int *pPermutation;
@@ -183,7 +183,7 @@ vld_s_promotion(int nTable, ds_key_t kRow, int *Permutation)
    kIndex = getPermutationEntry(pPermutation, (int)kRow);
 
    row_skip(PROMOTION, kRow - 1);
-	pTF->builder(NULL, kIndex);
+	pTF->builder(pCtx, NULL, kIndex);
    row_stop(PROMOTION);
 
 	return(0);
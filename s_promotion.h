@@ -35,9 +35,10 @@
  */ 
 #ifndef S_PROMOTION_H
 #define S_PROMOTION_H
+#include "context.h"
 
-int mk_s_promotion(void *pRow, ds_key_t kIndex);
+int mk_s_promotion(gen_ctx_t *pCtx, void *pRow, ds_key_t kIndex);
 int pr_s_promotion(void *pSrc);
 int ld_s_promotion(void *pSrc);
-int vld_s_promotion(int nTable, ds_key_t kIndex, int *Permutation);
+int vld_s_promotion(gen_ctx_t *pCtx, int nTable, ds_key_t kIndex, int *Permutation);
 #endif
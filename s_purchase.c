@@ -69,7 +69,7 @@ int nItemIndex;
 * TODO: None
 */
 int
-mk_master(void *pDest, ds_key_t kIndex)
+mk_master(gen_ctx_t *pCtx, void *pDest, ds_key_t kIndex)
 {
    static int bInit = 0;
    struct S_PURCHASE_TBL *r;
@@ -93,23 +93,23 @@ mk_master(void *pDest, ds_key_t kIndex)
 	jtodt(&r->dtPurchaseDate, getUpdateDate(S_PURCHASE, kIndex));
 	genrand_integer(&r->nRegister, DIST_UNIFORM, 1, 17, 0, S_PURCHASE_REGISTER);
 	genrand_integer(&r->nClerk, DIST_UNIFORM, 101, 300, 0, S_PURCHASE_CLERK);
-	gen_text(&r->szComment[0], (int)(RS_S_PURCHASE_COMMENT * 0.6), RS_S_PURCHASE_COMMENT, S_PURCHASE_COMMENT);
+	gen_text(pCtx, &r->szComment[0], (int)(RS_S_PURCHASE_COMMENT * 0.6), RS_S_PURCHASE_COMMENT, S_PURCHASE_COMMENT);
 
    return(0);
 }
 
 int
-mk_detail(int i, int bPrint)
+mk_detail(gen_ctx_t *pCtx, int i, int bPrint)
 {
    int nTemp;
 
-		mk_s_pline(&g_s_purchase_lineitem, i);
+		mk_s_pline(pCtx, &g_s_purchase_lineitem, i);
 		if (bPrint)
          pr_s_pline(&g_s_purchase_lineitem);
 		genrand_integer(&nTemp, DIST_UNIFORM, 0, 99, 0, S_PLINE_IS_RETURNED);
 		if (nTemp < WR_RETURN_PCT)
 		{
-			mk_s_store_returns(&g_s_store_return, 1);
+			mk_s_store_returns(pCtx, &g_s_store_return, 1);
 			if (bPrint)
             pr_s_store_returns(&g_s_store_return);
 		}
@@ -160,15 +160,15 @@ pr_s_purchase(void *pSrc)
 }
 
 int
-mk_s_purchase(void *pDest, ds_key_t kIndex)
+mk_s_purchase(gen_ctx_t *pCtx, void *pDest, ds_key_t kIndex)
 {
    int i;
 
-   mk_master(pDest, kIndex);
+   mk_master(pCtx, pDest, kIndex);
    genrand_integer(&nItemIndex, DIST_UNIFORM, 1, (int)getIDCount(ITEM), 0, S_PLINE_ITEM_ID);
 	for (i=1; i <= 12; i++)
 	{
-      mk_detail(i, 1);
+      mk_detail(pCtx, i, 1);
    }
 
    return(0);
@@ -198,11 +198,11 @@ ld_s_purchase(void *pSrc)
 	else
 		r = pSrc;
 	
-	return(0);
+	return(pr_s_purchase(r));
 }
 
 int 
-vld_s_purchase(int nTable, ds_key_t kRow, int* bPermutation)
+vld_s_purchase(gen_ctx_t *pCtx, int nTable, ds_key_t kRow, int* bPermutation)
 {
    int nLineitem,
       i;
@@ -211,14 +211,14 @@ vld_s_purchase(int nTable, ds_key_t kRow, int* bPermutation)
    row_skip(S_PURCHASE_LINEITEM, (kRow - 1));
    row_skip(S_STORE_RETURNS, (kRow - 1));
 
-   mk_master(NULL, kRow);
+   mk_master(pCtx, NULL, kRow);
    genrand_integer(&nLineitem, DIST_UNIFORM, 1, 12, 0, S_PLINE_NUMBER);
    genrand_integer(&nItemIndex, DIST_UNIFORM, 1, (int)getIDCount(ITEM), 0, S_PLINE_ITEM_ID);
    for (i=1; i < nLineitem; i++)
-      mk_detail(i, 0);
+      mk_detail(pCtx, i, 0);
    print_start(S_PURCHASE_LINEITEM);
    print_key(0, (kRow - 1) * 12 + nLineitem, 1);
-   mk_detail(i, 1);
+   mk_detail(pCtx, i, 1);
 
    return(0);
 }
@@ -35,6 +35,7 @@
  */ 
 #ifndef S_PURCHASE_H
 #define S_PURCHASE_H
+#include "context.h"
 
 #define RS_S_PURCHASE_COMMENT	100
 
@@ -49,8 +50,8 @@ struct S_PURCHASE_TBL {
 	char		szComment[RS_S_PURCHASE_COMMENT + 1];
 };
 
-int mk_s_purchase(void *pDest, ds_key_t kIndex);
+int mk_s_purchase(gen_ctx_t *pCtx, void *pDest, ds_key_t kIndex);
 int pr_s_purchase(void *pSrc);
 int ld_s_purchase(void *pSrc);
-int vld_s_purchase(int nTable, ds_key_t kRow, int *pPermute);
+int vld_s_purchase(gen_ctx_t *pCtx, int nTable, ds_key_t kRow, int *pPermute);
 #endif
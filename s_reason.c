@@ -62,7 +62,7 @@ struct S_REASON_TBL g_s_reason;
 * TODO: None
 */
 int
-mk_s_reason(void *pDest, ds_key_t kIndex)
+mk_s_reason(gen_ctx_t *pCtx, void *pDest, ds_key_t kIndex)
 {
 	static int bInit = 0;
 	struct S_REASON_TBL *r;
@@ -79,7 +79,7 @@ mk_s_reason(void *pDest, ds_key_t kIndex)
 	}
 	
 	r->kID = kIndex;
-	gen_text(r->szDesc, 1, RS_S_REASON_DESC, S_REASON_DESC);
+	gen_text(pCtx, r->szDesc, 1, RS_S_REASON_DESC, S_REASON_DESC);
 	row_stop(S_REASON);
 	
 	return(0);
@@ -141,6 +141,6 @@ ld_s_reason(void *pSrc)
 	else
 		r = pSrc;
 	
-	return(0);
+	return(pr_s_reason(r));
 }
 
@@ -35,6 +35,7 @@
  */ 
 #ifndef s_reason_H
 #define s_reason_H
+#include "context.h"
 
 #define RS_S_REASON_DESC	200
 
@@ -43,7 +44,7 @@ struct S_REASON_TBL {
 	char		szDesc[RS_S_REASON_DESC + 1];
 };
 
-int mk_s_reason(void *pDest, ds_key_t kIndex);
+int mk_s_reason(gen_ctx_t *pCtx, void *pDest, ds_key_t kIndex);
 int pr_s_reason(void *pSrc);
 int ld_s_reason(void *pSrc);
 #endif
@@ -49,7 +49,7 @@
 #include "scaling.h"
 #include "scd.h"
 
-extern struct W_STORE_TBL g_w_store;
+extern THREAD struct W_STORE_TBL g_w_store;
 
 /*
 * Routine: 
@@ -66,7 +66,7 @@ extern struct W_STORE_TBL g_w_store;
 * TODO: None
 */
 int
-mk_s_store (void* row, ds_key_t index)
+mk_s_store (gen_ctx_t *pCtx, void* row, ds_key_t index)
 {
    static int bInit = 0;
    static int *pPermutation;
@@ -79,7 +79,7 @@ mk_s_store (void* row, ds_key_t index)
    }
 
    kIndex = getPermutationEntry(pPermutation, (int)index);
-   mk_w_store(NULL,getSKFromID(kIndex, S_STORE_ID));
+   mk_w_store(pCtx, NULL,getSKFromID(kIndex, S_STORE_ID));
    if (!g_w_store.closed_date_id)
       g_w_store.closed_date_id = -1; /* dates use a special NULL indicator */
 
@@ -150,6 +150,6 @@ ld_s_store(void *pSrc)
 	else
 		r = pSrc;
 	
-	return(0);
+	return(pr_s_store(r));
 }
 
@@ -35,7 +35,8 @@
  */ 
 #ifndef S_STORE_H
 #define S_STORE_H
-int mk_s_store(void *row, ds_key_t kIndex);
+#include "context.h"
+int mk_s_store(gen_ctx_t *pCtx, void *row, ds_key_t kIndex);
 int pr_s_store(void *pSrc);
 int ld_s_store(void *pSrc);
 #endif
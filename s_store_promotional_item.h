@@ -35,6 +35,7 @@
  */ 
 #ifndef S_STORE_PROMOTIONAL_ITEM_H
 #define S_STORE_PROMOTIONAL_ITEM_H
+#include "context.h"
 
 struct S_STORE_PROMOTIONAL_ITEM_TBL {
 	ds_key_t	promotion_id;
@@ -42,7 +43,7 @@ struct S_STORE_PROMOTIONAL_ITEM_TBL {
 	ds_key_t	store_id;
 };
 
-int mk_s_store_promotional_item(void *pDest, ds_key_t kIndex);
+int mk_s_store_promotional_item(gen_ctx_t *pCtx, void *pDest, ds_key_t kIndex);
 int pr_s_store_promotional_item(void *pSrc);
 int ld_s_store_promotional_item(void *pSrc);
 #endif
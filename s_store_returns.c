@@ -66,7 +66,7 @@ extern struct S_PURCHASE_LINEITEM_TBL g_s_purchase_lineitem;
 * TODO: None
 */
 int
-mk_s_store_returns(void *pDest, ds_key_t kIndex)
+mk_s_store_returns(gen_ctx_t *pCtx, void *pDest, ds_key_t kIndex)
 {
 	static int bInit = 0;
 	struct S_STORE_RETURNS_TBL *r;
@@ -95,7 +95,7 @@ mk_s_store_returns(void *pDest, ds_key_t kIndex)
 	   genrand_integer(&r->Pricing.quantity, DIST_UNIFORM, 1, g_s_purchase_lineitem.Pricing.quantity, 0, S_SRET_PRICING);
    else
       r->Pricing.quantity = -1;
-	set_pricing(S_SRET_PRICING, &r->Pricing);
+	set_pricing(pCtx, S_SRET_PRICING, &r->Pricing);
 	
 	return(0);
 }
@@ -171,6 +171,6 @@ ld_s_store_returns(void *pSrc)
 	else
 		r = pSrc;
 	
-	return(0);
+	return(pr_s_store_returns(r));
 }
 
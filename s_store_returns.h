@@ -36,6 +36,7 @@
 #ifndef S_STORE_RETURNS_H
 #define S_STORE_RETURNS_H
 #include "pricing.h"
+#include "context.h"
 
 struct S_STORE_RETURNS_TBL {
 	date_t		dtReturnDate;
@@ -45,7 +46,7 @@ struct S_STORE_RETURNS_TBL {
 
 };
 
-int mk_s_store_returns(void *pDest, ds_key_t kIndex);
+int mk_s_store_returns(gen_ctx_t *pCtx, void *pDest, ds_key_t kIndex);
 int pr_s_store_returns(void *pSrc);
 int ld_s_store_returns(void *pSrc);
 #endif
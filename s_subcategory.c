@@ -62,7 +62,7 @@ struct S_SUBCATEGORY_TBL g_s_subcategory;
 * TODO: None
 */
 int
-mk_s_subcategory(void *pDest, ds_key_t kIndex)
+mk_s_subcategory(gen_ctx_t *pCtx, void *pDest, ds_key_t kIndex)
 {
 	static int bInit = 0;
 	struct S_SUBCATEGORY_TBL *r;
@@ -81,7 +81,7 @@ mk_s_subcategory(void *pDest, ds_key_t kIndex)
 	r->kID = kIndex;
 	r->kCategoryID = mk_join(S_SBCT_CATEGORY_ID, S_CATEGORY, 1);
 	mk_word(r->szName, "Syllables", kIndex, RS_S_SBCT_NAME, S_SBCT_NAME);
-	gen_text(r->szDesc, 1, RS_S_SBCT_DESC, S_SBCT_DESC);
+	gen_text(pCtx, r->szDesc, 1, RS_S_SBCT_DESC, S_SBCT_DESC);
 	row_stop(S_SUBCATEGORY);
 	
 	return(0);
@@ -145,6 +145,6 @@ ld_s_subcategory(void *pSrc)
 	else
 		r = pSrc;
 	
-	return(0);
+	return(pr_s_subcategory(r));
 }
 
@@ -35,6 +35,7 @@
  */ 
 #ifndef S_SUBCATEGORY_H
 #define S_SUBCATEGORY_H
+#include "context.h"
 
 #define RS_S_SBCT_NAME	30
 #define RS_S_SBCT_DESC	100
@@ -46,7 +47,7 @@ struct S_SUBCATEGORY_TBL {
 	char		szDesc[RS_S_SBCT_DESC + 1];
 };
 
-int mk_s_subcategory(void *pDest, ds_key_t kIndex);
+int mk_s_subcategory(gen_ctx_t *pCtx, void *pDest, ds_key_t kIndex);
 int pr_s_subcategory(void *pSrc);
 int ld_s_subcategory(void *pSrc);
 #endif
@@ -62,7 +62,7 @@ struct S_SUBCLASS_TBL g_s_subclass;
 * TODO: None
 */
 int
-mk_s_subclass(void *pDest, ds_key_t kIndex)
+mk_s_subclass(gen_ctx_t *pCtx, void *pDest, ds_key_t kIndex)
 {
 	static int bInit = 0;
 	struct S_SUBCLASS_TBL *r;
@@ -81,7 +81,7 @@ mk_s_subclass(void *pDest, ds_key_t kIndex)
 	r->kID = kIndex;
 	r->kClassID = mk_join(S_SUBC_CLASS_ID, S_CLASS, 1);
 	mk_word(r->szName, "Syllables", kIndex, RS_S_SUBC_NAME, S_SUBC_NAME);
-	gen_text(r->szDesc, 1, RS_S_SUBC_DESC, S_SUBC_DESC);
+	gen_text(pCtx, r->szDesc, 1, RS_S_SUBC_DESC, S_SUBC_DESC);
 	row_stop(S_SUBCLASS);
 	
 	return(0);
@@ -145,6 +145,6 @@ ld_s_subclass(void *pSrc)
 	else
 		r = pSrc;
 	
-	return(0);
+	return(pr_s_subclass(r));
 }
 
@@ -35,6 +35,7 @@
  */ 
 #ifndef S_SUBCLASS_H
 #define S_SUBCLASS_H
+#include "context.h"
 
 #define RS_S_SUBC_NAME	30
 #define RS_S_SUBC_DESC	100
@@ -46,7 +47,7 @@ struct S_SUBCLASS_TBL {
 	char		szDesc[RS_S_SUBC_DESC + 1];
 };
 
-int mk_s_subclass(void *pDest, ds_key_t kIndex);
+int mk_s_subclass(gen_ctx_t *pCtx, void *pDest, ds_key_t kIndex);
 int pr_s_subclass(void *pSrc);
 int ld_s_subclass(void *pSrc);
 #endif
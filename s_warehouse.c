@@ -48,7 +48,7 @@
 #include "permute.h"
 #include "scaling.h"
 
-struct W_WAREHOUSE_TBL g_w_warehouse;
+extern THREAD struct W_WAREHOUSE_TBL g_w_warehouse;
 
 /*
 * Routine: 
@@ -65,7 +65,7 @@ struct W_WAREHOUSE_TBL g_w_warehouse;
 * TODO: None
 */
 int
-mk_s_warehouse (void* row, ds_key_t index)
+mk_s_warehouse (gen_ctx_t *pCtx, void* row, ds_key_t index)
 {
    static int bInit = 0;
    static int *pPermutation;
@@ -78,7 +78,7 @@ mk_s_warehouse (void* row, ds_key_t index)
    }
 
    kIndex = getPermutationEntry(pPermutation, (int)index);
-   mk_w_warehouse(NULL, kIndex);
+   mk_w_warehouse(pCtx, NULL, kIndex);
 
    return(0);
 }
@@ -140,6 +140,6 @@ ld_s_warehouse(void *pSrc)
 	else
 		r = pSrc;
 	
-	return(0);
+	return(pr_s_warehouse(r));
 }
 
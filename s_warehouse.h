@@ -35,8 +35,9 @@
  */ 
 #ifndef S_WAREHOUSE_H
 #define S_WAREHOUSE_H
+#include "context.h"
 
-int mk_s_warehouse(void *pRow, ds_key_t kIndex);
+int mk_s_warehouse(gen_ctx_t *pCtx, void *pRow, ds_key_t kIndex);
 int pr_s_warehouse(void *pSrc);
 int ld_s_warehouse(void *pSrc);
 #endif
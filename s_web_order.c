@@ -61,17 +61,17 @@ int nItemIndex = -1;
  ** TODO: need to make this variable, as in the warehouse
 **/
 static void 
-mk_detail(int i, int bPrint)
+mk_detail(gen_ctx_t *pCtx, int i, int bPrint)
 {
       int nTemp;
 
-		mk_s_web_order_lineitem(&g_s_web_order_lineitem, i);
+		mk_s_web_order_lineitem(pCtx, &g_s_web_order_lineitem, i);
       if (bPrint)
          pr_s_web_order_lineitem(&g_s_web_order_lineitem);
 		genrand_integer(&nTemp, DIST_UNIFORM, 0, 99, 0, S_WLIN_IS_RETURNED);
 		if (nTemp < WR_RETURN_PCT)
 		{
-			mk_s_web_return(&g_s_web_return, i);
+			mk_s_web_return(pCtx, &g_s_web_return, i);
 			if (bPrint)
             pr_s_web_return(&g_s_web_return);
 		}
@@ -80,7 +80,7 @@ return;
 }
 
 static void 
-mk_master(void *pDest, ds_key_t kIndex)
+mk_master(gen_ctx_t *pCtx, void *pDest, ds_key_t kIndex)
 {
    struct S_WEB_ORDER_TBL *r;
    int nGiftPct;
@@ -112,7 +112,7 @@ mk_master(void *pDest, ds_key_t kIndex)
 		r->kShipCustomerID = r->kBillCustomerID;
 	r->kShipModeID = mk_join(S_WORD_SHIP_MODE_ID, SHIP_MODE, 1);
 	r->kWebSiteID = mk_join(S_WORD_WEB_SITE_ID, WEB_SITE, 1);
-	gen_text(&r->szComment[0], (int)(RS_S_WORD_COMMENT * 0.6), RS_S_WORD_COMMENT, S_WORD_COMMENT);
+	gen_text(pCtx, &r->szComment[0], (int)(RS_S_WORD_COMMENT * 0.6), RS_S_WORD_COMMENT, S_WORD_COMMENT);
 	
 	return;
 }
@@ -132,15 +132,15 @@ mk_master(void *pDest, ds_key_t kIndex)
 * TODO: None
 */
 int
-mk_s_web_order(void *pDest, ds_key_t kIndex)
+mk_s_web_order(gen_ctx_t *pCtx, void *pDest, ds_key_t kIndex)
 {
    int i;
 
-   mk_master(pDest, kIndex);
+   mk_master(pCtx, pDest, kIndex);
    genrand_integer(&nItemIndex, DIST_UNIFORM, 1, (int)getIDCount(ITEM), 0, S_WLIN_ITEM_ID);
 	for (i=1; i <= 12; i++)
 	{
-      mk_detail(i, 1);
+      mk_detail(pCtx, i, 1);
    }
 
    return(0);
@@ -210,11 +210,11 @@ ld_s_web_order(void *pSrc)
 	else
 		r = pSrc;
 	
-	return(0);
+	return(pr_s_web_order(r));
 }
 
 int 
-vld_s_web_order(int nTable, ds_key_t kRow, int* bPermutation)
+vld_s_web_order(gen_ctx_t *pCtx, int nTable, ds_key_t kRow, int* bPermutation)
 {
    int nLineitem,
       i;
@@ -223,14 +223,14 @@ vld_s_web_order(int nTable, ds_key_t kRow, int* bPermutation)
    row_skip(S_WEB_ORDER_LINEITEM, kRow - 1);
    row_skip(S_WEB_RETURNS, kRow - 1);
 
-   mk_master(NULL, kRow);
+   mk_master(pCtx, NULL, kRow);
    genrand_integer(&nLineitem, DIST_UNIFORM, 1, 12, 0, S_WLIN_LINE_NUMBER);
    genrand_integer(&nItemIndex, DIST_UNIFORM, 1, (int)getIDCount(ITEM), 0, S_WLIN_ITEM_ID);
    for (i=1; i < nLineitem; i++)
-      mk_detail(i, 0);
+      mk_detail(pCtx, i, 0);
    print_start(S_WEB_ORDER_LINEITEM);
    print_key(0, (kRow - 1) * 12 + nLineitem, 1);
-   mk_detail(i, 1);
+   mk_detail(pCtx, i, 1);
 
    return(0);
 }
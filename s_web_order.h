@@ -35,6 +35,7 @@
  */ 
 #ifndef S_WEB_ORDER_H
 #define S_WEB_ORDER_H
+#include "context.h"
 
 #define RS_S_WORD_COMMENT	100
 
@@ -49,8 +50,8 @@ struct S_WEB_ORDER_TBL {
 	char		szComment[RS_S_WORD_COMMENT + 1];
 };
 
-int mk_s_web_order(void *pDest, ds_key_t kIndex);
+int mk_s_web_order(gen_ctx_t *pCtx, void *pDest, ds_key_t kIndex);
 int pr_s_web_order(void *pSrc);
 int ld_s_web_order(void *pSrc);
-int vld_s_web_order(int nTable, ds_key_t kRow, int *pPermute);
+int vld_s_web_order(gen_ctx_t *pCtx, int nTable, ds_key_t kRow, int *pPermute);
 #endif
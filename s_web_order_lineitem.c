@@ -70,7 +70,7 @@ extern int nItemIndex;
 * TODO: None
 */
 int
-mk_s_web_order_lineitem(void *pDest, ds_key_t kIndex)
+mk_s_web_order_lineitem(gen_ctx_t *pCtx, void *pDest, ds_key_t kIndex)
 {
 	static int bInit = 0;
 	struct S_WEB_ORDER_LINEITEM_TBL *r;
@@ -119,7 +119,7 @@ mk_s_web_order_lineitem(void *pDest, ds_key_t kIndex)
 	if (r->dtShipDate.julian > dtMax.julian)
 		r->dtShipDate.julian = -1;
 	r->kWebPageID = mk_join(S_WLIN_WEB_PAGE_ID, WEB_PAGE, 1);
-	set_pricing(S_WLIN_PRICING, &r->Pricing);
+	set_pricing(pCtx, S_WLIN_PRICING, &r->Pricing);
 	
 	return(0);
 }
@@ -189,7 +189,7 @@ ld_s_web_order_lineitem(void *pSrc)
 	else
 		r = pSrc;
 	
-	return(0);
+	return(pr_s_web_order_lineitem(r));
 }
 
 
@@ -213,14 +213,14 @@ vld_s_web_order_lineitem(int nTable, ds_key_t kRow, int *Permutation)
 	row_skip(nTable, kRow - 1);
 	row_skip(S_WEB_RETURNS, (kRow - 1) );
    /*
-	mk_master(NULL, kRow);
+	mk_master(pCtx, NULL, kRow);
 	genrand_integer(&nMaxLineitem, DIST_UNIFORM, 8, 16, 9, CS_ORDER_NUMBER);
 	genrand_integer(&nLineitem, DIST_UNIFORM, 1, nMaxLineitem, 0, CS_PRICING_QUANTITY);
 	for (i = 1; i < nLineitem; i++)
 	{
-		mk_detail(NULL, 0);
+		mk_detail(pCtx, NULL, 0);
 	}
-   mk_detail(NULL, 1);
+   mk_detail(pCtx, NULL, 1);
    */
 
 	return(0);
@@ -38,6 +38,7 @@
 
 #include "decimal.h"
 #include "pricing.h"
+#include "context.h"
 
 struct S_WEB_ORDER_LINEITEM_TBL {
 	ds_key_t	kOrderID;
@@ -53,7 +54,7 @@ struct S_WEB_ORDER_LINEITEM_TBL {
 	ds_pricing_t	Pricing;
 };
 
-int mk_s_web_order_lineitem(void *pDest, ds_key_t kIndex);
+int mk_s_web_order_lineitem(gen_ctx_t *pCtx, void *pDest, ds_key_t kIndex);
 int pr_s_web_order_lineitem(void *pSrc);
 int ld_s_web_order_lineitem(void *pSrc);
 #endif
@@ -49,7 +49,7 @@
 #include "scd.h"
 #include "tdef_functions.h"
 
-extern struct W_WEB_PAGE_TBL g_w_web_page;
+extern THREAD struct W_WEB_PAGE_TBL g_w_web_page;
 
 
 /*
@@ -67,7 +67,7 @@ extern struct W_WEB_PAGE_TBL g_w_web_page;
 * TODO: None
 */
 int
-mk_s_web_page (void* row, ds_key_t index)
+mk_s_web_page (gen_ctx_t *pCtx, void* row, ds_key_t index)
 {
    static int bInit = 0;
    static int *pPermutation;
@@ -80,7 +80,7 @@ mk_s_web_page (void* row, ds_key_t index)
    }
 
    kIndex = getPermutationEntry(pPermutation, (int)index);
-   mk_w_web_page(NULL, getSKFromID(kIndex, S_WPAG_ID));
+   mk_w_web_page(pCtx, NULL, getSKFromID(kIndex, S_WPAG_ID));
 
    return(0);
 }
@@ -150,11 +150,11 @@ ld_s_web_page(void *pSrc)
 	else
 		r = pSrc;
 	
-	return(0);
+	return(pr_s_web_page(r));
 }
 
 int
-vld_s_web_page(int nTable, ds_key_t kRow, int *Permutation)
+vld_s_web_page(gen_ctx_t *pCtx, int nTable, ds_key_t kRow, int *Permutation)
 {
    static int bInit = 0;
    static int *pPermutation;
@@ -167,7 +167,7 @@ vld_s_web_page(int nTable, ds_key_t kRow, int *Permutation)
       bInit = 1;
    }
 
-   pTF->validate(S_WEB_PAGE, kRow, pPermutation);
+   pTF->validate(pCtx, S_WEB_PAGE, kRow, pPermutation);
 
    return(0);
    }
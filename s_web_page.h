@@ -35,8 +35,9 @@
  */ 
 #ifndef S_WEB_PAGE_H
 #define S_WEB_PAGE_H
-int mk_s_web_page(void *pRow, ds_key_t kIndex);
+#include "context.h"
+int mk_s_web_page(gen_ctx_t *pCtx, void *pRow, ds_key_t kIndex);
 int pr_s_web_page(void *pSrc);
 int ld_s_web_page(void *pSrc);
-int vld_s_web_page(int nTable, ds_key_t kIndex, int *Permutation);
+int vld_s_web_page(gen_ctx_t *pCtx, int nTable, ds_key_t kIndex, int *Permutation);
 #endif
@@ -61,7 +61,7 @@ struct S_WEB_PROMOTIONAL_ITEM_TBL g_s_web_promotional_item;
 * TODO: None
 */
 int
-mk_s_web_promotional_item(void *pDest, ds_key_t kIndex)
+mk_s_web_promotional_item(gen_ctx_t *pCtx, void *pDest, ds_key_t kIndex)
 {
 	static int bInit = 0;
 	struct S_WEB_PROMOTIONAL_ITEM_TBL *r;
@@ -144,6 +144,6 @@ ld_s_web_promotional_item(void *pSrc)
 	else
 		r = pSrc;
 	
-	return(0);
+	return(pr_s_web_promotional_item(r));
 }
 
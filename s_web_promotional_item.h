@@ -35,6 +35,7 @@
  */ 
 #ifndef S_WEB_PROMOTIONAL_ITEM_H
 #define S_WEB_PROMOTIONAL_ITEM_H
+#include "context.h"
 
 struct S_WEB_PROMOTIONAL_ITEM_TBL {
 	ds_key_t	kSiteID;
@@ -43,7 +44,7 @@ struct S_WEB_PROMOTIONAL_ITEM_TBL {
 	ds_key_t	kPromotionID;
 };
 
-int mk_s_web_promotional_item(void *pDest, ds_key_t kIndex);
+int mk_s_web_promotional_item(gen_ctx_t *pCtx, void *pDest, ds_key_t kIndex);
 int pr_s_web_promotional_item(void *pSrc);
 int ld_s_web_promotional_item(void *pSrc);
 #endif
@@ -67,7 +67,7 @@ extern struct S_WEB_ORDER_LINEITEM_TBL g_s_web_order_lineitem;
 * TODO: None
 */
 int
-mk_s_web_return(void *pDest, ds_key_t kIndex)
+mk_s_web_return(gen_ctx_t *pCtx, void *pDest, ds_key_t kIndex)
 {
 	static int bInit = 0;
 	struct S_WEB_RETURNS_TBL *r;
@@ -106,7 +106,7 @@ mk_s_web_return(void *pDest, ds_key_t kIndex)
       r->Pricing.quantity = -1;
    else
       genrand_integer(&r->Pricing.quantity, DIST_UNIFORM, 1, g_s_web_order_lineitem.Pricing.quantity, 0, S_WRET_PRICING);
-	set_pricing(S_WRET_PRICING, &r->Pricing);
+	set_pricing(pCtx, S_WRET_PRICING, &r->Pricing);
 	r->kReasonID = mk_join(S_WRET_REASON_ID, REASON, 1);
 	
 	return(0);
@@ -183,6 +183,6 @@ ld_s_web_return(void *pSrc)
 	else
 		r = pSrc;
 	
-	return(0);
+	return(pr_s_web_return(r));
 }
 
@@ -37,6 +37,7 @@
 #define S_WEB_RETURNS_H
 
 #include "pricing.h"
+#include "context.h"
 
 struct S_WEB_RETURNS_TBL {
 	ds_key_t		kSiteID;
@@ -51,7 +52,7 @@ struct S_WEB_RETURNS_TBL {
 	ds_key_t		kReasonID;
 };
 
-int mk_s_web_return(void *pDest, ds_key_t kIndex);
+int mk_s_web_return(gen_ctx_t *pCtx, void *pDest, ds_key_t kIndex);
 int pr_s_web_return(void *pSrc);
 int ld_s_web_return(void *pSrc);
 #endif
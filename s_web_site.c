@@ -48,7 +48,7 @@
 #include "permute.h"
 #include "scd.h"
 
-struct W_WEB_SITE_TBL g_w_web_site;
+extern THREAD struct W_WEB_SITE_TBL g_w_web_site;
 
 
 /*
@@ -66,7 +66,7 @@ struct W_WEB_SITE_TBL g_w_web_site;
 * TODO: None
 */
 int
-mk_s_web_site (void* row, ds_key_t index)
+mk_s_web_site (gen_ctx_t *pCtx, void* row, ds_key_t index)
 {
    static int bInit = 0;
    static int *pPermutation;
@@ -79,7 +79,7 @@ mk_s_web_site (void* row, ds_key_t index)
    }
 
    kIndex = getPermutationEntry(pPermutation, (int)index);
-   mk_w_web_site(NULL,getSKFromID(kIndex, S_WSIT_ID));
+   mk_w_web_site(pCtx, NULL,getSKFromID(kIndex, S_WSIT_ID));
 
    return(0);
 }
@@ -146,6 +146,6 @@ ld_s_web_site(void *pSrc)
 	else
 		r = pSrc;
 	
-	return(0);
+	return(pr_s_web_site(r));
 }
 
@@ -135,7 +135,7 @@ struct ZIP_MAP  {
 * TODO: None
 */
 int
-mk_s_zip(void *pDest, ds_key_t kIndex)
+mk_s_zip(gen_ctx_t *pCtx, void *pDest, ds_key_t kIndex)
 {
 	struct S_ZIP_GMT_TBL *r;
 	static struct ZIP_MAP *pMap;
@@ -211,7 +211,7 @@ ld_s_zip(void *pSrc)
 	else
 		r = pSrc;
 	
-	return(0);
+	return(pr_s_zip(r));
 }
 
 /*
@@ -229,12 +229,12 @@ ld_s_zip(void *pSrc)
 * TODO: None
 */
 int 
-vld_s_zip(int nTable, ds_key_t kRow, int *Permutation)
+vld_s_zip(gen_ctx_t *pCtx, int nTable, ds_key_t kRow, int *Permutation)
 {
    table_func_t *pTF = getTdefFunctionsByNumber(nTable);
 
    row_skip(nTable + S_BRAND, kRow - 1);
-	if (!pTF->builder(NULL, kRow))
+	if (!pTF->builder(pCtx, NULL, kRow))
 	{
       /* there is a 600 offset for the first row */
       print_key(0, kRow - 600, 1);
@@ -35,14 +35,15 @@
  */ 
 #ifndef S_ZIP_H
 #define S_ZIP_H
+#include "context.h"
 
 struct S_ZIP_GMT_TBL {
 	char		szZip[RS_ZIPG_ZIP + 1];
 	int			nGMTOffset;
 };
 
-int mk_s_zip(void *pDest, ds_key_t kIndex);
+int mk_s_zip(gen_ctx_t *pCtx, void *pDest, ds_key_t kIndex);
 int pr_s_zip(void *pSrc);
 int ld_s_zip(void *pSrc);
-int vld_s_zip(int nTable, ds_key_t kRow, int *Permutation);
+int vld_s_zip(gen_ctx_t *pCtx, int nTable, ds_key_t kRow, int *Permutation);
 #endif
@@ -72,6 +72,22 @@ static int arScaleVolume[9] =
 void setUpdateScaling(int table);
 int	row_skip(int tbl, ds_key_t count);
 
+/*
+ * rows built on each day by the date based tables, counted from
+ * DATA_START_DATE, so that dateScaling() is a lookup and a row can be mapped
+ * to its day with a binary search; extended as far as it is needed
+ */
+static THREAD struct DATE_ROWS_T {
+	int nDays;
+	int nAllocated;
+	ds_key_t *pCount;	/* rows on day d */
+	ds_key_t *pFirst;	/* 1 + rows on all earlier days; nDays + 1 entries */
+} arDateRows[MAX_TABLE + 1];
+static THREAD int jDateRowsBase = 0;
+static ds_key_t dayScaling(int nTable, ds_key_t jDate);
+static int getDateRowsBase(void);
+static struct DATE_ROWS_T *getDateRows(int nTable, int nDays);
+
 /*
 * Routine: 
 * Purpose: 
@@ -502,7 +518,7 @@ setUpdateDates(void)
 int
 getUpdateDate(int nTable, ds_key_t kRowcount)
 {
-   static int nIndex = 0,
+   static THREAD int nIndex = 0,
       nLastTable = -1;
 
    if (nLastTable != nTable)
@@ -654,8 +670,151 @@ initializeOrderUpdates(int nParent, int nChild, int nIDColumn, int nDateColumn,
 ds_key_t
 dateScaling(int nTable, ds_key_t jDate)
 {
-	static int bInit = 0;
-	static dist_t *pDist;
+	struct DATE_ROWS_T *pRows;
+	int nDay;
+
+	nDay = (int)(jDate - getDateRowsBase());
+	if (nDay < 0)
+		return(dayScaling(nTable, jDate));
+	pRows = getDateRows(nTable, nDay + 1);
+
+	return(pRows->pCount[nDay]);
+}
+
+/*
+* Routine: getDateRowsBase(void)
+* Purpose: return the julian date of DATA_START_DATE, the first day of the per-day row tables
+* Algorithm:
+* Data Structures:
+*
+* Params:
+* Returns:
+* Called By: dateScaling(), getDayByRow()
+* Calls: 
+* Assumptions:
+* Side Effects:
+* TODO: None
+*/
+static int
+getDateRowsBase(void)
+{
+	date_t dtBase;
+
+	if (!jDateRowsBase)
+	{
+		strtodt(&dtBase, DATA_START_DATE);
+		jDateRowsBase = dtBase.julian;
+	}
+
+	return(jDateRowsBase);
+}
+
+/*
+* Routine: getDateRows(int nTable, int nDays)
+* Purpose: make sure that the per-day row table for nTable covers nDays days
+* Algorithm:
+* Data Structures: arDateRows
+*
+* Params:
+* Returns: the table
+* Called By: dateScaling(), getDayByRow()
+* Calls: dayScaling()
+* Assumptions: jDateRowsBase has been set
+* Side Effects:
+* TODO: None
+*/
+static struct DATE_ROWS_T *
+getDateRows(int nTable, int nDays)
+{
+	struct DATE_ROWS_T *pRows = &arDateRows[nTable];
+
+	if (nDays <= pRows->nDays)
+		return(pRows);
+
+	if (nDays + 1 > pRows->nAllocated)
+	{
+		pRows->nAllocated = (pRows->nAllocated)?pRows->nAllocated:512;
+		while (nDays + 1 > pRows->nAllocated)
+			pRows->nAllocated *= 2;
+		pRows->pCount = (ds_key_t *)realloc(pRows->pCount, pRows->nAllocated * sizeof(ds_key_t));
+		MALLOC_CHECK(pRows->pCount);
+		pRows->pFirst = (ds_key_t *)realloc(pRows->pFirst, pRows->nAllocated * sizeof(ds_key_t));
+		MALLOC_CHECK(pRows->pFirst);
+		if (pRows->nDays == 0)
+			pRows->pFirst[0] = 1;
+	}
+
+	while (pRows->nDays < nDays)
+	{
+		pRows->pCount[pRows->nDays] = dayScaling(nTable, jDateRowsBase + pRows->nDays);
+		pRows->pFirst[pRows->nDays + 1] = pRows->pFirst[pRows->nDays] + pRows->pCount[pRows->nDays];
+		pRows->nDays += 1;
+	}
+
+	return(pRows);
+}
+
+/*
+* Routine: getDayByRow(int nTable, ds_key_t kRow, ds_key_t *pFirst)
+* Purpose: find the first day, counted from DATA_START_DATE, whose starting row is at or after kRow
+* Algorithm: binary search of the cumulative per-day row counts
+* Data Structures: arDateRows
+*
+* Params:
+* Returns: the day; *pFirst is set to its first row
+* Called By: skipDays()
+* Calls: getDateRows()
+* Assumptions:
+* Side Effects:
+* TODO: None
+*/
+int
+getDayByRow(int nTable, ds_key_t kRow, ds_key_t *pFirst)
+{
+	struct DATE_ROWS_T *pRows;
+	int nLow,
+		nHigh,
+		nMid;
+
+	getDateRowsBase();
+	pRows = getDateRows(nTable, 1);
+	while (pRows->pFirst[pRows->nDays] < kRow)
+		pRows = getDateRows(nTable, pRows->nDays * 2);
+
+	nLow = 0;
+	nHigh = pRows->nDays;
+	while (nLow < nHigh)
+	{
+		nMid = (nLow + nHigh) / 2;
+		if (pRows->pFirst[nMid] < kRow)
+			nLow = nMid + 1;
+		else
+			nHigh = nMid;
+	}
+	*pFirst = pRows->pFirst[nLow];
+
+	return(nLow);
+}
+
+/*
+* Routine: dayScaling(int nTable, ds_key_t jDate)
+* Purpose: compute the number of rows to build for a given date and fact table
+* Algorithm:
+* Data Structures:
+*
+* Params:
+* Returns:
+* Called By: dateScaling(), getDateRows()
+* Calls: 
+* Assumptions:
+* Side Effects:
+* TODO: None
+*/
+static ds_key_t
+dayScaling(int nTable, ds_key_t jDate)
+{
+	static THREAD int bInit = 0;
+	static THREAD dist_t *pDist;
 	d_idx_t *pDistIndex;
 	date_t Date;
 	int nDateWeight = 1,
@@ -41,6 +41,7 @@ int getUpdateID(ds_key_t *pDest, int nTable, int nColumn);
 int getScaleSlot(int nTargetGB);
 int getSkewedJulianDate(int nWeight, int nColumn);
 ds_key_t dateScaling(int nColumn, ds_key_t jDate);
+int getDayByRow(int nTable, ds_key_t kRow, ds_key_t *pFirst);
 int getUpdateDate(int nTable, ds_key_t kRowcount);
 void setUpdateDates(void);
 void setUpdateScaling(int nTable);
@@ -50,21 +50,19 @@
 #include "print.h"
 #include "permute.h"
 
-/* an array of the most recent business key for each table */
-char arBKeys[MAX_TABLE][17];
-
 /*
 * Routine: setSCDKey
 * Purpose: handle the versioning and date stamps for slowly changing dimensions
 * Algorithm:
 * Data Structures:
 *
-* Params: 1 if there is a new id; 0 otherwise
-* Returns:
+* Params: szBKey: receives the business key, of at least RS_BKEY + 1 bytes
+* Returns: 1 if there is a new id; 0 otherwise
 * Called By: 
 * Calls: 
-* Assumptions: Table indexs (surrogate keys) are 1-based. This assures that the arBKeys[] entry for each table is 
-*	initialized. Otherwise, parallel generation would be more difficult.
+* Assumptions: Table indexs (surrogate keys) are 1-based. The business key of
+*	a revision is rebuilt from the index of the row that introduced it, so no
+*	state is carried from one row to the next.
 * Side Effects:
 * TODO: None
 */
@@ -73,8 +71,8 @@ setSCDKeys(int nColumnID, ds_key_t kIndex, char *szBKey, ds_key_t *pkBeginDateKe
 {
 	int bNewBKey = 0,
 		nModulo;
-	static int bInit = 0;
-	static ds_key_t jMinimumDataDate,
+	static THREAD int bInit = 0;
+	static THREAD ds_key_t jMinimumDataDate,
 		jMaximumDataDate,
 		jH1DataDate,
 		jT1DataDate,
@@ -100,35 +98,35 @@ setSCDKeys(int nColumnID, ds_key_t kIndex, char *szBKey, ds_key_t *pkBeginDateKe
 	switch(nModulo)
 	{
 	case 1: /* 1 revision */
-		mk_bkey(arBKeys[nTableID], kIndex, nColumnID);
+		mk_bkey(szBKey, kIndex, nColumnID);
 		bNewBKey = 1;
 		*pkBeginDateKey = jMinimumDataDate - nTableID * 6;
 		*pkEndDateKey = -1;
 		break;
 	case 2:	/* 1 of 2 revisions */
-		mk_bkey(arBKeys[nTableID], kIndex, nColumnID);
+		mk_bkey(szBKey, kIndex, nColumnID);
 		bNewBKey = 1;
 		*pkBeginDateKey = jMinimumDataDate - nTableID * 6;
 		*pkEndDateKey = jH1DataDate - nTableID * 6;
 		break;
 	case 3:	/* 2 of 2 revisions */
-		mk_bkey(arBKeys[nTableID], kIndex - 1, nColumnID);
+		mk_bkey(szBKey, kIndex - 1, nColumnID);
 		*pkBeginDateKey = jH1DataDate - nTableID * 6 + 1;
 		*pkEndDateKey = -1;
 		break;
 	case 4:	/* 1 of 3 revisions */
-		mk_bkey(arBKeys[nTableID], kIndex, nColumnID);
+		mk_bkey(szBKey, kIndex, nColumnID);
 		bNewBKey = 1;
 		*pkBeginDateKey = jMinimumDataDate - nTableID * 6;
 		*pkEndDateKey = jT1DataDate - nTableID * 6;
 		break;
 	case 5:	/* 2 of 3 revisions */
-		mk_bkey(arBKeys[nTableID], kIndex - 1, nColumnID);
+		mk_bkey(szBKey, kIndex - 1, nColumnID);
 		*pkBeginDateKey = jT1DataDate - nTableID * 6 + 1;
 		*pkEndDateKey = jT2DataDate - nTableID * 6;
 		break;
 	case 0:	/* 3 of 3 revisions */
-		mk_bkey(arBKeys[nTableID], kIndex - 2, nColumnID);
+		mk_bkey(szBKey, kIndex - 2, nColumnID);
 		*pkBeginDateKey = jT2DataDate - nTableID * 6 + 1;
 		*pkEndDateKey = -1;
 		break;
@@ -138,8 +136,6 @@ setSCDKeys(int nColumnID, ds_key_t kIndex, char *szBKey, ds_key_t *pkBeginDateKe
 	if (*pkEndDateKey > jMaximumDataDate)
 		*pkEndDateKey = -1;
 	
-	strcpy(szBKey, arBKeys[nTableID]);
-	
 	return(bNewBKey);
 }
 
@@ -161,7 +157,7 @@ scd_join(int tbl, int col, ds_key_t jDate)
 {
 	ds_key_t res,
 		kRowcount;
-	static int bInit = 0,
+	static THREAD int bInit = 0,
 		jMinimumDataDate,
 		jMaximumDataDate,
 		jH1DataDate,
@@ -211,10 +207,10 @@ ds_key_t
 matchSCDSK(ds_key_t kUnique, ds_key_t jDate, int nTable)
 {
 	ds_key_t kReturn = -1;
-	static int bInit = 0;
+	static THREAD int bInit = 0;
 	int jMinimumDataDate,
 		jMaximumDataDate;
-	static int jH1DataDate,
+	static THREAD int jH1DataDate,
 		jT1DataDate,
 		jT2DataDate;
 	date_t dtTemp;
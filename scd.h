@@ -36,8 +36,8 @@
 #ifndef SCD_H
 #define SCD_H
 #include "decimal.h"
+#include "context.h"
 
-extern char arBKeys[MAX_TABLE][17];
 int setSCDKeys(int nTableID, ds_key_t hgIndex, char *szBKey, ds_key_t *hgBeginDateKey, ds_key_t *hgEndDateKey);
 ds_key_t scd_join(int tbl, int col, ds_key_t jDate);
 ds_key_t matchSCDSK(ds_key_t kUnique, ds_key_t jDate, int nTable);
@@ -53,6 +53,6 @@ ds_key_t getFirstSK(ds_key_t kID);
 #define SCD_KEY	  3
 #define SCD_PTR	  4
 void	changeSCD(int nDataType, void *pNewData, void *pOldData, int *nFlags, int bFirst);
-int		validateSCD(int nTable, ds_key_t kRow, int *Permutation);
+int		validateSCD(gen_ctx_t *pCtx, int nTable, ds_key_t kRow, int *Permutation);
 void     printValidation(int nTable, ds_key_t kRow);
 #endif
@@ -40,6 +40,8 @@
 #include "sparse.h"
 #include "tdefs.h"
 #include "error_msg.h"
+#include "stable_rng.h"
+#include "runtime.h"
 
 /*
 * Routine: initSparseKeys()
@@ -105,8 +107,38 @@ randomSparseKey(int nTable, int nColumn)
 	kRowcount = get_rowcount(nTable);
 	genrand_integer(&nKeyIndex, DIST_UNIFORM, 1, (long)kRowcount, 0, nColumn);
 
+	if (g_Runtime.bStateless)
+		return(getSparseKey(nTable, nKeyIndex));
+
 	return(pTdef->arSparseKeys[nKeyIndex]);
 }
 
+/*
+* Routine: getSparseKey()
+* Purpose: compute one of the valid key values for a sparse table without
+*	materializing the key set
+* Algorithm: the key is a stable hash of the table and the key index, so
+*	it needs no storage, no set up and no shared RNG stream
+* Data Structures:
+*
+* Params: kIndex: the position of the key in the set, in [1..rowcount]
+* Returns: a key in [1..nParam]
+* Called By: randomSparseKey()
+* Calls: stable_hash(), stable_bounded()
+* Assumptions:
+* Side Effects: None; it is safe to call from any thread
+* TODO: None
+*/
+ds_key_t
+getSparseKey(int nTable, ds_key_t kIndex)
+{
+	tdef *pTdef;
+
+	pTdef = getSimpleTdefsByNumber(nTable);
+
+	return(stable_bounded(stable_hash(nTable, 0, kIndex, 
+		STABLE_SEED(g_Runtime.nScale, 0)), pTdef->nParam) + 1);
+}
+
 
 
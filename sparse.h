@@ -35,3 +35,4 @@
  */ 
 int initSparseKeys(int nTable);				/* populate the set of valid keys */
 ds_key_t randomSparseKey(int nTable, int nColumn);	/* select a random sparse key */
+ds_key_t getSparseKey(int nTable, ds_key_t kIndex);	/* compute the kIndex'th valid key */
@@ -7,28 +7,75 @@
 #include "tables.h"
 #include "tdefs.h"
 #include "scaling.h"
+#include "runtime.h"
 
 /*
  * Get the current table being generated based on the TABLE parameter
  */
 int get_current_table_id(void)
 {
-    char *tname = get_str("TABLE");
-    
-    if (!strcmp(tname, "web_sales"))
-        return WEB_SALES;
-    else if (!strcmp(tname, "web_returns"))
-        return WEB_RETURNS;
-    else if (!strcmp(tname, "catalog_sales"))
-        return CATALOG_SALES;
-    else if (!strcmp(tname, "catalog_returns"))
-        return CATALOG_RETURNS;
-    else if (!strcmp(tname, "store_sales"))
-        return STORE_SALES;
-    else if (!strcmp(tname, "store_returns"))
-        return STORE_RETURNS;
-    
-    return -1; // Unknown table
+    return g_Runtime.nTable; // -1 for any other table
+}
+
+/*
+ * Decide whether rows of a sales or returns table are written by this run.
+ * Normally only the table named by -TABLE is written; -RETURNS writes both
+ * halves of each sales/returns pair from a single pass over the sales rows.
+ */
+int is_table_printed(int table)
+{
+    if (g_Runtime.bReturns)
+        return 1;
+
+    return (g_Runtime.nTable == table);
+}
+
+/*
+ * Counter-based generator: every value is a pure function of
+ * (table, column, row, seed), so any row can be regenerated on its own and
+ * rows can be split across threads, children or shards freely.
+ *
+ * The mixing step is the SplitMix64 finalizer; each input is folded in with
+ * its own round so that neighbouring rows, columns and tables do not
+ * produce related outputs, and all 64 bits of the row number are used.
+ */
+static ds_hash_t stable_mix(ds_hash_t z)
+{
+    z += 0x9E3779B97F4A7C15ULL;
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
+
+ds_hash_t stable_hash(int table, int column, ds_key_t row, ds_key_t seed)
+{
+    ds_hash_t h;
+
+    h = stable_mix(((ds_hash_t)(unsigned int)table << 32) | (unsigned int)column);
+    h = stable_mix(h ^ (ds_hash_t)row);
+    h = stable_mix(h ^ (ds_hash_t)seed);
+
+    return h;
+}
+
+/*
+ * Reduce a hash to [0, range) without modulo bias: values below
+ * 2^64 mod range would map onto the low residues once too often, so they are
+ * rejected and the hash is remixed until it falls outside that band. The
+ * band is tiny for any realistic range, so this almost never loops.
+ */
+ds_key_t stable_bounded(ds_hash_t h, ds_key_t range)
+{
+    ds_hash_t limit;
+
+    if (range <= 1)
+        return 0;
+
+    limit = ((ds_hash_t)0 - (ds_hash_t)range) % (ds_hash_t)range;
+    while (h < limit)
+        h = stable_mix(h);
+
+    return (ds_key_t)(h % (ds_hash_t)range);
 }
 
 /*
@@ -37,16 +84,7 @@ int get_current_table_id(void)
  */
 int stable_rand_10pct(int table, int scale, ds_key_t index)
 {
-    // Use a simple hash function to create a stable pseudo-random value
-    // The hash combines table ID, scale, and index to ensure consistency
-    unsigned long hash = table * 1000000L + scale * 10000L + (index % 10000L);
-    
-    // Mix the bits to get better distribution
-    hash = hash * 1103515245L + 12345L;
-    hash = (hash / 65536L) % 32768L;
-    
-    // Return 1 if value falls in the 10% range (0-99 -> 10% chance)
-    return (hash % 100) < 10;
+    return stable_bounded(stable_hash(table, 0, index, STABLE_SEED(scale, 0)), 100) < 10;
 }
 
 /*
@@ -55,16 +93,12 @@ int stable_rand_10pct(int table, int scale, ds_key_t index)
  */
 int stable_rand_uniform(int table, int scale, ds_key_t index, int min, int max, int seed)
 {
-    // Use a hash function to create a stable pseudo-random value
-    unsigned long hash = table * 1000000L + scale * 10000L + (index % 10000L) + seed * 100L;
-    
-    // Mix the bits for better distribution
-    hash = hash * 1103515245L + 12345L;
-    hash = (hash / 65536L) % 32768L;
-    
-    // Return value in range [min, max]
-    int range = max - min + 1;
-    return min + (hash % range);
+    ds_hash_t h = stable_hash(table, seed, index, STABLE_SEED(scale, seed));
+
+    if (max <= min)
+        return min;
+
+    return min + (int)stable_bounded(h, (ds_key_t)max - min + 1);
 }
 
 /*
@@ -73,15 +107,9 @@ int stable_rand_uniform(int table, int scale, ds_key_t index, int min, int max,
  */
 int stable_rand_percentage(int table, int scale, ds_key_t index, int percentage, int seed)
 {
-    // Use a hash function to create a stable pseudo-random value
-    unsigned long hash = table * 1000000L + scale * 10000L + (index % 10000L) + seed * 100L;
-    
-    // Mix the bits for better distribution
-    hash = hash * 1103515245L + 12345L;
-    hash = (hash / 65536L) % 32768L;
-    
-    // Return 1 if value falls within the percentage range
-    return (hash % 100) < percentage;
+    ds_hash_t h = stable_hash(table, seed, index, STABLE_SEED(scale, seed));
+
+    return stable_bounded(h, 100) < percentage;
 }
 
 /*
@@ -92,16 +120,10 @@ ds_key_t stable_mk_join(int column, int table_id, int scale, ds_key_t index, int
 {
     // Get the actual row count for the table
     ds_key_t nRowCount = getIDCount(table_id);
-    
-    // Use hash to generate a stable pseudo-random key
-    unsigned long hash = table_id * 1000000L + scale * 10000L + (index % 10000L) + seed * 100L + column;
-    
-    // Mix the bits for better distribution
-    hash = hash * 1103515245L + 12345L;
-    hash = (hash / 65536L) % 32768L;
-    
+    ds_hash_t h = stable_hash(table_id, column, index, STABLE_SEED(scale, seed));
+
     // Return a value in the valid range [1, nRowCount]
-    return (hash % nRowCount) + 1;
+    return stable_bounded(h, nRowCount) + 1;
 }
 
 /*
@@ -113,18 +135,113 @@ int stable_genrand_integer(int table, int scale, ds_key_t index, int min, int ma
     return stable_rand_uniform(table, scale, index, min, max, seed);
 }
 
+/*
+ * Batch forms of the stable generators: each fills out[0 .. count-1] with
+ * exactly the values the scalar routine returns for rows first_index ..
+ * first_index + count - 1. The hashing loop is kept free of branches and
+ * calls so that the compiler can vectorize it; on x86-64 Linux it is also
+ * built for AVX2 and AVX-512 and the loader picks the widest one the CPU
+ * supports. The makefile builds this file with -O2 -ftree-vectorize so
+ * that the clones are actually vectorized in the default -g build.
+ */
+#if defined(LINUX) && defined(__GNUC__) && defined(__x86_64__)
+#define STABLE_BATCH_TARGETS __attribute__((target_clones("avx512f", "avx2", "default")))
+#else
+#define STABLE_BATCH_TARGETS
+#endif
+
+STABLE_BATCH_TARGETS
+void stable_hash_batch(int table, int column, ds_key_t first_index, int count, ds_key_t seed, ds_hash_t *out)
+{
+    ds_hash_t hBase = stable_mix(((ds_hash_t)(unsigned int)table << 32) | (unsigned int)column);
+    int i;
+
+    for (i = 0; i < count; i++)
+        out[i] = stable_mix(stable_mix(hBase ^ (ds_hash_t)(first_index + i)) ^ (ds_hash_t)seed);
+
+    return;
+}
+
+/*
+ * Reduce a block of hashes to [0, range). The rejection step of
+ * stable_bounded() is left out of the hashing loop above and done here as a
+ * scalar fix-up of the few hashes that fall in the rejected band; the limit
+ * is worked out once per block rather than once per row.
+ */
+static void stable_bounded_batch(const ds_hash_t *arHash, int count, ds_key_t range, ds_key_t *out)
+{
+    ds_hash_t limit;
+    int i;
+
+    if (range <= 1)
+    {
+        memset(out, 0, count * sizeof(ds_key_t));
+        return;
+    }
+
+    limit = ((ds_hash_t)0 - (ds_hash_t)range) % (ds_hash_t)range;
+    for (i = 0; i < count; i++)
+    {
+        if (arHash[i] < limit)
+            out[i] = stable_bounded(arHash[i], range);
+        else
+            out[i] = (ds_key_t)(arHash[i] % (ds_hash_t)range);
+    }
+
+    return;
+}
+
+/*
+ * Batch version of stable_mk_join()
+ */
+void stable_mk_join_batch(int column, int table_id, int scale, ds_key_t first_index, int count, int seed, ds_key_t *out)
+{
+    ds_key_t nRowCount = getIDCount(table_id);
+    ds_hash_t arHash[STABLE_BATCH_SIZE];
+    int i,
+        nBlock;
+
+    for (; count > 0; count -= nBlock, first_index += nBlock, out += nBlock)
+    {
+        nBlock = (count > STABLE_BATCH_SIZE)?STABLE_BATCH_SIZE:count;
+        stable_hash_batch(table_id, column, first_index, nBlock, STABLE_SEED(scale, seed), arHash);
+        stable_bounded_batch(arHash, nBlock, nRowCount, out);
+        for (i = 0; i < nBlock; i++)
+            out[i] += 1;
+    }
+
+    return;
+}
+
+/*
+ * Batch version of stable_is_null()
+ */
+void stable_is_null_batch(int table, int scale, ds_key_t first_index, int count, int column, int null_pct, int *out)
+{
+    ds_hash_t arHash[STABLE_BATCH_SIZE];
+    ds_key_t arPct[STABLE_BATCH_SIZE];
+    int i,
+        nBlock;
+
+    for (; count > 0; count -= nBlock, first_index += nBlock, out += nBlock)
+    {
+        nBlock = (count > STABLE_BATCH_SIZE)?STABLE_BATCH_SIZE:count;
+        stable_hash_batch(table, column, first_index, nBlock, STABLE_SEED(scale, 0), arHash);
+        stable_bounded_batch(arHash, nBlock, 100, arPct);
+        for (i = 0; i < nBlock; i++)
+            out[i] = arPct[i] < null_pct;
+    }
+
+    return;
+}
+
 /*
  * Stable function to determine if a field should be NULL
  */
 int stable_is_null(int table, int scale, ds_key_t index, int column, int null_pct)
 {
-    // Use hash to determine if this field should be NULL
-    unsigned long hash = table * 1000000L + scale * 10000L + (index % 10000L) + column * 100L;
-    
-    // Mix the bits
-    hash = hash * 1103515245L + 12345L;
-    hash = (hash / 65536L) % 32768L;
-    
+    ds_hash_t h = stable_hash(table, column, index, STABLE_SEED(scale, 0));
+
     // Return 1 if should be NULL based on percentage
-    return (hash % 100) < null_pct;
-}
\ No newline at end of file
+    return stable_bounded(h, 100) < null_pct;
+}
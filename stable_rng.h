@@ -1,14 +1,33 @@
 #ifndef STABLE_RNG_H
 #define STABLE_RNG_H
 
+#include <stdint.h>
 #include "r_params.h"
 
+/* full width output of the counter-based generator */
+typedef uint64_t ds_hash_t;
+
+/*
+ * the scale factor is part of the seed, so that a given row differs from one
+ * scale to the next just as it does with the sequential generator
+ */
+#define STABLE_SEED(scale, seed)  (((ds_key_t)(scale) << 32) | (unsigned int)(seed))
+
+/* natural block size for the batch routines */
+#define STABLE_BATCH_SIZE	64
+
+ds_hash_t stable_hash(int table, int column, ds_key_t row, ds_key_t seed);
+ds_key_t stable_bounded(ds_hash_t h, ds_key_t range);
 int stable_rand_10pct(int table, int scale, ds_key_t index);
 int get_current_table_id(void);
+int is_table_printed(int table);
 int stable_rand_uniform(int table, int scale, ds_key_t index, int min, int max, int seed);
 int stable_rand_percentage(int table, int scale, ds_key_t index, int percentage, int seed);
 ds_key_t stable_mk_join(int column, int table, int scale, ds_key_t index, int seed);
 int stable_genrand_integer(int table, int scale, ds_key_t index, int min, int max, int seed);
 int stable_is_null(int table, int scale, ds_key_t index, int column, int null_pct);
+void stable_hash_batch(int table, int column, ds_key_t first_index, int count, ds_key_t seed, ds_hash_t *out);
+void stable_mk_join_batch(int column, int table, int scale, ds_key_t first_index, int count, int seed, ds_key_t *out);
+void stable_is_null_batch(int table, int scale, ds_key_t first_index, int count, int column, int null_pct, int *out);
 
 #endif /* STABLE_RNG_H */
\ No newline at end of file
@@ -0,0 +1,441 @@
+/* 
+ * Legal Notice 
+ * 
+ * This document and associated source code (the "Work") is a part of a 
+ * benchmark specification maintained by the TPC. 
+ * 
+ * The TPC reserves all right, title, and interest to the Work as provided 
+ * under U.S. and international laws, including without limitation all patent 
+ * and trademark rights therein. 
+ * 
+ * No Warranty 
+ * 
+ * 1.1 TO THE MAXIMUM EXTENT PERMITTED BY APPLICABLE LAW, THE INFORMATION 
+ *     CONTAINED HEREIN IS PROVIDED "AS IS" AND WITH ALL FAULTS, AND THE 
+ *     AUTHORS AND DEVELOPERS OF THE WORK HEREBY DISCLAIM ALL OTHER 
+ *     WARRANTIES AND CONDITIONS, EITHER EXPRESS, IMPLIED OR STATUTORY, 
+ *     INCLUDING, BUT NOT LIMITED TO, ANY (IF ANY) IMPLIED WARRANTIES, 
+ *     DUTIES OR CONDITIONS OF MERCHANTABILITY, OF FITNESS FOR A PARTICULAR 
+ *     PURPOSE, OF ACCURACY OR COMPLETENESS OF RESPONSES, OF RESULTS, OF 
+ *     WORKMANLIKE EFFORT, OF LACK OF VIRUSES, AND OF LACK OF NEGLIGENCE. 
+ *     ALSO, THERE IS NO WARRANTY OR CONDITION OF TITLE, QUIET ENJOYMENT, 
+ *     QUIET POSSESSION, CORRESPONDENCE TO DESCRIPTION OR NON-INFRINGEMENT 
+ *     WITH REGARD TO THE WORK. 
+ * 1.2 IN NO EVENT WILL ANY AUTHOR OR DEVELOPER OF THE WORK BE LIABLE TO 
+ *     ANY OTHER PARTY FOR ANY DAMAGES, INCLUDING BUT NOT LIMITED TO THE 
+ *     COST OF PROCURING SUBSTITUTE GOODS OR SERVICES, LOST PROFITS, LOSS 
+ *     OF USE, LOSS OF DATA, OR ANY INCIDENTAL, CONSEQUENTIAL, DIRECT, 
+ *     INDIRECT, OR SPECIAL DAMAGES WHETHER UNDER CONTRACT, TORT, WARRANTY,
+ *     OR OTHERWISE, ARISING IN ANY WAY OUT OF THIS OR ANY OTHER AGREEMENT 
+ *     RELATING TO THE WORK, WHETHER OR NOT SUCH AUTHOR OR DEVELOPER HAD 
+ *     ADVANCE NOTICE OF THE POSSIBILITY OF SUCH DAMAGES. 
+ * 
+ * Contributors:
+ * Gradient Systems
+ */ 
+#include "config.h"
+#include "porting.h"
+#include <stdio.h>
+#include <time.h>
+#ifdef USE_STDLIB_H
+#include <stdlib.h>
+#else
+#include <malloc.h>
+#endif
+#include "r_params.h"
+#include "tdefs.h"
+#include "runtime.h"
+#include "stats.h"
+
+/*
+ * one record per chunk of a table; threads keep their current record to 
+ * themselves and only take the lock to add it to the list
+ */
+typedef struct STATS_T {
+	int nTable;
+	int nChunk;
+	ds_key_t kBuilt;	/* calls to the builder */
+	ds_key_t kPrinted;	/* rows printed for nTable */
+	ds_key_t kChildRows;	/* rows printed for its child table */
+	ds_key_t kBytes;
+	ds_key_t kWall;
+	ds_key_t kCpu;
+	ds_key_t kPrint;	/* print_start() to print_end(), less any writes */
+	ds_key_t kWrite;	/* write() calls */
+	ds_key_t kBuild;	/* whatever is not printing or writing */
+	ds_key_t kStart;
+	ds_key_t kCpuStart;
+	ds_key_t kPrintStart;
+	struct STATS_T *pNext;
+} stats_t;
+
+static stats_t *pStatsHead = NULL,
+	*pStatsTail = NULL;
+static THREAD stats_t *pCurrent = NULL;
+static THREAD int bInPrint = 0;
+DECLARE_LOCK(StatsLock);
+
+/*
+* Routine: stats_cpu()
+* Purpose: CPU time used by the calling thread
+* Algorithm:
+* Data Structures:
+*
+* Params:
+* Returns: nanoseconds
+* Called By: 
+* Calls: 
+* Assumptions:
+* Side Effects:
+* TODO: None
+*/
+static ds_key_t
+stats_cpu(void)
+{
+#ifdef WIN32
+	return((ds_key_t)clock() * (1000000000 / CLOCKS_PER_SEC));
+#else
+	struct timespec t;
+
+	clock_gettime(CLOCK_THREAD_CPUTIME_ID, &t);
+	return((ds_key_t)t.tv_sec * 1000000000 + t.tv_nsec);
+#endif
+}
+
+/*
+* Routine: stats_clock()
+* Purpose: read a monotonic wall clock
+* Algorithm:
+* Data Structures:
+*
+* Params:
+* Returns: nanoseconds
+* Called By: 
+* Calls: 
+* Assumptions:
+* Side Effects:
+* TODO: None
+*/
+ds_key_t
+stats_clock(void)
+{
+#ifdef WIN32
+	return((ds_key_t)clock() * (1000000000 / CLOCKS_PER_SEC));
+#else
+	struct timespec t;
+
+	clock_gettime(CLOCK_MONOTONIC, &t);
+	return((ds_key_t)t.tv_sec * 1000000000 + t.tv_nsec);
+#endif
+}
+
+/*
+* Routine: stats_add(stats_t *pStats)
+* Purpose: append a finished record to the list
+* Algorithm:
+* Data Structures:
+*
+* Params:
+* Returns:
+* Called By: 
+* Calls: 
+* Assumptions:
+* Side Effects:
+* TODO: None
+*/
+static void
+stats_add(stats_t *pStats)
+{
+	LOCK(StatsLock);
+	if (pStatsTail)
+		pStatsTail->pNext = pStats;
+	else
+		pStatsHead = pStats;
+	pStatsTail = pStats;
+	UNLOCK(StatsLock);
+
+	return;
+}
+
+/*
+* Routine: stats_start(int nTable, int nChunk, ds_key_t kRows)
+* Purpose: start counting for a chunk of a table in the calling thread
+* Algorithm:
+* Data Structures:
+*
+* Params: kRows: the number of times the builder will be called
+* Returns:
+* Called By: gen_tbl(), gen_chunk(), gen_threads()
+* Calls: 
+* Assumptions:
+* Side Effects:
+* TODO: None
+*/
+void
+stats_start(int nTable, int nChunk, ds_key_t kRows)
+{
+	stats_t *pStats;
+
+	if (!g_Runtime.bStats)
+		return;
+
+	pStats = (stats_t *)malloc(sizeof(stats_t));
+	MALLOC_CHECK(pStats);
+	memset(pStats, 0, sizeof(stats_t));
+	pStats->nTable = nTable;
+	pStats->nChunk = nChunk;
+	pStats->kBuilt = kRows;
+	pStats->kCpuStart = stats_cpu();
+	pStats->kStart = stats_clock();
+	pCurrent = pStats;
+
+	return;
+}
+
+/*
+* Routine: stats_end()
+* Purpose: close the chunk started by stats_start()
+* Algorithm:
+* Data Structures:
+*
+* Params:
+* Returns:
+* Called By: gen_tbl(), gen_chunk(), gen_threads()
+* Calls: 
+* Assumptions:
+* Side Effects:
+* TODO: None
+*/
+void
+stats_end(void)
+{
+	if (pCurrent == NULL)
+		return;
+
+	pCurrent->kWall = stats_clock() - pCurrent->kStart;
+	pCurrent->kCpu = stats_cpu() - pCurrent->kCpuStart;
+	pCurrent->kBuild = pCurrent->kWall - pCurrent->kPrint - pCurrent->kWrite;
+	stats_add(pCurrent);
+	pCurrent = NULL;
+
+	return;
+}
+
+/*
+* Routine: stats_table(int nTable, ds_key_t kWall)
+* Purpose: add a summary for a table that was split between threads
+* Algorithm: the counters are summed from the chunk records when the
+*	report is written; only the elapsed time of the table is recorded here
+* Data Structures:
+*
+* Params:
+* Returns:
+* Called By: gen_tbl()
+* Calls: 
+* Assumptions:
+* Side Effects:
+* TODO: None
+*/
+void
+stats_table(int nTable, ds_key_t kWall)
+{
+	stats_t *pStats;
+
+	if (!g_Runtime.bStats)
+		return;
+
+	pStats = (stats_t *)malloc(sizeof(stats_t));
+	MALLOC_CHECK(pStats);
+	memset(pStats, 0, sizeof(stats_t));
+	pStats->nTable = nTable;
+	pStats->nChunk = STATS_TOTAL;
+	pStats->kWall = kWall;
+	stats_add(pStats);
+
+	return;
+}
+
+/*
+* Routine: stats_print_start()
+* Purpose: note the start of formatting a row
+* Algorithm:
+* Data Structures:
+*
+* Params:
+* Returns:
+* Called By: print_start()
+* Calls: 
+* Assumptions:
+* Side Effects:
+* TODO: None
+*/
+void
+stats_print_start(void)
+{
+	if (pCurrent == NULL)
+		return;
+
+	pCurrent->kPrintStart = stats_clock();
+	bInPrint = 1;
+
+	return;
+}
+
+/*
+* Routine: stats_print_end(int nTable)
+* Purpose: count a printed row, and the time spent formatting it
+* Algorithm:
+* Data Structures:
+*
+* Params:
+* Returns:
+* Called By: print_end()
+* Calls: 
+* Assumptions:
+* Side Effects:
+* TODO: None
+*/
+void
+stats_print_end(int nTable)
+{
+	if (pCurrent == NULL)
+		return;
+
+	pCurrent->kPrint += stats_clock() - pCurrent->kPrintStart;
+	bInPrint = 0;
+	if (nTable == pCurrent->nTable)
+		pCurrent->kPrinted += 1;
+	else
+		pCurrent->kChildRows += 1;
+
+	return;
+}
+
+/*
+* Routine: stats_write(ds_key_t kBytes, ds_key_t kTime)
+* Purpose: account for output handed to the operating system
+* Algorithm: a write made while a row is being formatted is taken back out
+*	of the print time, so that builder, print and write times do not overlap
+* Data Structures:
+*
+* Params:
+* Returns:
+* Called By: print_flush(), print_merge()
+* Calls: 
+* Assumptions:
+* Side Effects:
+* TODO: None
+*/
+void
+stats_write(ds_key_t kBytes, ds_key_t kTime)
+{
+	if (pCurrent == NULL)
+		return;
+
+	pCurrent->kBytes += kBytes;
+	pCurrent->kWrite += kTime;
+	if (bInPrint)
+		pCurrent->kPrint -= kTime;
+
+	return;
+}
+
+/*
+* Routine: stats_line(stats_t *pStats)
+* Purpose: write one record in key=value form
+* Algorithm:
+* Data Structures:
+*
+* Params:
+* Returns:
+* Called By: stats_report()
+* Calls: 
+* Assumptions:
+* Side Effects:
+* TODO: None
+*/
+static void
+stats_line(stats_t *pStats)
+{
+	char szChunk[16];
+
+	switch(pStats->nChunk)
+	{
+	case STATS_MERGE: strcpy(szChunk, "merge"); break;
+	case STATS_TOTAL: strcpy(szChunk, "total"); break;
+	default: sprintf(szChunk, "%d", pStats->nChunk); break;
+	}
+
+	fprintf(stderr, "STATS table=%s child=%d chunk=%s", 
+		getTableNameByID(pStats->nTable), 
+		is_set("PARALLEL")?get_int("CHILD"):1, szChunk);
+	fprintf(stderr, " rows_built=" HUGE_FORMAT " rows_printed=" HUGE_FORMAT " child_rows=" HUGE_FORMAT " bytes=" HUGE_FORMAT,
+		(long long)pStats->kBuilt, (long long)pStats->kPrinted, 
+		(long long)pStats->kChildRows, (long long)pStats->kBytes);
+	fprintf(stderr, " wall=%.6f cpu=%.6f rows_per_sec=%.0f build=%.6f print=%.6f write=%.6f\n",
+		pStats->kWall / 1e9, pStats->kCpu / 1e9,
+		(pStats->kWall > 0)?(pStats->kPrinted + pStats->kChildRows) * 1e9 / pStats->kWall:0.0,
+		pStats->kBuild / 1e9, pStats->kPrint / 1e9, pStats->kWrite / 1e9);
+
+	return;
+}
+
+/*
+* Routine: stats_report()
+* Purpose: write the -STATS report to stderr
+* Algorithm: records are written in the order they were closed; the total for
+*	a threaded table sums the rows and bytes of its chunks and the times of 
+*	its chunks and of the merge, but keeps its own elapsed time, so build, 
+*	print and write are thread seconds and may add up to more than wall
+* Data Structures:
+*
+* Params:
+* Returns:
+* Called By: main()
+* Calls: 
+* Assumptions: all worker threads have finished
+* Side Effects:
+* TODO: None
+*/
+void
+stats_report(void)
+{
+	stats_t *pStats,
+		*pChunk,
+		Sum;
+
+	for (pStats = pStatsHead; pStats; pStats = pStats->pNext)
+	{
+		if (pStats->nChunk == STATS_TOTAL)
+		{
+			memset(&Sum, 0, sizeof(stats_t));
+			for (pChunk = pStatsHead; pChunk != pStats; pChunk = pChunk->pNext)
+			{
+				if (pChunk->nTable != pStats->nTable)
+					continue;
+				/* only count the chunks since the table was last built */
+				if (pChunk->nChunk == STATS_TOTAL)
+					memset(&Sum, 0, sizeof(stats_t));
+				if (pChunk->nChunk >= 0)
+				{
+					Sum.kBuilt += pChunk->kBuilt;
+					Sum.kPrinted += pChunk->kPrinted;
+					Sum.kChildRows += pChunk->kChildRows;
+					Sum.kBytes += pChunk->kBytes;
+				}
+				Sum.kCpu += pChunk->kCpu;
+				Sum.kBuild += pChunk->kBuild;
+				Sum.kPrint += pChunk->kPrint;
+				Sum.kWrite += pChunk->kWrite;
+			}
+			Sum.nTable = pStats->nTable;
+			Sum.nChunk = STATS_TOTAL;
+			Sum.kWall = pStats->kWall;
+			stats_line(&Sum);
+		}
+		else
+			stats_line(pStats);
+	}
+
+	return;
+}
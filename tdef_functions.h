@@ -36,6 +36,7 @@
 #ifndef TDEF_FUNCTIONS_H
 #define TDEF_FUNCTIONS_H
 #include "tables.h"
+#include "context.h"
 
 
 /*
@@ -46,18 +47,18 @@
 */
 typedef struct TABLE_FUNC_T {
 	char *name;							/* -- name of the table; */
-	int (*builder)(void*, ds_key_t);	/* -- function to prep output */
+	int (*builder)(gen_ctx_t *, void*, ds_key_t);	/* -- function to prep output */
 	int (*loader[2])(void *);			/* -- functions to present output */
    /* -- data validation function */
-	int (*validate)(int nTable, ds_key_t kRow, int *Permutation);
+	int (*validate)(gen_ctx_t *pCtx, int nTable, ds_key_t kRow, int *Permutation);
 	} table_func_t;
 
 extern table_func_t w_tdef_funcs[MAX_TABLE];
 extern table_func_t s_tdef_funcs[MAX_TABLE];
 extern table_func_t *tdef_funcs;
 
-int validateGeneric(int nTable, ds_key_t kRow, int *Permutation);
-int validateSCD(int nTable, ds_key_t kRow, int *Permutation);
+int validateGeneric(gen_ctx_t *pCtx, int nTable, ds_key_t kRow, int *Permutation);
+int validateSCD(gen_ctx_t *pCtx, int nTable, ds_key_t kRow, int *Permutation);
 
 #endif /* TDEF_FUNCTIONS_H */
 extern table_func_t s_tdef_funcs[];
@@ -46,8 +46,8 @@
 #include "tdef_functions.h"
 #include "r_params.h"
 
-extern tdef w_tdefs[];
-extern tdef s_tdefs[];
+extern THREAD tdef w_tdefs[];
+extern THREAD tdef s_tdefs[];
 extern table_func_t s_tdef_funcs[];
 extern table_func_t w_tdef_funcs[];
 
@@ -227,3 +227,54 @@ getTableFromColumn(int nColumn)
 	}
 	return(-1);
 }
+
+/*
+* Routine: saveTdefs(void)
+* Purpose: take a copy of the table definitions, including the per-table
+*	flags and output handles set while processing the command line
+* Algorithm:
+* Data Structures:
+*
+* Params:
+* Returns: a newly allocated copy of w_tdefs[] followed by s_tdefs[]
+* Called By: gen_tbl()
+* Calls: 
+* Assumptions:
+* Side Effects:
+* TODO: None
+*/
+tdef *
+saveTdefs(void)
+{
+	tdef *pSaved;
+
+	pSaved = (tdef *)malloc(sizeof(w_tdefs) + sizeof(s_tdefs));
+	MALLOC_CHECK(pSaved);
+	memcpy(pSaved, w_tdefs, sizeof(w_tdefs));
+	memcpy((char *)pSaved + sizeof(w_tdefs), s_tdefs, sizeof(s_tdefs));
+
+	return(pSaved);
+}
+
+/*
+* Routine: restoreTdefs(tdef *pSaved)
+* Purpose: load the table definitions captured by saveTdefs()
+* Algorithm:
+* Data Structures:
+*
+* Params:
+* Returns:
+* Called By: worker threads started by gen_tbl()
+* Calls: 
+* Assumptions: the tdefs are thread local, so this only affects the caller
+* Side Effects:
+* TODO: None
+*/
+void
+restoreTdefs(tdef *pSaved)
+{
+	memcpy(w_tdefs, pSaved, sizeof(w_tdefs));
+	memcpy(s_tdefs, (char *)pSaved + sizeof(w_tdefs), sizeof(s_tdefs));
+
+	return;
+}
@@ -98,6 +98,8 @@ int getTableFromColumn(int id);
 int initSpareKeys(int id);
 tdef *getSimpleTdefsByNumber(int nTable);
 tdef *getTdefsByNumber(int nTable);
+tdef *saveTdefs(void);
+void restoreTdefs(tdef *pSaved);
 
 
 #endif
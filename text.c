@@ -42,6 +42,7 @@
 #include "date.h"
 #include "genrand.h"
 #include "dist.h"
+#include "context.h"
 
 /*
  * Routine: mk_sentence()
@@ -57,50 +58,71 @@
  * Side Effects:
  * TODO: None
  */
-static int used_space = 0; /* current length of the sentence being built */
 #define SPACE_INCREMENT	100
 
 static char *
-mk_sentence(int stream)
+mk_sentence(gen_ctx_t *pCtx, int stream)
 {
-	static char *verbiage = NULL;
-	static int allocated_space = 0;
+	text_state_t *pS = &pCtx->Text;
+	static THREAD d_idx_t *pSentences = NULL,
+		*pNouns,
+		*pVerbs,
+		*pAdjectives,
+		*pAdverbs,
+		*pAuxiliaries,
+		*pPrepositions,
+		*pArticles,
+		*pTerminators;
 	int word_len;
 	char *syntax, 
 		*cp,
 		*word = NULL,
 		temp[2];
 
+	/* a sentence takes a dozen or so picks, so look the distributions up once */
+	if (pSentences == NULL)
+	{
+		pNouns = find_dist("nouns");
+		pVerbs = find_dist("verbs");
+		pAdjectives = find_dist("adjectives");
+		pAdverbs = find_dist("adverbs");
+		pAuxiliaries = find_dist("auxiliaries");
+		pPrepositions = find_dist("prepositions");
+		pArticles = find_dist("articles");
+		pTerminators = find_dist("terminators");
+		pSentences = find_dist("sentences");
+	}
+
 	temp[1] = '\0';
-	pick_distribution(&syntax, "sentences", 1, 1, stream);
+	pick_distribution_idx(&syntax, pSentences, 1, 1, stream);
 
 	for (cp = syntax; *cp; cp++)
 	{
 		switch(*cp)
 		{
 		case 'N':	/* pick a noun */
-			pick_distribution(&word, "nouns", 1, 1, stream);
+			pick_distribution_idx(&word, pNouns, 1, 1, stream);
 			break;
 		case 'V':	/* pick a verb */
-			pick_distribution(&word, "verbs", 1, 1, stream);
+			pick_distribution_idx(&word, pVerbs, 1, 1, stream);
 			break;
 		case 'J':	/* pick a adjective */
-			pick_distribution(&word, "adjectives", 1, 1, stream);
+			pick_distribution_idx(&word, pAdjectives, 1, 1, stream);
 			break;
 		case 'D':	/* pick a adverb */
-			pick_distribution(&word, "adverbs", 1, 1, stream);
+			pick_distribution_idx(&word, pAdverbs, 1, 1, stream);
 			break;
 		case 'X':	/* pick a auxiliary verb */
-			pick_distribution(&word, "auxiliaries", 1, 1, stream);
+			pick_distribution_idx(&word, pAuxiliaries, 1, 1, stream);
 			break;
 		case 'P':	/* pick a preposition */
-			pick_distribution(&word, "prepositions", 1, 1, stream);
+			pick_distribution_idx(&word, pPrepositions, 1, 1, stream);
 			break;
 		case 'A':	/* pick an article */
-			pick_distribution(&word, "articles", 1, 1, stream);
+			pick_distribution_idx(&word, pArticles, 1, 1, stream);
 			break;
 		case 'T':	/* pick an terminator */
-			pick_distribution(&word, "terminators", 1, 1, stream);
+			pick_distribution_idx(&word, pTerminators, 1, 1, stream);
 			break;
 		default:
 			temp[0] = *cp;
@@ -112,22 +134,22 @@ mk_sentence(int stream)
 		else
 			word_len = strlen(word);
 		
-		if (used_space + word_len >= allocated_space)
+		if (pS->nUsed + word_len >= pS->nAllocated)
 			{
-			verbiage = (char *)realloc(verbiage, allocated_space + SPACE_INCREMENT);
-			MALLOC_CHECK(verbiage);
-			allocated_space += SPACE_INCREMENT;
+			pS->szVerbiage = (char *)realloc(pS->szVerbiage, pS->nAllocated + SPACE_INCREMENT);
+			MALLOC_CHECK(pS->szVerbiage);
+			pS->nAllocated += SPACE_INCREMENT;
 			}
 		
 		if (word == NULL)
-			strcpy(&verbiage[used_space], temp);
+			strcpy(&pS->szVerbiage[pS->nUsed], temp);
 		else
-			strcpy(&verbiage[used_space], word);
-		used_space += word_len;
+			strcpy(&pS->szVerbiage[pS->nUsed], word);
+		pS->nUsed += word_len;
 		word = NULL;
 	}
 
-	return(verbiage);
+	return(pS->szVerbiage);
 }
 
 	
@@ -151,14 +173,14 @@ mk_sentence(int stream)
  * TODO: None
  */
 char *
-gen_text(char *dest, int min, int max, int stream)
+gen_text(gen_ctx_t *pCtx, char *dest, int min, int max, int stream)
 {
 	int target_len,
 		generated_length,
 		capitalize = 1;
 	char *s;
 
-	used_space = 0;
+	pCtx->Text.nUsed = 0;
 	genrand_integer(&target_len, DIST_UNIFORM, min, max, 0, stream);
 	if (dest)
 		*dest = '\0';
@@ -171,8 +193,8 @@ gen_text(char *dest, int min, int max, int stream)
 
 	while (target_len > 0)
 		{
-		used_space = 0;
-		s = mk_sentence(stream);
+		pCtx->Text.nUsed = 0;
+		s = mk_sentence(pCtx, stream);
 		if (capitalize)
 			*s = toupper(*s);
 		generated_length = strlen(s);
@@ -213,12 +235,14 @@ main()
 {
 	char test_dest[201];
 	int i;
+	gen_ctx_t *pCtx;
 
 	init_params();
+	pCtx = ctx_new();
 
 	for (i=0; i < 100; i++)
 		{
-		gen_text(test_dest, 100, 200, 1);
+		gen_text(pCtx, test_dest, 100, 200, 1);
 		printf("%s\n", test_dest);
 		test_dest[0] = '\0';
 		}
@@ -61,7 +61,7 @@
 * TODO: None
 */
 int 
-validateGeneric(int nTable, ds_key_t kRow, int *Permute)
+validateGeneric(gen_ctx_t *pCtx, int nTable, ds_key_t kRow, int *Permute)
 {
    tdef *pT = getSimpleTdefsByNumber(nTable);
    tdef *pChild;
@@ -95,28 +95,29 @@ validateGeneric(int nTable, ds_key_t kRow, int *Permute)
       pChild = getSimpleTdefsByNumber(pT->nParam);
 		row_skip(pT->nParam, kRow - 1);
    }
-   pTF->builder(NULL, kRow);
+   pTF->builder(pCtx, NULL, kRow);
 
 	return(0);
 }
 
 
 /*
-* Routine: 
-* Purpose: 
-* Algorithm:
+* Routine: buildSCD(gen_ctx_t *pCtx, int nTable, ds_key_t kRow, int *Permutation, void *pRow)
+* Purpose: rebuild a single revision of a slowly changing dimension
+* Algorithm: each revision is built from the one before it, so back up to the
+*	first revision of the business key and build forward from there
 * Data Structures:
 *
-* Params:
+* Params: pRow receives the target row; NULL leaves it in the builder's global
 * Returns:
-* Called By: 
+* Called By: validateSCD(), rebuildRow()
 * Calls: 
 * Assumptions:
 * Side Effects:
 * TODO: None
 */
-int 
-validateSCD(int nTable, ds_key_t kRow, int *Permutation)
+static int 
+buildSCD(gen_ctx_t *pCtx, int nTable, ds_key_t kRow, int *Permutation, void *pRow)
 {
 	ds_key_t kStart, 
       kEnd;
@@ -156,21 +157,69 @@ validateSCD(int nTable, ds_key_t kRow, int *Permutation)
 
       /* back up to the base row for SCD's */
       if ((!setSCDKeys(nColumn, nID, &szID[0], &kStart, &kEnd)) && (kRow > 1))
-         validateSCD(nTable, kRow - 1, Permutation);
+         buildSCD(pCtx, nTable, kRow - 1, Permutation, NULL);
 
 	/* set up to start building rows */
 	row_skip((nSkipTable)?nSkipTable:nTable, kRow - 1);
 
 	/* and output the target */
    if (nSkipTable)
-      pTS->builder(NULL, nID);
+      pTS->builder(pCtx, pRow, nID);
    else
-      pTF->builder(NULL, kRow);
+      pTF->builder(pCtx, pRow, kRow);
 
 
 	return(0);
 }
 
+/*
+* Routine: 
+* Purpose: 
+* Algorithm:
+* Data Structures:
+*
+* Params:
+* Returns:
+* Called By: 
+* Calls: 
+* Assumptions:
+* Side Effects:
+* TODO: None
+*/
+int 
+validateSCD(gen_ctx_t *pCtx, int nTable, ds_key_t kRow, int *Permutation)
+{
+	return(buildSCD(pCtx, nTable, kRow, Permutation, NULL));
+}
+
+/*
+* Routine: rebuildRow(gen_ctx_t *pCtx, int nTable, ds_key_t kRow, void *pRow)
+* Purpose: build a single row of a table into pRow, out of sequence
+* Algorithm: as the validation routines do; a slowly changing dimension is
+*	rebuilt from the first revision of its business key, any other table
+*	only needs its streams moved to the row
+* Data Structures:
+*
+* Params:
+* Returns: the builder's return code
+* Called By: dsdgen_row()
+* Calls: buildSCD()
+* Assumptions: the table is not a parent or child table
+* Side Effects:
+* TODO: None
+*/
+int
+rebuildRow(gen_ctx_t *pCtx, int nTable, ds_key_t kRow, void *pRow)
+{
+	table_func_t *pTF = getTdefFunctionsByNumber(nTable);
+
+	if (pTF->validate == validateSCD)
+		return(buildSCD(pCtx, nTable, kRow, NULL, pRow));
+
+	row_skip(nTable, kRow - 1);
+	return(pTF->builder(pCtx, pRow, kRow));
+}
+
 /*
 * Routine: 
 * Purpose: 
@@ -37,9 +37,11 @@
 #define VALIDATE_H
 #include "config.h"
 #include "porting.h"
+#include "context.h"
 
-int validateGeneric(int nTable, ds_key_t kRow, int *Permute);
+int validateGeneric(gen_ctx_t *pCtx, int nTable, ds_key_t kRow, int *Permute);
 void printValidation(int nTable, ds_key_t kRow);
-int validateSCD(int nTable, ds_key_t kRow, int *Permutation);
+int validateSCD(gen_ctx_t *pCtx, int nTable, ds_key_t kRow, int *Permutation);
+int rebuildRow(gen_ctx_t *pCtx, int nTable, ds_key_t kRow, void *pRow);
 #endif
 
@@ -62,8 +62,7 @@
 #include "nulls.h"
 #include "scd.h"
 
-struct CALL_CENTER_TBL g_w_call_center;
-static struct CALL_CENTER_TBL g_OldValues;
+THREAD struct CALL_CENTER_TBL g_w_call_center;
 
 /*
 * Routine: mk_w_call_center()
@@ -81,10 +80,10 @@ static struct CALL_CENTER_TBL g_OldValues;
 * 20020830 jms Need to populate open and close dates
 */
 int
-mk_w_call_center (void* row, ds_key_t index)
+mk_w_call_center (gen_ctx_t *pCtx, void* row, ds_key_t index)
 {
 	int32_t res = 0;
-	static int32_t jDateStart,
+	static THREAD int32_t jDateStart,
 		nDaysPerRevision;
 	int32_t nSuffix,
 		bFirstRecord = 0,
@@ -94,20 +93,27 @@ mk_w_call_center (void* row, ds_key_t index)
 	char *cp,
 		*sName1,
 		*sName2;
-	static decimal_t dMinTaxPercentage, dMaxTaxPercentage;
+	static THREAD decimal_t dMinTaxPercentage, dMaxTaxPercentage;
    tdef *pTdef = getSimpleTdefsByNumber(CALL_CENTER);
 
 	/* begin locals declarations */
 	date_t dTemp;
-	static int bInit = 0,
+	static THREAD int bInit = 0,
 		nScale;
 	struct CALL_CENTER_TBL *r,
-		*rOldValues = &g_OldValues;
+		*rOldValues = pCtx->Scd.pCallCenter;
 
 	if (row == NULL)
 		r = &g_w_call_center;
 	else
+	{
+		/* 
+		 * some fields are only set by the first revision of a business key; 
+		 * buildSCD() leaves the previous revision in g_w_call_center
+		 */
 		r = row;
+		memcpy(r, &g_w_call_center, sizeof(struct CALL_CENTER_TBL));
+	}
 
 	if (!bInit)
 	{
@@ -119,17 +125,17 @@ mk_w_call_center (void* row, ds_key_t index)
 		nDateRange = jDateEnd - jDateStart + 1; 
 		nDaysPerRevision = nDateRange / pTdef->nParam + 1;
 		nScale = get_int("SCALE");
-		
-		/* these fields need to be handled as part of SCD code or further definition */
-		r->cc_division_id = -1;
-		r->cc_closed_date_id = -1;
-		strcpy(r->cc_division_name, "No Name");
 
 		strtodec(&dMinTaxPercentage, MIN_CC_TAX_PERCENTAGE);
 		strtodec(&dMaxTaxPercentage, MAX_CC_TAX_PERCENTAGE);
       bInit = 1;
 	}
 	
+	/* these fields need to be handled as part of SCD code or further definition */
+	r->cc_division_id = -1;
+	r->cc_closed_date_id = -1;
+	strcpy(r->cc_division_name, "No Name");
+
 	nullSet(&pTdef->kNullBitMap, CC_NULLS);
 	r->cc_call_center_sk = index;
 
@@ -187,10 +193,10 @@ mk_w_call_center (void* row, ds_key_t index)
 	genrand_integer (&r->cc_market_id, DIST_UNIFORM, 1, 6, 0, CC_MARKET_ID);
 	changeSCD(SCD_INT, &r->cc_market_id, &rOldValues->cc_market_id,  &nFieldChangeFlags,  bFirstRecord);
 
-	gen_text (r->cc_market_class, 20, RS_CC_MARKET_CLASS, CC_MARKET_CLASS);
+	gen_text (pCtx, r->cc_market_class, 20, RS_CC_MARKET_CLASS, CC_MARKET_CLASS);
 	changeSCD(SCD_CHAR, &r->cc_market_class, &rOldValues->cc_market_class,  &nFieldChangeFlags,  bFirstRecord);
 
-	gen_text (r->cc_market_desc, 20, RS_CC_MARKET_DESC, CC_MARKET_DESC);
+	gen_text (pCtx, r->cc_market_desc, 20, RS_CC_MARKET_DESC, CC_MARKET_DESC);
 	changeSCD(SCD_CHAR, &r->cc_market_desc, &rOldValues->cc_market_desc,  &nFieldChangeFlags,  bFirstRecord);
 
 	pick_distribution (&sName1, "first_names", 1, 1, CC_MARKET_MANAGER);
@@ -302,6 +308,6 @@ pr_w_call_center(void *row)
 int
 ld_w_call_center(void *r)
 {
-	return(0);
+	return(pr_w_call_center(r));
 }
 
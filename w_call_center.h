@@ -40,6 +40,7 @@
 #include "address.h"
 #include "decimal.h"
 #include "date.h"
+#include "context.h"
 
 #define MIN_CC_TAX_PERCENTAGE	"0.00"
 #define MAX_CC_TAX_PERCENTAGE	"0.12"
@@ -72,7 +73,7 @@ struct CALL_CENTER_TBL {
 	decimal_t	cc_tax_percentage;
 };
 
-int mk_w_call_center(void *pDest, ds_key_t kIndex);
+int mk_w_call_center(gen_ctx_t *pCtx, void *pDest, ds_key_t kIndex);
 int pr_w_call_center(void *pSrc);
 int ld_w_call_center(void *r);
 
@@ -49,7 +49,7 @@
 #include "nulls.h"
 #include "tdefs.h"
 
-struct CATALOG_PAGE_TBL g_w_catalog_page;
+THREAD struct CATALOG_PAGE_TBL g_w_catalog_page;
 
 /*
 * Routine: mk_catalog_page()
@@ -70,15 +70,15 @@ struct CATALOG_PAGE_TBL g_w_catalog_page;
 * 20020903 jms cp_description needs to be randomized
 */
 int
-mk_w_catalog_page (void *row, ds_key_t index)
+mk_w_catalog_page (gen_ctx_t *pCtx, void *row, ds_key_t index)
 {
 	int res = 0;
-	static date_t *dStartDate;
-	static int nCatalogPageMax;
+	static THREAD date_t *dStartDate;
+	static THREAD int nCatalogPageMax;
 	int nDuration, 
 		nOffset,
 		nType;
-	static int bInit = 0;
+	static THREAD int bInit = 0;
 	struct CATALOG_PAGE_TBL *r;
 	int nCatalogInterval;
    tdef *pTdef = getSimpleTdefsByNumber(CATALOG_PAGE);
@@ -93,12 +93,12 @@ mk_w_catalog_page (void *row, ds_key_t index)
 		nCatalogPageMax = ((int)get_rowcount(CATALOG_PAGE) / CP_CATALOGS_PER_YEAR) / (YEAR_MAXIMUM - YEAR_MINIMUM + 2); 
 		dStartDate = strtodate(DATA_START_DATE);
 
-		/* columns that still need to be populated */
-        strcpy (r->cp_department, "DEPARTMENT");
-
 		bInit = 1;
 	}
 	
+	/* columns that still need to be populated */
+	strcpy (r->cp_department, "DEPARTMENT");
+
 	nullSet(&pTdef->kNullBitMap, CP_NULLS);
 	r->cp_catalog_page_sk = index;
 	mk_bkey(&r->cp_catalog_page_id[0], index, CP_CATALOG_PAGE_ID);
@@ -129,7 +129,7 @@ mk_w_catalog_page (void *row, ds_key_t index)
    r->cp_start_date_id += ((r->cp_catalog_number - 1) / CP_CATALOGS_PER_YEAR) * 365;
 	r->cp_end_date_id = r->cp_start_date_id + nDuration - 1;
 	dist_member(&r->cp_type, "catalog_page_type", nType, 1);
-	gen_text(&r->cp_description[0], RS_CP_DESCRIPTION / 2, RS_CP_DESCRIPTION - 1, CP_DESCRIPTION);
+	gen_text(pCtx, &r->cp_description[0], RS_CP_DESCRIPTION / 2, RS_CP_DESCRIPTION - 1, CP_DESCRIPTION);
 
 	return (res);
 }
@@ -190,6 +190,6 @@ pr_w_catalog_page(void *row)
 int
 ld_w_catalog_page(void *r)
 {
-	return(0);
+	return(pr_w_catalog_page(r));
 }
 
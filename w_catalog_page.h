@@ -35,6 +35,7 @@
  */ 
 #ifndef CATALOG_PAGE_H
 #define CATALOG_PAGE_H
+#include "context.h"
 /*
  * CATALOG_PAGE table structure 
  */
@@ -50,7 +51,7 @@ struct CATALOG_PAGE_TBL {
 	char	*cp_type;
 };
 
-int mk_w_catalog_page(void *row, ds_key_t index);
+int mk_w_catalog_page(gen_ctx_t *pCtx, void *row, ds_key_t index);
 int pr_w_catalog_page(void *r);
 int ld_w_catalog_page(void *r);
 #endif
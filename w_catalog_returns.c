@@ -48,8 +48,8 @@
 #include "tdefs.h"
 #include "parallel.h"
 
-struct W_CATALOG_RETURNS_TBL g_w_catalog_returns;
-extern struct W_CATALOG_SALES_TBL g_w_catalog_sales;
+THREAD struct W_CATALOG_RETURNS_TBL g_w_catalog_returns;
+extern THREAD struct W_CATALOG_SALES_TBL g_w_catalog_sales;
 
 /*
 * Routine: mk_catalog_returns()
@@ -69,16 +69,14 @@ extern struct W_CATALOG_SALES_TBL g_w_catalog_sales;
 * 20031023 jms removed ability for stand alone generation
 */
 int
-mk_w_catalog_returns (void * row, ds_key_t index)
+mk_w_catalog_returns (gen_ctx_t *pCtx, void * row, ds_key_t index)
 {
 	int res = 0;
 	
-	static decimal_t dHundred;
 	int nTemp;	
 	struct W_CATALOG_RETURNS_TBL *r;
 	struct W_CATALOG_SALES_TBL *sale = &g_w_catalog_sales;
-	static int bInit = 0;
-	static int bStandAlone = 0;
+	int bStandAlone = 0;	/* stand alone generation was removed; see TODO */
    tdef *pTdef = getSimpleTdefsByNumber(CATALOG_RETURNS);
 
 	if (row == NULL)
@@ -86,11 +84,6 @@ mk_w_catalog_returns (void * row, ds_key_t index)
 	else
 		r = row;
 
-	if (!bInit)
-	{        
-		strtodec(&dHundred, "100.00");
-	}
-	
 	/* if we were not called from the parent table's mk_xxx routine, then 
 	 * move to a parent row that needs to be returned, and generate it
 	 */
@@ -103,7 +96,7 @@ mk_w_catalog_returns (void * row, ds_key_t index)
 			row_skip(CATALOG_SALES, 1);
 			return(1);
 		}
-		mk_w_catalog_sales(&g_w_catalog_sales, index);
+		mk_w_catalog_sales(pCtx, &g_w_catalog_sales, index);
 	}
 	
 	/*
@@ -158,7 +151,7 @@ mk_w_catalog_returns (void * row, ds_key_t index)
 		1, sale->cs_pricing.quantity, 0, CR_PRICING);
 	else
 	r->cr_pricing.quantity = -1;
-	set_pricing(CR_PRICING, &r->cr_pricing);
+	set_pricing(pCtx, CR_PRICING, &r->cr_pricing);
 
 	return (res);
 }
@@ -246,7 +239,7 @@ ld_w_catalog_returns(void *row)
 	else
 		r = row;
 
-	return(0);
+	return(pr_w_catalog_returns(r));
 
 }
 
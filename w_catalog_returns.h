@@ -37,6 +37,7 @@
 #define W_CATALOG_RETURNS_H
 
 #include "pricing.h"
+#include "context.h"
 
 /*
  * CATALOG_RETURNS table structure 
@@ -67,7 +68,7 @@ struct W_CATALOG_RETURNS_TBL {
 	decimal_t	cr_net_loss;
 };
 
-int mk_w_catalog_returns(void *pDest, ds_key_t kIndex);
+int mk_w_catalog_returns(gen_ctx_t *pCtx, void *pDest, ds_key_t kIndex);
 int pr_w_catalog_returns(void *pSrc);
 int ld_w_catalog_returns(void *pSrc);
 #endif
@@ -54,15 +54,14 @@
 #include "parallel.h"
 #include "scd.h"
 #include "stable_rng.h"
+#include "runtime.h"
 
-struct W_CATALOG_SALES_TBL g_w_catalog_sales;
+THREAD struct W_CATALOG_SALES_TBL g_w_catalog_sales;
 ds_key_t skipDays(int nTable, ds_key_t *pRemainder);
 
-static ds_key_t kNewDateIndex = 0;
-static ds_key_t jDate;
-static int nTicketItemBase = 1;
-static int *pItemPermutation;
+static permutation_t *pItemPermutation;
 static int nItemCount;
+DECLARE_LOCK(PermutationLock);
                                                               
                                                               
 /*                                                            
@@ -71,14 +70,11 @@ static int nItemCount;
  * and a detail/lineitem portion.                             
  */                                                           
 static void                                                   
-mk_master (void *row, ds_key_t index)                         
+mk_master (gen_ctx_t *pCtx, void *row, ds_key_t index)                         
 {                                      
-	static decimal_t dZero,
-		dHundred,
-		dOne, dOneHalf;
 	int nGiftPct;
 	struct W_CATALOG_SALES_TBL *r;
-	static int bInit = 0;
+	sales_state_t *pS = &pCtx->CatalogSales;
 
 
 	if (row == NULL)
@@ -86,22 +82,22 @@ mk_master (void *row, ds_key_t index)
 	else
 		r = row;
 
-	if (!bInit)
+	if (!pS->bInit)
 	{
-	    strtodec (&dZero, "0.00");
-        strtodec (&dHundred, "100.00");
-        strtodec (&dOne, "1.00");
-        strtodec (&dOneHalf, "0.50");
-		jDate = skipDays(CATALOG_SALES, &kNewDateIndex);
-		pItemPermutation = makePermutation(NULL, (nItemCount = (int)getIDCount(ITEM)), CS_PERMUTE);
-
-		bInit = 1;
+		pS->jDate = skipDays(CATALOG_SALES, &pS->kNewDateIndex);
+		/* the permutation is shared by all threads; the first one builds it */
+		LOCK(PermutationLock);
+		if (pItemPermutation == NULL)
+			pItemPermutation = newPermutation((nItemCount = (int)getIDCount(ITEM)), CS_PERMUTE, g_Runtime.bStateless);
+		UNLOCK(PermutationLock);
+
+		pS->bInit = 1;
 	}
 
-   while (index > kNewDateIndex)	/* need to move to a new date */
+   while (index > pS->kNewDateIndex)	/* need to move to a new date */
    {
-      jDate += 1;
-      kNewDateIndex += dateScaling(CATALOG_SALES, jDate);
+      pS->jDate += 1;
+      pS->kNewDateIndex += dateScaling(CATALOG_SALES, pS->jDate);
    }
 
 	/***
@@ -113,7 +109,7 @@ mk_master (void *row, ds_key_t index)
     * recent values that were used to set the values of the orderline-invariant columns
  	 */
    
-		r->cs_sold_date_sk = jDate;
+		r->cs_sold_date_sk = pS->jDate;
 		r->cs_sold_time_sk = mk_join (CS_SOLD_TIME_SK, TIME, 
 			r->cs_call_center_sk);
 		r->cs_call_center_sk =
@@ -150,24 +146,19 @@ mk_master (void *row, ds_key_t index)
 		}	
 
       r->cs_order_number = index;
-	  genrand_integer(&nTicketItemBase, DIST_UNIFORM, 1, nItemCount, 0, CS_SOLD_ITEM_SK);
+	  genrand_integer(&pS->nItemIndex, DIST_UNIFORM, 1, nItemCount, 0, CS_SOLD_ITEM_SK);
 
       return;
 }
 
 static void
-mk_detail(void *row, int bPrint)
+mk_detail(gen_ctx_t *pCtx, void *row, int bPrint)
 {
-	static decimal_t dZero,
-		dHundred,
-		dOne, dOneHalf;
 	int nShipLag, 
 		nTemp;
    ds_key_t kItem;
-	static ds_key_t kNewDateIndex = 0;
-	static ds_key_t jDate;
 	struct W_CATALOG_SALES_TBL *r;
-	static int bInit = 0;
+	sales_state_t *pS = &pCtx->CatalogSales;
    tdef *pTdef = getSimpleTdefsByNumber(CATALOG_SALES);
 
 
@@ -176,18 +167,6 @@ mk_detail(void *row, int bPrint)
 	else
 		r = row;
 
-	if (!bInit)
-	{
-	    strtodec (&dZero, "0.00");
-        strtodec (&dHundred, "100.00");
-        strtodec (&dOne, "1.00");
-        strtodec (&dOneHalf, "0.50");
-		jDate = skipDays(CATALOG_SALES, &kNewDateIndex);
-
-		bInit = 1;
-	}
-
-
    nullSet(&pTdef->kNullBitMap, CS_NULLS);
 
 	/* orders are shipped some number of days after they are ordered */
@@ -201,9 +180,9 @@ mk_detail(void *row, int bPrint)
 	 * use a sequence within the permutation 
     * NB: Permutations are 1-based
 	 */
-	if (++nTicketItemBase > nItemCount)
-      nTicketItemBase = 1;
-   kItem = getPermutationEntry(pItemPermutation, nTicketItemBase);
+	if (++pS->nItemIndex > nItemCount)
+      pS->nItemIndex = 1;
+   kItem = getPermutationKey(pItemPermutation, pS->nItemIndex);
    r->cs_sold_item_sk = matchSCDSK(kItem, r->cs_sold_date_sk, ITEM);
 
 	/* catalog page needs to be from a catlog active at the time of the sale */
@@ -213,30 +192,29 @@ mk_detail(void *row, int bPrint)
 	r->cs_ship_mode_sk = mk_join (CS_SHIP_MODE_SK, SHIP_MODE, 1);
 	r->cs_warehouse_sk = mk_join (CS_WAREHOUSE_SK, WAREHOUSE, 1);
 	r->cs_promo_sk = mk_join (CS_PROMO_SK, PROMOTION, 1);
-	set_pricing(CS_PRICING, &r->cs_pricing);
+	set_pricing(pCtx, CS_PRICING, &r->cs_pricing);
 
 	/** 
 	* having gone to the trouble to make the sale, now let's see if it gets returned
 	* Use stable RNG to ensure consistent returns across separate runs
 	*/
-	int nScale = get_int("SCALE");
-	int current_table = get_current_table_id();
+	int nScale = g_Runtime.nScale;
 	/* Always use CATALOG_SALES for stable RNG to ensure consistency */
 	int should_have_return = stable_rand_10pct(CATALOG_SALES, nScale, r->cs_order_number);
 	
 	if (should_have_return)
 	{
-		mk_w_catalog_returns(NULL, 1);
-		/* Only print returns if we're generating catalog_returns table */
-		if (bPrint && current_table == CATALOG_RETURNS)
+		mk_w_catalog_returns(pCtx, NULL, 1);
+		/* Only print returns if we're generating catalog_returns table (or -RETURNS) */
+		if (bPrint && is_table_printed(CATALOG_RETURNS))
 			pr_w_catalog_returns(NULL);
 	}
 
    /**
    * now we print out the order and lineitem together as a single row
-   * Only print sales if we're generating catalog_sales table
+   * Only print sales if we're generating catalog_sales table (or -RETURNS)
    */
-   if (bPrint && current_table == CATALOG_SALES)
+   if (bPrint && is_table_printed(CATALOG_SALES))
       pr_w_catalog_sales(NULL);
 
    return;
@@ -259,21 +237,21 @@ mk_detail(void *row, int bPrint)
 * 20020902 jms Should promos be tied to item id?
 */
 int
-mk_w_catalog_sales (void* row, ds_key_t index)
+mk_w_catalog_sales (gen_ctx_t *pCtx, void* row, ds_key_t index)
 {
    int nLineitems,
       i;
 
-   mk_master(row, index);
+   mk_master(pCtx, row, index);
 
    /*
     * now we select the number of lineitems in this order, and loop through them, printing
     * as we go
     */
-   genrand_integer(&nLineitems, DIST_UNIFORM, 4, 14, 0, CS_ORDER_NUMBER);
+   genrand_integer(&nLineitems, DIST_UNIFORM, CS_MIN_LINEITEMS, CS_MAX_LINEITEMS, 0, CS_ORDER_NUMBER);
    for (i=1; i <= nLineitems; i++)
    {
-      mk_detail(NULL, 1);
+      mk_detail(pCtx, NULL, 1);
    }
 
    /**
@@ -370,7 +348,7 @@ ld_w_catalog_sales(void *row)
 	else
 		r = row;
 
-	return(0);
+	return(pr_w_catalog_sales(r));
 }
 
 /*
@@ -388,24 +366,65 @@ ld_w_catalog_sales(void *row)
 * TODO: None
 */
 int
-vld_w_catalog_sales(int nTable, ds_key_t kRow, int *Permutation)
+vld_w_catalog_sales(gen_ctx_t *pCtx, int nTable, ds_key_t kRow, int *Permutation)
 {
 	int nLineitem,
 		nMaxLineitem,
 		i;
+	sales_state_t *pS = &pCtx->CatalogSales;
 
 	row_skip(nTable, kRow - 1);
 	row_skip(CATALOG_RETURNS, (kRow - 1) );
-	jDate = skipDays(CATALOG_SALES, &kNewDateIndex);		
-	mk_master(NULL, kRow);
-	genrand_integer(&nMaxLineitem, DIST_UNIFORM, 4, 14, 9, CS_ORDER_NUMBER);
+	pS->jDate = skipDays(CATALOG_SALES, &pS->kNewDateIndex);
+	mk_master(pCtx, NULL, kRow);
+	genrand_integer(&nMaxLineitem, DIST_UNIFORM, CS_MIN_LINEITEMS, CS_MAX_LINEITEMS, 9, CS_ORDER_NUMBER);
 	genrand_integer(&nLineitem, DIST_UNIFORM, 1, nMaxLineitem, 0, CS_PRICING_QUANTITY);
 	for (i = 1; i < nLineitem; i++)
 	{
-		mk_detail(NULL, 0);
+		mk_detail(pCtx, NULL, 0);
 	}
-   mk_detail(NULL, 1);
+   mk_detail(pCtx, NULL, 1);
 
 	return(0);
 }
 
+/*
+* Routine: mk_w_catalog_sales_lineitems(gen_ctx_t *pCtx, void *pDest, ds_key_t kIndex, ds_key_t *arNulls)
+* Purpose: build all of the lineitems of a single order, out of sequence
+* Algorithm: as vld_w_catalog_sales(), but every lineitem is copied to pDest rather
+*	than printed
+* Data Structures:
+*
+* Params: pDest is an array of at least CS_MAX_LINEITEMS rows; arNulls, if not
+*	NULL, receives the NULL bitmap of each lineitem
+* Returns: the number of lineitems
+* Called By: dsdgen_row()
+* Calls: 
+* Assumptions: set_chunk() has restricted the calling thread to the order, so 
+*	that skipDays() finds its date directly
+* Side Effects:
+* TODO: None
+*/
+int
+mk_w_catalog_sales_lineitems(gen_ctx_t *pCtx, void *pDest, ds_key_t kIndex, ds_key_t *arNulls)
+{
+	struct W_CATALOG_SALES_TBL *arLineitems = (struct W_CATALOG_SALES_TBL *)pDest;
+	int nLineitems,
+		i;
+	sales_state_t *pS = &pCtx->CatalogSales;
+
+	row_skip(CATALOG_SALES, kIndex - 1);
+	row_skip(CATALOG_RETURNS, kIndex - 1);
+	pS->jDate = skipDays(CATALOG_SALES, &pS->kNewDateIndex);
+	mk_master(pCtx, NULL, kIndex);
+	genrand_integer(&nLineitems, DIST_UNIFORM, CS_MIN_LINEITEMS, CS_MAX_LINEITEMS, 0, CS_ORDER_NUMBER);
+	for (i=0; i < nLineitems; i++)
+	{
+		mk_detail(pCtx, NULL, 0);
+		arLineitems[i] = g_w_catalog_sales;
+		if (arNulls != NULL)
+			arNulls[i] = getSimpleTdefsByNumber(CATALOG_SALES)->kNullBitMap;
+	}
+
+	return(nLineitems);
+}
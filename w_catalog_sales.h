@@ -37,6 +37,7 @@
 #define W_CATALOG_SALES_H
 
 #include "pricing.h"
+#include "context.h"
 
 /*
  * CATALOG_SALES table structure 
@@ -63,9 +64,10 @@ struct W_CATALOG_SALES_TBL {
 	ds_pricing_t	cs_pricing;
 };
 
-int mk_w_catalog_sales(void *row, ds_key_t index);
+int mk_w_catalog_sales(gen_ctx_t *pCtx, void *row, ds_key_t index);
 int pr_w_catalog_sales(void *r);
 int ld_w_catalog_sales(void *r);
-int vld_w_catalog_sales(int nTable, ds_key_t kRow, int *Permutation);
+int vld_w_catalog_sales(gen_ctx_t *pCtx, int nTable, ds_key_t kRow, int *Permutation);
+int mk_w_catalog_sales_lineitems(gen_ctx_t *pCtx, void *pDest, ds_key_t kIndex, ds_key_t *arNulls);
 #endif
 
@@ -46,7 +46,7 @@
 #include "nulls.h"
 #include "tdefs.h"
 
-struct W_CUSTOMER_TBL g_w_customer;
+THREAD struct W_CUSTOMER_TBL g_w_customer;
 /* extern tdef w_tdefs[]; */
 
 /*
@@ -64,23 +64,27 @@ struct W_CUSTOMER_TBL g_w_customer;
 * TODO: 
 */
 int
-mk_w_customer (void * row, ds_key_t index)
+mk_w_customer (gen_ctx_t *pCtx, void * row, ds_key_t index)
 {
 	int res = 0,
 		nTemp;
 	
-	static int nBaseDate;
+	static THREAD int nBaseDate;
 	/* begin locals declarations */
 	int nNameIndex,
 		nGender;
 	struct W_CUSTOMER_TBL *r;
-	static int bInit = 0;
+	static THREAD int bInit = 0;
 	date_t dtTemp;
-	static date_t dtBirthMin, 
+	static THREAD date_t dtBirthMin, 
 		dtBirthMax,
 		dtToday,
 		dt1YearAgo,
 		dt10YearsAgo;
+	static THREAD d_idx_t *pFirstNames,
+		*pLastNames,
+		*pSalutations,
+		*pCountries;
    tdef *pT = getSimpleTdefsByNumber(CUSTOMER);
 
 	if (row == NULL)
@@ -96,6 +100,10 @@ mk_w_customer (void * row, ds_key_t index)
 		strtodt(&dtToday, TODAYS_DATE);
 		jtodt(&dt1YearAgo, dtToday.julian - 365);
 		jtodt(&dt10YearsAgo, dtToday.julian - 3650);
+		pFirstNames = find_dist("first_names");
+		pLastNames = find_dist("last_names");
+		pSalutations = find_dist("salutations");
+		pCountries = find_dist("countries");
 
 		bInit = 1;
 	}
@@ -116,12 +124,12 @@ mk_w_customer (void * row, ds_key_t index)
 	r->c_current_addr_sk =
 		mk_join (C_CURRENT_ADDR_SK, CUSTOMER_ADDRESS, r->c_customer_sk);
 	nNameIndex =
-		pick_distribution (&r->c_first_name,
-		"first_names", 1, 3, C_FIRST_NAME);
-	pick_distribution (&r->c_last_name, "last_names", 1, 1, C_LAST_NAME);
+		pick_distribution_idx (&r->c_first_name,
+		pFirstNames, 1, 3, C_FIRST_NAME);
+	pick_distribution_idx (&r->c_last_name, pLastNames, 1, 1, C_LAST_NAME);
 	dist_weight (&nGender, "first_names", nNameIndex, 2);
-	pick_distribution (&r->c_salutation,
-		"salutations", 1, (nGender == 0) ? 2 : 3, C_SALUTATION);
+	pick_distribution_idx (&r->c_salutation,
+		pSalutations, 1, (nGender == 0) ? 2 : 3, C_SALUTATION);
 
 	genrand_date(&dtTemp, DIST_UNIFORM, &dtBirthMin, &dtBirthMax, NULL, C_BIRTH_DAY);
 	r->c_birth_day = dtTemp.day;
@@ -134,7 +142,7 @@ mk_w_customer (void * row, ds_key_t index)
 	r->c_first_sales_date_id = dtTemp.julian;
     r->c_first_shipto_date_id = r->c_first_sales_date_id + 30;
 
-    pick_distribution(&r->c_birth_country, "countries", 1, 1, C_BIRTH_COUNTRY);
+    pick_distribution_idx(&r->c_birth_country, pCountries, 1, 1, C_BIRTH_COUNTRY);
 
 	
 	return (res);
@@ -212,6 +220,6 @@ ld_w_customer(void *row)
 	else
 		r = row;
 
-	return(0);
+	return(pr_w_customer(r));
 }
 
@@ -35,6 +35,7 @@
  */ 
 #ifndef W_CUSTOMER_H
 #define W_CUSTOMER_H
+#include "context.h"
 
 /*
  * CUSTOMER table structure 
@@ -61,7 +62,7 @@ struct W_CUSTOMER_TBL {
 };
 
 
-int mk_w_customer(void *pDest, ds_key_t kIndex);
+int mk_w_customer(gen_ctx_t *pCtx, void *pDest, ds_key_t kIndex);
 int pr_w_customer(void *pSrc);
 int ld_w_customer(void *pSrc);
 #endif
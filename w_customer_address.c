@@ -47,13 +47,13 @@
 #include "nulls.h"
 #include "tdefs.h"
 
-struct W_CUSTOMER_ADDRESS_TBL g_w_customer_address;
+THREAD struct W_CUSTOMER_ADDRESS_TBL g_w_customer_address;
 
 /*
 * mk_customer_address
 */
 int
-mk_w_customer_address (void* row, ds_key_t index)
+mk_w_customer_address (gen_ctx_t *pCtx, void* row, ds_key_t index)
 {
 	
 	int res = 0;
@@ -152,6 +152,6 @@ ld_w_customer_address(void *row)
 	else
 		r = row;
 
-	return(0);
+	return(pr_w_customer_address(r));
 }
 
@@ -37,6 +37,7 @@
 #define W_CUSTOMER_ADDRESS_H
 #include "constants.h"
 #include "address.h"
+#include "context.h"
 
 /*
  * CUSTOMER_ADDRESS table structure 
@@ -48,7 +49,7 @@ struct W_CUSTOMER_ADDRESS_TBL {
 	char		*ca_location_type;
 };
 
-int mk_w_customer_address(void *pDest, ds_key_t kIndex);
+int mk_w_customer_address(gen_ctx_t *pCtx, void *pDest, ds_key_t kIndex);
 int pr_w_customer_address(void *pSrc);
 int ld_w_customer_address(void *pSrc);
 #endif
@@ -47,13 +47,13 @@
 #include "tdefs.h"
 #include "sparse.h"
 
-struct W_CUSTOMER_DEMOGRAPHICS_TBL g_w_customer_demographics;
+THREAD struct W_CUSTOMER_DEMOGRAPHICS_TBL g_w_customer_demographics;
 
 /*
 * mk_customer_demographics
 */
 int
-mk_w_customer_demographics (void* row, ds_key_t index)
+mk_w_customer_demographics (gen_ctx_t *pCtx, void* row, ds_key_t index)
 {
 	int res = 0;
 	
@@ -151,6 +151,6 @@ ld_w_customer_demographics(void *row)
 	else
 		r = row;
 
-	return(0);
+	return(pr_w_customer_demographics(r));
 }
 
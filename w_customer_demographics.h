@@ -35,6 +35,7 @@
  */ 
 #ifndef W_CUSTOMER_DEMOGRAPHICS_H
 #define W_CUSTOMER_DEMOGRAPHICS_H
+#include "context.h"
 
  /***
  *** CD_xxx Customer Demographcis Defines
@@ -60,7 +61,7 @@ int			cd_dep_college_count;
 };
 
 
-int mk_w_customer_demographics(void *pDest, ds_key_t kIndex);
+int mk_w_customer_demographics(gen_ctx_t *pCtx, void *pDest, ds_key_t kIndex);
 int pr_w_customer_demographics(void *pSrc);
 int ld_w_customer_demographics(void *pSrc);
 #endif
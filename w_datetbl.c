@@ -45,7 +45,7 @@
 #include "nulls.h"
 #include "tdefs.h"
 
-struct W_DATE_TBL g_w_date;
+THREAD struct W_DATE_TBL g_w_date;
 /* extern tdef w_tdefs[]; */
 
 /*
@@ -63,17 +63,17 @@ struct W_DATE_TBL g_w_date;
 * TODO: 
 */
 int
-mk_w_date (void * row, ds_key_t index)
+mk_w_date (gen_ctx_t *pCtx, void * row, ds_key_t index)
 {
 	int res = 0;
 	
 	/* begin locals declarations */
-	static date_t base_date;
+	static THREAD date_t base_date;
 	int day_index,
 		nTemp;
 	date_t temp_date, dTemp2;
 	struct W_DATE_TBL *r;
-	static int bInit = 0;
+	static THREAD int bInit = 0;
    tdef *pT = getSimpleTdefsByNumber(DATE);
 
 	if (row == NULL)
@@ -230,7 +230,7 @@ ld_w_date(void *pSrc)
 	else
 		r = pSrc;
 	
-	return(0);
+	return(pr_w_date(r));
 }
 
 /*
@@ -248,12 +248,12 @@ ld_w_date(void *pSrc)
 * TODO: None
 */
 int 
-vld_w_date(int nTable, ds_key_t kRow, int *Permutation)
+vld_w_date(gen_ctx_t *pCtx, int nTable, ds_key_t kRow, int *Permutation)
 {
 	int res = 0;
 	
 	/* begin locals declarations */
-	static date_t base_date;
+	static THREAD date_t base_date;
 	int day_index,
 		nTemp;
 	date_t temp_date, dTemp2;
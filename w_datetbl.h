@@ -39,6 +39,7 @@
 #ifndef W_DATETBL_H
 #define W_DATETBL_H
 #include "constants.h"
+#include "context.h"
 struct W_DATE_TBL {
 ds_key_t	d_date_sk;
 char		d_date_id[RS_BKEY + 1];
@@ -71,10 +72,10 @@ int			d_current_quarter;
 int			d_current_year;
 };
 
-int mk_w_date(void *pDest, ds_key_t kIndex);
+int mk_w_date(gen_ctx_t *pCtx, void *pDest, ds_key_t kIndex);
 int pr_w_date(void *pSrc);
 int ld_w_date(void *pSrc);
-int vld_w_date(int nTable, ds_key_t kRow, int *Permutation);
+int vld_w_date(gen_ctx_t *pCtx, int nTable, ds_key_t kRow, int *Permutation);
 #endif
 
 
@@ -55,13 +55,13 @@
 #include "tdefs.h"
 #include "sparse.h"
 
-struct W_HOUSEHOLD_DEMOGRAPHICS_TBL g_w_household_demographics;
+THREAD struct W_HOUSEHOLD_DEMOGRAPHICS_TBL g_w_household_demographics;
 
 /*
 * mk_household_demographics
 */
 int
-mk_w_household_demographics (void* row, ds_key_t index)
+mk_w_household_demographics (gen_ctx_t *pCtx, void* row, ds_key_t index)
 {
 	int32_t res = 0;
 	/* begin locals declarations */
@@ -148,6 +148,6 @@ ld_w_household_demographics(void *pSrc)
 	else
 		r = pSrc;
 	
-	return(0);
+	return(pr_w_household_demographics(r));
 }
 
@@ -35,6 +35,7 @@
  */ 
 #ifndef W_HOUSEHOLD_DEMOGRAPHICS_H
 #define W_HOUSEHOLD_DEMOGRAPHICS_H
+#include "context.h"
 /*
  * HOUSEHOLD_DEMOGRAPHICS table structure 
  */
@@ -46,7 +47,7 @@ struct W_HOUSEHOLD_DEMOGRAPHICS_TBL {
 	int			hd_vehicle_count;
 };
 
-int mk_w_household_demographics(void *pDest, ds_key_t kIndex);
+int mk_w_household_demographics(gen_ctx_t *pCtx, void *pDest, ds_key_t kIndex);
 int pr_w_household_demographics(void *pSrc);
 int ld_w_household_demographics(void *pSrc);
 #endif
@@ -45,17 +45,17 @@
 #include "nulls.h"
 #include "tdefs.h"
 
-struct W_INCOME_BAND_TBL g_w_income_band;
+THREAD struct W_INCOME_BAND_TBL g_w_income_band;
 
 /*
 * mk_income_band
 */
 int
-mk_w_income_band (void* row, ds_key_t index)
+mk_w_income_band (gen_ctx_t *pCtx, void* row, ds_key_t index)
 {
 	int res = 0;
 	struct W_INCOME_BAND_TBL *r;
-	static int bInit = 0;
+	static THREAD int bInit = 0;
    tdef *pTdef = getSimpleTdefsByNumber(INCOME_BAND);
 
 	if (row == NULL)
@@ -134,6 +134,6 @@ ld_w_income_band(void *pSrc)
 	else
 		r = pSrc;
 	
-	return(0);
+	return(pr_w_income_band(r));
 }
 
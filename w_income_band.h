@@ -33,6 +33,8 @@
  * Contributors:
  * Gradient Systems
  */ 
+#include "context.h"
+
 /*
  * INCOME_BAND table structure 
  */
@@ -42,7 +44,7 @@ struct W_INCOME_BAND_TBL {
 	int	ib_upper_bound;
 };
 
-int mk_w_income_band(void *pDest, ds_key_t kIndex);
+int mk_w_income_band(gen_ctx_t *pCtx, void *pDest, ds_key_t kIndex);
 int pr_w_income_band(void *pSrc);
 int ld_w_income_band(void *pSrc);
 
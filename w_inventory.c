@@ -49,7 +49,7 @@
 #include "tdefs.h"
 #include "scd.h"
 
-struct W_INVENTORY_TBL g_w_inventory;
+THREAD struct W_INVENTORY_TBL g_w_inventory;
 
 /*
 * Routine: 
@@ -66,13 +66,10 @@ struct W_INVENTORY_TBL g_w_inventory;
 * TODO: None
 */
 int
-mk_w_inventory(void *pDest, ds_key_t index)
+mk_w_inventory(gen_ctx_t *pCtx, void *pDest, ds_key_t index)
 {
-	static int bInit = 0;
 	struct W_INVENTORY_TBL *r;
-	static ds_key_t item_count;
-	static ds_key_t warehouse_count;
-	static int jDate;
+	inventory_state_t *pS = &pCtx->Inventory;
 	date_t *base_date;
 	int nTemp;
    tdef *pTdef = getSimpleTdefsByNumber(INVENTORY);
@@ -82,25 +79,25 @@ mk_w_inventory(void *pDest, ds_key_t index)
 	else
 		r = pDest;
 
-	if (!bInit)
+	if (!pS->bInit)
 	{
 		memset(&g_w_inventory, 0, sizeof(struct W_INVENTORY_TBL));
-        item_count = getIDCount(ITEM);
-        warehouse_count = get_rowcount (WAREHOUSE);
+        pS->kItemCount = getIDCount(ITEM);
+        pS->kWarehouseCount = get_rowcount (WAREHOUSE);
         base_date = strtodate (DATE_MINIMUM);
-        jDate = base_date->julian;
+        pS->jDate = base_date->julian;
         set_dow(base_date);
         /* Make exceptions to the 1-rng-call-per-row rule */
-		bInit = 1;
+		pS->bInit = 1;
 	}
 
 	nullSet(&pTdef->kNullBitMap, INV_NULLS);
 	nTemp = (int) index - 1;
-	r->inv_item_sk = (nTemp % item_count) + 1;
-	nTemp /= (int) item_count;
-	r->inv_warehouse_sk = (nTemp % warehouse_count) + 1;
-	nTemp /= (int) warehouse_count;
-	r->inv_date_sk = jDate + (nTemp * 7);	/* inventory is updated weekly */
+	r->inv_item_sk = (nTemp % pS->kItemCount) + 1;
+	nTemp /= (int) pS->kItemCount;
+	r->inv_warehouse_sk = (nTemp % pS->kWarehouseCount) + 1;
+	nTemp /= (int) pS->kWarehouseCount;
+	r->inv_date_sk = pS->jDate + (nTemp * 7);	/* inventory is updated weekly */
 
 	/* 
 	 * the join between item and inventory is tricky. The item_id selected above identifies a unique part num
@@ -173,7 +170,7 @@ ld_w_inventory(void *pSrc)
 	else
 		r = pSrc;
 	
-	return(0);
+	return(pr_w_inventory(r));
 }
 
 /*
@@ -33,6 +33,8 @@
  * Contributors:
  * Gradient Systems
  */ 
+#include "context.h"
+
 /*
  * INVENTORY table structure 
  */
@@ -44,7 +46,7 @@ struct W_INVENTORY_TBL {
 };
 
 
-int mk_w_inventory(void *pDest, ds_key_t kIndex);
+int mk_w_inventory(gen_ctx_t *pCtx, void *pDest, ds_key_t kIndex);
 int pr_w_inventory(void *pSrc);
 int ld_w_inventory(void *pSrc);
 ds_key_t sc_w_inventory(int nScale);
@@ -55,14 +55,13 @@
 
 /* extern tdef w_tdefs[]; */
 
-struct W_ITEM_TBL g_w_item,
-	g_OldValues;
+THREAD struct W_ITEM_TBL g_w_item;
 
 /*
 * mk_item
 */
 int
-mk_w_item (void* row, ds_key_t index)
+mk_w_item (gen_ctx_t *pCtx, void* row, ds_key_t index)
 {
 	
 	int32_t res = 0;
@@ -70,7 +69,7 @@ mk_w_item (void* row, ds_key_t index)
 	decimal_t dMinPrice, 
 		dMaxPrice,
 		dMarkdown;
-	static decimal_t dMinMarkdown, dMaxMarkdown;
+	static THREAD decimal_t dMinMarkdown, dMaxMarkdown;
 	int32_t bUseSize,
 		bFirstRecord = 0,
 		nFieldChangeFlags,
@@ -80,8 +79,8 @@ mk_w_item (void* row, ds_key_t index)
 		nTemp;
 	char *cp;
 	struct W_ITEM_TBL *r;
-	static int32_t bInit = 0;
-	struct W_ITEM_TBL *rOldValues = &g_OldValues;
+	static THREAD int32_t bInit = 0;
+	struct W_ITEM_TBL *rOldValues = pCtx->Scd.pItem;
 	char *szMinPrice = NULL,
 		*szMaxPrice = NULL;
    tdef *pT = getSimpleTdefsByNumber(ITEM);
@@ -138,7 +137,7 @@ mk_w_item (void* row, ds_key_t index)
 	/* the rest of the record in a history-keeping dimension can either be a new data value or not;
 	 * use a random number and its bit pattern to determine which fields to replace and which to retain
 	 */
-	gen_text (r->i_item_desc, 1, RS_I_ITEM_DESC, I_ITEM_DESC);
+	gen_text (pCtx, r->i_item_desc, 1, RS_I_ITEM_DESC, I_ITEM_DESC);
 	changeSCD(SCD_CHAR, &r->i_item_desc, &rOldValues->i_item_desc,  &nFieldChangeFlags,  bFirstRecord);
 	
 	nIndex = pick_distribution(&szMinPrice, "i_current_price", 2, 1, I_CURRENT_PRICE);
@@ -213,10 +212,10 @@ mk_w_item (void* row, ds_key_t index)
  * if this is the first of a set of revisions, then baseline the old values
  */
  if (bFirstRecord)
-   memcpy(&g_OldValues, r, sizeof(struct W_ITEM_TBL));
+   memcpy(rOldValues, r, sizeof(struct W_ITEM_TBL));
 
  if (index == 1)
-   memcpy(&g_OldValues, r, sizeof(struct W_ITEM_TBL));
+   memcpy(rOldValues, r, sizeof(struct W_ITEM_TBL));
 
 	return (res);
 }
@@ -298,6 +297,6 @@ ld_w_item(void *pSrc)
 	else
 		r = pSrc;
 	
-	return(0);
+	return(pr_w_item(r));
 }
 
@@ -36,6 +36,7 @@
 #ifndef W_ITEM_H
 #define W_ITEM_H
 #include "constants.h"
+#include "context.h"
 
 #define I_PROMO_PERCENTAGE	20	/* percent of items that have associated promotions */
 #define MIN_ITEM_MARKDOWN_PCT		"0.30"
@@ -71,7 +72,7 @@ struct W_ITEM_TBL {
 };
 
 
-int mk_w_item(void *pDest, ds_key_t kIndex);
+int mk_w_item(gen_ctx_t *pCtx, void *pDest, ds_key_t kIndex);
 int pr_w_item(void *pSrc);
 int ld_w_item(void *pSrc);
 int vld_w_item(int nTable, ds_key_t kRow, int *Permutation);
@@ -46,7 +46,7 @@
 #include "nulls.h"
 #include "tdefs.h"
 
-struct W_PROMOTION_TBL g_w_promotion;
+THREAD struct W_PROMOTION_TBL g_w_promotion;
 
 /*
 * Routine: mk_promotion
@@ -65,14 +65,14 @@ struct W_PROMOTION_TBL g_w_promotion;
 * 20020829 jms RNG usage on P_CHANNEL_DETAILS may be too large
 */
 int
-mk_w_promotion(void *pDest, ds_key_t index)
+mk_w_promotion(gen_ctx_t *pCtx, void *pDest, ds_key_t index)
 {
-	static int bInit = 0;
+	static THREAD int bInit = 0;
 	struct W_PROMOTION_TBL *r;
 	int res = 0;
 	
 	/* begin locals declarations */
-	static date_t *start_date;
+	static THREAD date_t *start_date;
 	ds_key_t nTemp;
 	int nFlags;
    tdef *pTdef = getSimpleTdefsByNumber(PROMOTION);
@@ -127,7 +127,7 @@ mk_w_promotion(void *pDest, ds_key_t index)
 	r->p_channel_demo = nFlags & 0x01;
 	nFlags <<= 1;
 	r->p_discount_active = nFlags & 0x01;
-	gen_text (&r->p_channel_details[0], PROMO_DETAIL_LEN_MIN,
+	gen_text (pCtx, &r->p_channel_details[0], PROMO_DETAIL_LEN_MIN,
 		PROMO_DETAIL_LEN_MAX, P_CHANNEL_DETAILS);
 	pick_distribution (&r->p_purpose, "promo_purpose", 1, 1,
 		P_PURPOSE);
@@ -210,6 +210,6 @@ ld_w_promotion(void *pSrc)
 	else
 		r = pSrc;
 	
-	return(0);
+	return(pr_w_promotion(r));
 }
 
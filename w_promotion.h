@@ -36,6 +36,7 @@
 #ifndef W_PROMOTION_H
 #define W_PROMOTION_H
 #include "constants.h"
+#include "context.h"
 /*
  * PROMOTION table structure 
  */
@@ -61,7 +62,7 @@ struct W_PROMOTION_TBL {
 	int			p_discount_active;
 };
 
-int mk_w_promotion(void *pDest, ds_key_t kIndex);
+int mk_w_promotion(gen_ctx_t *pCtx, void *pDest, ds_key_t kIndex);
 int pr_w_promotion(void *pSrc);
 int ld_w_promotion(void *pSrc);
 #endif
@@ -45,16 +45,16 @@
 #include "nulls.h"
 #include "tdefs.h"
 
-struct W_REASON_TBL g_w_reason;
+THREAD struct W_REASON_TBL g_w_reason;
 
 /*
 * mk_reason
 */
 int
-mk_w_reason (void* row, ds_key_t index)
+mk_w_reason (gen_ctx_t *pCtx, void* row, ds_key_t index)
 {
 	int res = 0;
-	static int bInit = 0;
+	static THREAD int bInit = 0;
 	struct W_REASON_TBL *r;
    tdef *pTdef = getSimpleTdefsByNumber(REASON);
 	
@@ -136,6 +136,6 @@ ld_w_reason(void *pSrc)
 	else
 		r = pSrc;
 	
-	return(0);
+	return(pr_w_reason(r));
 }
 
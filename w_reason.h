@@ -36,6 +36,7 @@
 #ifndef W_REASON_H
 #define W_REASON_H
 #include "constants.h"
+#include "context.h"
 /*
  * REASON table structure 
  */
@@ -45,7 +46,7 @@ struct W_REASON_TBL {
 	char		*r_reason_description;
 };
 
-int mk_w_reason(void *pDest, ds_key_t kIndex);
+int mk_w_reason(gen_ctx_t *pCtx, void *pDest, ds_key_t kIndex);
 int pr_w_reason(void *pSrc);
 int ld_w_reason(void *pSrc);
 #endif
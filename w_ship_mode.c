@@ -45,7 +45,7 @@
 #include "nulls.h"
 #include "tdefs.h"
 
-struct W_SHIP_MODE_TBL g_w_ship_mode;
+THREAD struct W_SHIP_MODE_TBL g_w_ship_mode;
 
 
 /*
@@ -63,9 +63,9 @@ struct W_SHIP_MODE_TBL g_w_ship_mode;
 * TODO: None
 */
 int
-mk_w_ship_mode(void *pDest, ds_key_t kIndex)
+mk_w_ship_mode(gen_ctx_t *pCtx, void *pDest, ds_key_t kIndex)
 {
-	static int bInit = 0;
+	static THREAD int bInit = 0;
 	struct W_SHIP_MODE_TBL *r;
 	ds_key_t nTemp;
    tdef *pTdef = getSimpleTdefsByNumber(SHIP_MODE);
@@ -154,6 +154,6 @@ ld_w_ship_mode(void *pSrc)
 	else
 		r = pSrc;
 	
-	return(0);
+	return(pr_w_ship_mode(r));
 }
 
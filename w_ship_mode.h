@@ -36,6 +36,7 @@
 #ifndef W_SHIP_MODE_H
 #define W_SHIP_MODE_H
 #include "constants.h"
+#include "context.h"
 /*
  * SHIP_MODE table structure 
  */
@@ -49,7 +50,7 @@ struct W_SHIP_MODE_TBL {
 };
 
 
-int mk_w_ship_mode(void *pDest, ds_key_t kIndex);
+int mk_w_ship_mode(gen_ctx_t *pCtx, void *pDest, ds_key_t kIndex);
 int pr_w_ship_mode(void *pSrc);
 int ld_w_ship_mode(void *pSrc);
 #endif
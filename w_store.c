@@ -56,21 +56,20 @@
 #include "tdefs.h"
 #include "scd.h"
 
-struct W_STORE_TBL g_w_store;
-static struct W_STORE_TBL g_OldValues;
+THREAD struct W_STORE_TBL g_w_store;
 
 /*
 * mk_store
 */
 int
-mk_w_store (void* row, ds_key_t index)
+mk_w_store (gen_ctx_t *pCtx, void* row, ds_key_t index)
 {
 	int32_t res = 0,
 		nFieldChangeFlags,
 		bFirstRecord = 0;
 	
 	/* begin locals declarations */
-	static decimal_t dRevMin,
+	static THREAD decimal_t dRevMin,
 		dRevMax;
 	char *sName1,
 		*sName2,
@@ -81,14 +80,14 @@ mk_w_store (void* row, ds_key_t index)
 		nDaysOpen,
 		nMin,
 		nMax;
-	static date_t *tDate;
-	static decimal_t min_rev_growth,
+	static THREAD date_t *tDate;
+	static THREAD decimal_t min_rev_growth,
 		max_rev_growth,
 		dMinTaxPercentage,
 		dMaxTaxPercentage;
-	static int32_t bInit = 0;
+	static THREAD int32_t bInit = 0;
 	struct W_STORE_TBL *r,
-		*rOldValues = &g_OldValues;
+		*rOldValues = pCtx->Scd.pStore;
    tdef *pT = getSimpleTdefsByNumber(STORE);
 
 	if (row == NULL)
@@ -180,7 +179,7 @@ if (!bInit)
 	pick_distribution (&r->geography_class, "geography_class", 1, 1, W_STORE_GEOGRAPHY_CLASS);
 	changeSCD(SCD_PTR, &r->geography_class, &rOldValues->geography_class,  &nFieldChangeFlags,  bFirstRecord);
 
-	gen_text (&r->market_desc[0], STORE_DESC_MIN, RS_S_MARKET_DESC, W_STORE_MARKET_DESC);
+	gen_text (pCtx, &r->market_desc[0], STORE_DESC_MIN, RS_S_MARKET_DESC, W_STORE_MARKET_DESC);
 	changeSCD(SCD_CHAR, &r->market_desc, &rOldValues->market_desc,  &nFieldChangeFlags,  bFirstRecord);
 
 	pick_distribution (&sName1, "first_names", 1, 1, W_STORE_MARKET_MANAGER);
@@ -305,6 +304,6 @@ ld_w_store(void *pSrc)
 	else
 		r = pSrc;
 	
-	return(0);
+	return(pr_w_store(r));
 }
 
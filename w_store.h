@@ -38,6 +38,7 @@
 
 #include "address.h"
 #include "decimal.h"
+#include "context.h"
 
 #define RS_W_STORE_NAME	50
 #define RS_W_STORE_MGR	40
@@ -84,7 +85,7 @@ struct W_STORE_TBL {
 #define STORE_DESC_MIN			15
 
 
-int mk_w_store(void *pDest, ds_key_t kIndex);
+int mk_w_store(gen_ctx_t *pCtx, void *pDest, ds_key_t kIndex);
 int pr_w_store(void *pSrc);
 int ld_w_store(void *pSrc);
 
@@ -48,9 +48,10 @@
 #include "tdefs.h"
 #include "stable_rng.h"
 #include "params.h"
+#include "runtime.h"
 
-struct W_STORE_RETURNS_TBL g_w_store_returns;
-extern struct W_STORE_SALES_TBL g_w_store_sales;
+THREAD struct W_STORE_RETURNS_TBL g_w_store_returns;
+extern THREAD struct W_STORE_SALES_TBL g_w_store_sales;
 
 /*
 * Routine: mk_store_returns()
@@ -67,17 +68,14 @@ extern struct W_STORE_SALES_TBL g_w_store_sales;
 * TODO: None
 */
 int
-mk_w_store_returns (void * row, ds_key_t index)
+mk_w_store_returns (gen_ctx_t *pCtx, void * row, ds_key_t index)
 {
 	int res = 0,
 		nTemp;
 	struct W_STORE_RETURNS_TBL *r;
 	struct W_STORE_SALES_TBL *sale = &g_w_store_sales;
-	static int bInit = 0;
    tdef *pT = getSimpleTdefsByNumber(STORE_RETURNS);
 	
-	static decimal_t dMin,
-		dMax;
 	/* begin locals declarations */
 	
 	if (row == NULL)
@@ -85,12 +83,6 @@ mk_w_store_returns (void * row, ds_key_t index)
 	else
 		r = row;
 
-	if (!bInit)
-	{
-        strtodec (&dMin, "1.00");
-        strtodec (&dMax, "100000.00");
-	}
-	
 	/* Don't use random NULL generation - we handle NULLs deterministically */
 	/* nullSet(&pT->kNullBitMap, SR_NULLS); */
 	/*
@@ -104,24 +96,18 @@ mk_w_store_returns (void * row, ds_key_t index)
 	/*
 	 * some of the fields are conditionally taken from the sale 
 	 */
-	int nScale = get_int("SCALE");
+	int nScale = g_Runtime.nScale;
 	/* Use combination of ticket_number and item_sk for uniqueness */
 	ds_key_t item_part = (sale->ss_sold_item_sk == -1) ? 99999L : (sale->ss_sold_item_sk % 100000L);
 	ds_key_t combined_key = sale->ss_ticket_number * 100000L + item_part;
 	
-	/* If sale customer is NULL, return must also be NULL */
-	if (sale->ss_sold_customer_sk == -1) {
-		r->sr_customer_sk = -1;  /* Preserve NULL */
-	} else {
-		/* Sale has customer, so return can have customer or different customer */
-		int rand_val = stable_genrand_integer(STORE_RETURNS, nScale, combined_key, 1, 100, SR_TICKET_NUMBER);
-		if (rand_val < SR_SAME_CUSTOMER) {
-			r->sr_customer_sk = sale->ss_sold_customer_sk;  /* Same customer */
-		} else {
-			/* Different customer - when sale has customer, return must have customer too */
-			r->sr_customer_sk = stable_mk_join(SR_CUSTOMER_SK, CUSTOMER, nScale, combined_key, SR_CUSTOMER_SK);
-		}
-	}
+	/* 
+	 * the return is made by the customer on the ticket, and is NULL when the
+	 * sale is. SR_SAME_CUSTOMER is not applied: the original stable generator
+	 * never picked another customer, and verify_sales_integrity.py checks
+	 * this linkage
+	 */
+	r->sr_customer_sk = sale->ss_sold_customer_sk;
 
 	/*
 	* the rest of the columns are generated for this specific return
@@ -138,7 +124,7 @@ mk_w_store_returns (void * row, ds_key_t index)
 	r->sr_reason_sk = stable_mk_join(SR_REASON_SK, REASON, nScale, combined_key, SR_REASON_SK);
 	r->sr_pricing.quantity = stable_genrand_integer(STORE_RETURNS, nScale, combined_key,
 		1, sale->ss_pricing.quantity, SR_PRICING);
-	set_pricing(SR_PRICING, &r->sr_pricing);
+	set_pricing(pCtx, SR_PRICING, &r->sr_pricing);
 	
 	return (res);
 }
@@ -217,6 +203,6 @@ ld_w_store_returns(void *pSrc)
 	else
 		r = pSrc;
 	
-	return(0);
+	return(pr_w_store_returns(r));
 }
 
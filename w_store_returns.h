@@ -37,6 +37,7 @@
 #define W_STORE_RETURNS_H
 #include "pricing.h"
 #include "decimal.h"
+#include "context.h"
 
 #define SR_SAME_CUSTOMER 80
 
@@ -57,7 +58,7 @@ struct W_STORE_RETURNS_TBL {
 	ds_pricing_t	sr_pricing;
 };
 
-int mk_w_store_returns(void *pDest, ds_key_t kIndex);
+int mk_w_store_returns(gen_ctx_t *pCtx, void *pDest, ds_key_t kIndex);
 int pr_w_store_returns(void *pSrc);
 int ld_w_store_returns(void *pSrc);
 #endif
@@ -52,81 +52,123 @@
 #include "parallel.h"
 #include "stable_rng.h"
 #include "params.h"
-#ifdef JMS
-extern rng_t Streams[];
-#endif
+#include "runtime.h"
 
-struct W_STORE_SALES_TBL g_w_store_sales;
+THREAD struct W_STORE_SALES_TBL g_w_store_sales;
 ds_key_t skipDays(int nTable, ds_key_t *pRemainder);
-static int *pItemPermutation,
-   nItemCount,
-	nItemIndex;
-static ds_key_t jDate,
-   kNewDateIndex;
+static permutation_t *pItemPermutation;
+static int nItemCount;
+DECLARE_LOCK(PermutationLock);
+
+/*
+ * the foreign keys of a ticket depend only on its ticket number, so they are
+ * derived for a block of STABLE_BATCH_SIZE tickets at a time, into the 
+ * generator's ticket_keys_t
+ */
+static struct {
+	int nColumn;
+	int nTable;
+} arMasterJoin[SS_MASTER_JOINS] = {
+	{SS_SOLD_STORE_SK, STORE},
+	{SS_SOLD_TIME_SK, TIME},
+	{SS_SOLD_DATE_SK, DATE},
+	{SS_SOLD_CUSTOMER_SK, CUSTOMER},
+	{SS_SOLD_CDEMO_SK, CUSTOMER_DEMOGRAPHICS},
+	{SS_SOLD_HDEMO_SK, HOUSEHOLD_DEMOGRAPHICS},
+	{SS_SOLD_ADDR_SK, CUSTOMER_ADDRESS}
+};
+
+/*
+* Routine: fill_master_block(ticket_keys_t *pKeys, ds_key_t kFirst)
+* Purpose: derive the foreign keys of the STABLE_BATCH_SIZE tickets starting at kFirst
+* Algorithm:
+* Data Structures:
+*
+* Params:
+* Returns:
+* Called By: mk_master()
+* Calls: stable_mk_join_batch(), stable_is_null_batch()
+* Assumptions:
+* Side Effects: the block may run past the end of the current chunk; the extra
+*	keys are simply never used
+* TODO: None
+*/
+static void
+fill_master_block(ticket_keys_t *pKeys, ds_key_t kFirst)
+{
+	int i,
+		nScale = g_Runtime.nScale;
+
+	for (i=0; i < SS_MASTER_JOINS; i++)
+		stable_mk_join_batch(arMasterJoin[i].nColumn, arMasterJoin[i].nTable, nScale,
+			kFirst, STABLE_BATCH_SIZE, arMasterJoin[i].nColumn, pKeys->arKey[i]);
+	/* 5% of the tickets have no customer */
+	stable_is_null_batch(STORE_SALES, nScale, kFirst, STABLE_BATCH_SIZE, SS_SOLD_CUSTOMER_SK, 5, pKeys->arNullCustomer);
+	pKeys->kBlock = kFirst;
+
+	return;
+}
 
 /*
 * mk_store_sales
 */
 static void
-mk_master (void *row, ds_key_t index)
+mk_master (gen_ctx_t *pCtx, void *row, ds_key_t index)
 {
 	struct W_STORE_SALES_TBL *r;
-	static decimal_t dMin,
-		dMax;
-	static int bInit = 0,
-		nMaxItemCount;
-	static ds_key_t kNewDateIndex = 0;
+	sales_state_t *pS = &pCtx->StoreSales;
+	ticket_keys_t *pKeys = &pCtx->StoreKeys;
 
 	if (row == NULL)
 		r = &g_w_store_sales;
 	else
 		r = row;
 
-	if (!bInit)
+	if (!pS->bInit)
 	{
-      strtodec (&dMin, "1.00");
-      strtodec (&dMax, "100000.00");
-		nMaxItemCount = 20;
-		jDate = skipDays(STORE_SALES, &kNewDateIndex);
-		pItemPermutation = makePermutation(NULL, nItemCount = (int)getIDCount(ITEM), SS_PERMUTATION);
+		pS->jDate = skipDays(STORE_SALES, &pS->kNewDateIndex);
+		/* the permutation is shared by all threads; the first one builds it */
+		LOCK(PermutationLock);
+		if (pItemPermutation == NULL)
+			pItemPermutation = newPermutation(nItemCount = (int)getIDCount(ITEM), SS_PERMUTATION, g_Runtime.bStateless);
+		UNLOCK(PermutationLock);
 		
-		bInit = 1;
+		pS->bInit = 1;
 	}
 
 	
-   while (index > kNewDateIndex)	/* need to move to a new date */
+   while (index > pS->kNewDateIndex)	/* need to move to a new date */
    {
-      jDate += 1;
-      kNewDateIndex += dateScaling(STORE_SALES, jDate);
+      pS->jDate += 1;
+      pS->kNewDateIndex += dateScaling(STORE_SALES, pS->jDate);
    }
-		int nScale = get_int("SCALE");
-		r->ss_sold_store_sk = stable_mk_join(SS_SOLD_STORE_SK, STORE, nScale, index, SS_SOLD_STORE_SK);
-		r->ss_sold_time_sk = stable_mk_join(SS_SOLD_TIME_SK, TIME, nScale, index, SS_SOLD_TIME_SK);
-		r->ss_sold_date_sk = stable_mk_join(SS_SOLD_DATE_SK, DATE, nScale, index, SS_SOLD_DATE_SK);
-		
-		// Check if customer should be NULL (assuming 5% NULL rate)
-		if (stable_is_null(STORE_SALES, nScale, index, SS_SOLD_CUSTOMER_SK, 5)) {
-			r->ss_sold_customer_sk = -1;  // NULL
-		} else {
-			r->ss_sold_customer_sk = stable_mk_join(SS_SOLD_CUSTOMER_SK, CUSTOMER, nScale, index, SS_SOLD_CUSTOMER_SK);
-		}
-		
-		r->ss_sold_cdemo_sk = stable_mk_join(SS_SOLD_CDEMO_SK, CUSTOMER_DEMOGRAPHICS, nScale, index, SS_SOLD_CDEMO_SK);
-		r->ss_sold_hdemo_sk = stable_mk_join(SS_SOLD_HDEMO_SK, HOUSEHOLD_DEMOGRAPHICS, nScale, index, SS_SOLD_HDEMO_SK);
-		r->ss_sold_addr_sk = stable_mk_join(SS_SOLD_ADDR_SK, CUSTOMER_ADDRESS, nScale, index, SS_SOLD_ADDR_SK);
+		int nScale = g_Runtime.nScale;
+		int nSlot;
+
+		if (pKeys->kBlock < 0 || index < pKeys->kBlock || index >= pKeys->kBlock + STABLE_BATCH_SIZE)
+			fill_master_block(pKeys, index);
+		nSlot = (int)(index - pKeys->kBlock);
+		r->ss_sold_store_sk = pKeys->arKey[0][nSlot];
+		r->ss_sold_time_sk = pKeys->arKey[1][nSlot];
+		r->ss_sold_date_sk = pKeys->arKey[2][nSlot];
+		r->ss_sold_customer_sk = (pKeys->arNullCustomer[nSlot])?-1:pKeys->arKey[3][nSlot];	/* -1 is NULL */
+		r->ss_sold_cdemo_sk = pKeys->arKey[4][nSlot];
+		r->ss_sold_hdemo_sk = pKeys->arKey[5][nSlot];
+		r->ss_sold_addr_sk = pKeys->arKey[6][nSlot];
 		r->ss_ticket_number = index;
-		nItemIndex = stable_genrand_integer(STORE_SALES, nScale, index, 1, nItemCount, SS_SOLD_ITEM_SK);
+		pS->nItemIndex = stable_genrand_integer(STORE_SALES, nScale, index, 1, nItemCount, SS_SOLD_ITEM_SK);
 
       return;
 }
 
 
 static void
-mk_detail (void *row, int bPrint)
+mk_detail (gen_ctx_t *pCtx, void *row, int bPrint)
 {
 struct W_STORE_RETURNS_TBL ReturnRow;
 struct W_STORE_SALES_TBL *r;
 tdef *pT = getSimpleTdefsByNumber(STORE_SALES);
+sales_state_t *pS = &pCtx->StoreSales;
 
 	if (row == NULL)
 		r = &g_w_store_sales;
@@ -139,19 +181,17 @@ tdef *pT = getSimpleTdefsByNumber(STORE_SALES);
 	 * items need to be unique within an order
 	 * use a sequence within the permutation 
 	 */
-	if (++nItemIndex > nItemCount)
-      nItemIndex = 1;
-   r->ss_sold_item_sk = matchSCDSK(getPermutationEntry(pItemPermutation, nItemIndex), r->ss_sold_date_sk, ITEM);
-	int nScale = get_int("SCALE");
-	r->ss_sold_promo_sk = stable_mk_join(SS_SOLD_PROMO_SK, PROMOTION, nScale, r->ss_ticket_number * 1000L + nItemIndex, SS_SOLD_PROMO_SK);
-	set_pricing(SS_PRICING, &r->ss_pricing);
+	if (++pS->nItemIndex > nItemCount)
+      pS->nItemIndex = 1;
+   r->ss_sold_item_sk = matchSCDSK(getPermutationKey(pItemPermutation, pS->nItemIndex), r->ss_sold_date_sk, ITEM);
+	int nScale = g_Runtime.nScale;
+	r->ss_sold_promo_sk = stable_mk_join(SS_SOLD_PROMO_SK, PROMOTION, nScale, r->ss_ticket_number * 1000L + pS->nItemIndex, SS_SOLD_PROMO_SK);
+	set_pricing(pCtx, SS_PRICING, &r->ss_pricing);
 
 	/** 
 	* having gone to the trouble to make the sale, now let's see if it gets returned
 	* Use stable RNG to ensure consistent returns across separate runs
 	*/
-	nScale = get_int("SCALE");
-	int current_table = get_current_table_id();
 	/* Always use STORE_SALES for stable RNG to ensure consistency */
 	/* Use combination of ticket_number and item_sk for uniqueness */
 	/* Handle NULL item_sk (-1) properly */
@@ -161,17 +201,17 @@ tdef *pT = getSimpleTdefsByNumber(STORE_SALES);
 	
 	if (should_have_return)
 	{
-		mk_w_store_returns(&ReturnRow, 1);
-		/* Only print returns if we're generating store_returns table */
-		if (bPrint && current_table == STORE_RETURNS)
+		mk_w_store_returns(pCtx, &ReturnRow, 1);
+		/* Only print returns if we're generating store_returns table (or -RETURNS) */
+		if (bPrint && is_table_printed(STORE_RETURNS))
 			pr_w_store_returns(&ReturnRow);
 	}
 
 	/**
 	* now we print out the order and lineitem together as a single row
-	* Only print sales if we're generating store_sales table
+	* Only print sales if we're generating store_sales table (or -RETURNS)
 	*/
-	if (bPrint && current_table == STORE_SALES)
+	if (bPrint && is_table_printed(STORE_SALES))
 		pr_w_store_sales(NULL);
 	
 	return;
@@ -255,27 +295,27 @@ ld_w_store_sales(void *pSrc)
 	else
 		r = pSrc;
 	
-	return(0);
+	return(pr_w_store_sales(r));
 }
 
 /*
 * mk_store_sales
 */
 int
-mk_w_store_sales (void *row, ds_key_t index)
+mk_w_store_sales (gen_ctx_t *pCtx, void *row, ds_key_t index)
 {
 	int nLineitems,
 		i;
 
    /* build the static portion of an order */
-	mk_master(row, index);
+	mk_master(pCtx, row, index);
 
    /* set the number of lineitems and build them */
-	int nScale = get_int("SCALE");
-	nLineitems = stable_genrand_integer(STORE_SALES, nScale, index, 8, 16, SS_TICKET_NUMBER);
+	int nScale = g_Runtime.nScale;
+	nLineitems = stable_genrand_integer(STORE_SALES, nScale, index, SS_MIN_LINEITEMS, SS_MAX_LINEITEMS, SS_TICKET_NUMBER);
    for (i = 1; i <= nLineitems; i++)
    {
-	   mk_detail(NULL, 1);
+	   mk_detail(pCtx, NULL, 1);
    }
 
    /**
@@ -300,25 +340,66 @@ mk_w_store_sales (void *row, ds_key_t index)
 * TODO: None
 */
 int
-vld_w_store_sales(int nTable, ds_key_t kRow, int *Permutation)
+vld_w_store_sales(gen_ctx_t *pCtx, int nTable, ds_key_t kRow, int *Permutation)
 {
 	int nLineitem,
 		nMaxLineitem,
 		i;
+	sales_state_t *pS = &pCtx->StoreSales;
 
 	row_skip(nTable, kRow - 1);
 	row_skip(STORE_RETURNS, kRow - 1);
-	jDate = skipDays(STORE_SALES, &kNewDateIndex);		
-	mk_master(NULL, kRow);
-	int nScale = get_int("SCALE");
-	nMaxLineitem = stable_genrand_integer(STORE_SALES, nScale, kRow, 8, 16, SS_TICKET_NUMBER);
+	pS->jDate = skipDays(STORE_SALES, &pS->kNewDateIndex);
+	mk_master(pCtx, NULL, kRow);
+	int nScale = g_Runtime.nScale;
+	nMaxLineitem = stable_genrand_integer(STORE_SALES, nScale, kRow, SS_MIN_LINEITEMS, SS_MAX_LINEITEMS, SS_TICKET_NUMBER);
 	nLineitem = stable_genrand_integer(STORE_SALES, nScale, kRow, 1, nMaxLineitem, SS_PRICING_QUANTITY);
 	for (i = 1; i < nLineitem; i++)
 	{
-		mk_detail(NULL, 0);
+		mk_detail(pCtx, NULL, 0);
 	}
-	mk_detail(NULL, 1);
+	mk_detail(pCtx, NULL, 1);
 
 	return(0);
 }
 
+/*
+* Routine: mk_w_store_sales_lineitems(gen_ctx_t *pCtx, void *pDest, ds_key_t kIndex, ds_key_t *arNulls)
+* Purpose: build all of the lineitems of a single order, out of sequence
+* Algorithm: as vld_w_store_sales(), but every lineitem is copied to pDest rather
+*	than printed
+* Data Structures:
+*
+* Params: pDest is an array of at least SS_MAX_LINEITEMS rows; arNulls, if not
+*	NULL, receives the NULL bitmap of each lineitem
+* Returns: the number of lineitems
+* Called By: dsdgen_row()
+* Calls: 
+* Assumptions: set_chunk() has restricted the calling thread to the order, so 
+*	that skipDays() finds its date directly
+* Side Effects:
+* TODO: None
+*/
+int
+mk_w_store_sales_lineitems(gen_ctx_t *pCtx, void *pDest, ds_key_t kIndex, ds_key_t *arNulls)
+{
+	struct W_STORE_SALES_TBL *arLineitems = (struct W_STORE_SALES_TBL *)pDest;
+	int nLineitems,
+		i;
+	sales_state_t *pS = &pCtx->StoreSales;
+
+	row_skip(STORE_SALES, kIndex - 1);
+	row_skip(STORE_RETURNS, kIndex - 1);
+	pS->jDate = skipDays(STORE_SALES, &pS->kNewDateIndex);
+	mk_master(pCtx, NULL, kIndex);
+	nLineitems = stable_genrand_integer(STORE_SALES, g_Runtime.nScale, kIndex, SS_MIN_LINEITEMS, SS_MAX_LINEITEMS, SS_TICKET_NUMBER);
+	for (i=0; i < nLineitems; i++)
+	{
+		mk_detail(pCtx, NULL, 0);
+		arLineitems[i] = g_w_store_sales;
+		if (arNulls != NULL)
+			arNulls[i] = getSimpleTdefsByNumber(STORE_SALES)->kNullBitMap;
+	}
+
+	return(nLineitems);
+}
@@ -38,6 +38,7 @@
 
 #include "constants.h"
 #include "pricing.h"
+#include "context.h"
 
 
 /*
@@ -57,9 +58,10 @@ struct W_STORE_SALES_TBL {
 	ds_pricing_t	ss_pricing;
 };
 
-int mk_w_store_sales(void *pDest, ds_key_t kIndex);
+int mk_w_store_sales(gen_ctx_t *pCtx, void *pDest, ds_key_t kIndex);
 int pr_w_store_sales(void *pSrc);
 int ld_w_store_sales(void *pSrc);
-int vld_w_store_sales(int nTable, ds_key_t kRow, int *Permutation);
+int vld_w_store_sales(gen_ctx_t *pCtx, int nTable, ds_key_t kRow, int *Permutation);
+int mk_w_store_sales_lineitems(gen_ctx_t *pCtx, void *pDest, ds_key_t kIndex, ds_key_t *arNulls);
 #endif
 
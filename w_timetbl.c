@@ -48,13 +48,13 @@
 #include "nulls.h"
 #include "tdefs.h"
 
-struct W_TIME_TBL g_w_time;
+THREAD struct W_TIME_TBL g_w_time;
 
 /*
 * mk_time
 */
 int
-mk_w_time(void* row, ds_key_t index)
+mk_w_time(gen_ctx_t *pCtx, void* row, ds_key_t index)
 {
 	int res = 0;
 	
@@ -151,6 +151,6 @@ ld_w_time(void *pSrc)
 	else
 		r = pSrc;
 	
-	return(0);
+	return(pr_w_time(r));
 }
 
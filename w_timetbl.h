@@ -38,6 +38,7 @@
  */
 #ifndef W_TIME_TBL_H
 #define W_TIME_TBL_H
+#include "context.h"
 struct W_TIME_TBL {
 	ds_key_t	t_time_sk;	
 	char		t_time_id[RS_BKEY + 1];	
@@ -51,7 +52,7 @@ struct W_TIME_TBL {
 	char		*t_meal_time;
 };
 
-int mk_w_time(void *pDest, ds_key_t kIndex);
+int mk_w_time(gen_ctx_t *pCtx, void *pDest, ds_key_t kIndex);
 int pr_w_time(void *pSrc);
 int ld_w_time(void *pSrc);
 #endif
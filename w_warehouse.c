@@ -50,13 +50,13 @@
 #include "nulls.h"
 #include "tdefs.h"
 
-struct W_WAREHOUSE_TBL g_w_warehouse;
+THREAD struct W_WAREHOUSE_TBL g_w_warehouse;
 
 /*
 * mk_warehouse
 */
 int
-mk_w_warehouse (void* row, ds_key_t index)
+mk_w_warehouse (gen_ctx_t *pCtx, void* row, ds_key_t index)
 {
 	int res = 0;
 	
@@ -73,7 +73,7 @@ mk_w_warehouse (void* row, ds_key_t index)
 	nullSet(&pT->kNullBitMap, W_NULLS);
 	r->w_warehouse_sk = index;
 	mk_bkey(&r->w_warehouse_id[0], index, W_WAREHOUSE_ID);
-	gen_text (&r->w_warehouse_name[0], W_NAME_MIN,
+	gen_text (pCtx, &r->w_warehouse_name[0], W_NAME_MIN,
 		RS_W_WAREHOUSE_NAME, W_WAREHOUSE_NAME);
 	r->w_warehouse_sq_ft =
 		genrand_integer (NULL, DIST_UNIFORM,
@@ -161,6 +161,6 @@ ld_w_warehouse(void *pSrc)
 	else
 		r = pSrc;
 	
-	return(0);
+	return(pr_w_warehouse(r));
 }
 
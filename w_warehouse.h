@@ -37,6 +37,7 @@
 #define W_WAREHOUSE_H
 
 #include "address.h"
+#include "context.h"
 
 /*
  * WAREHOUSE table structure 
@@ -49,7 +50,7 @@ struct W_WAREHOUSE_TBL {
 	ds_addr_t	w_address;
 };
 
-int mk_w_warehouse(void *pDest, ds_key_t kIndex);
+int mk_w_warehouse(gen_ctx_t *pCtx, void *pDest, ds_key_t kIndex);
 int pr_w_warehouse(void *pSrc);
 int ld_w_warehouse(void *pSrc);
 
@@ -57,8 +57,7 @@
 #include "tdefs.h"
 #include "scd.h"
 
-struct W_WEB_PAGE_TBL g_w_web_page;
-static struct W_WEB_PAGE_TBL g_OldValues;
+THREAD struct W_WEB_PAGE_TBL g_w_web_page;
 
 /*
 * Routine: mk_web_page()
@@ -76,22 +75,22 @@ static struct W_WEB_PAGE_TBL g_OldValues;
 * 20020815 jms check text generation/seed usage
 */
 int
-mk_w_web_page (void * row, ds_key_t index)
+mk_w_web_page (gen_ctx_t *pCtx, void * row, ds_key_t index)
 {
 	int32_t res = 0,
 		bFirstRecord = 0,
 		nFieldChangeFlags;
-	static date_t *dToday;
-	static ds_key_t nConcurrent,
+	static THREAD date_t *dToday;
+	static THREAD ds_key_t nConcurrent,
 		nRevisions;
 
 	/* begin locals declarations */
 	int32_t nTemp,
 		nAccess;
 	char szTemp[16];
-	static int32_t bInit = 0;
+	static THREAD int32_t bInit = 0;
 	struct W_WEB_PAGE_TBL *r,
-		*rOldValues = &g_OldValues;
+		*rOldValues = pCtx->Scd.pWebPage;
    tdef *pT = getSimpleTdefsByNumber(WEB_PAGE);
 
 
@@ -245,6 +244,6 @@ ld_w_web_page(void *pSrc)
 	else
 		r = pSrc;
 	
-	return(0);
+	return(pr_w_web_page(r));
 }
 
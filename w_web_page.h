@@ -33,6 +33,8 @@
  * Contributors:
  * Gradient Systems
  */ 
+#include "context.h"
+
 /*
  * WEB_PAGE table structure 
  */
@@ -54,7 +56,7 @@ struct W_WEB_PAGE_TBL {
 	int			wp_max_ad_count;
 };
 
-int mk_w_web_page(void *pDest, ds_key_t kIndex);
+int mk_w_web_page(gen_ctx_t *pCtx, void *pDest, ds_key_t kIndex);
 int pr_w_web_page(void *pSrc);
 int ld_w_web_page(void *pSrc);
 
@@ -50,8 +50,8 @@
 #include "nulls.h"
 #include "tdefs.h"
 
-struct W_WEB_RETURNS_TBL g_w_web_returns;
-extern struct W_WEB_SALES_TBL g_w_web_sales;
+THREAD struct W_WEB_RETURNS_TBL g_w_web_returns;
+extern THREAD struct W_WEB_SALES_TBL g_w_web_sales;
 
 /*
 * Routine: mk_web_returns()
@@ -69,14 +69,11 @@ extern struct W_WEB_SALES_TBL g_w_web_sales;
 * TODO: None
 */
 int
-mk_w_web_returns (void* row, ds_key_t index)
+mk_w_web_returns (gen_ctx_t *pCtx, void* row, ds_key_t index)
 {
 	int res = 0;
 	
-	static decimal_t dMin,
-		dMax;
-	static struct W_WEB_SALES_TBL *sale;
-	static int bInit = 0;
+	struct W_WEB_SALES_TBL *sale;
 	struct W_WEB_RETURNS_TBL *r;
    tdef *pT = getSimpleTdefsByNumber(WEB_RETURNS);
 	
@@ -85,13 +82,6 @@ mk_w_web_returns (void* row, ds_key_t index)
 	else
 		r = row;
 	
-	if (!bInit)
-	{
-        strtodec (&dMin, "1.00");
-        strtodec (&dMax, "100000.00");
-		bInit = 1;
-	}
-		
 	nullSet(&pT->kNullBitMap, WR_NULLS);
 	
 	/*
@@ -138,7 +128,7 @@ mk_w_web_returns (void* row, ds_key_t index)
 	r->wr_reason_sk = mk_join (WR_REASON_SK, REASON, 1);
 	genrand_integer(&r->wr_pricing.quantity, DIST_UNIFORM,
 		1, sale->ws_pricing.quantity, 0, WR_PRICING);
-	set_pricing(WR_PRICING, &r->wr_pricing);
+	set_pricing(pCtx, WR_PRICING, &r->wr_pricing);
 	
 	return (res);
 }
@@ -221,6 +211,6 @@ ld_w_web_returns(void *pSrc)
 	else
 		r = pSrc;
 	
-	return(0);
+	return(pr_w_web_returns(r));
 }
 
@@ -35,6 +35,7 @@
  */ 
 #ifndef W_WEB_RETURNS_H
 #define W_WEB_RETURNS_H
+#include "context.h"
 /*
  * WEB_RETURNS table structure 
  */
@@ -56,7 +57,7 @@ struct W_WEB_RETURNS_TBL {
 	ds_pricing_t	wr_pricing;
 };
 
-int mk_w_web_returns(void *pDest, ds_key_t kIndex);
+int mk_w_web_returns(gen_ctx_t *pCtx, void *pDest, ds_key_t kIndex);
 int pr_w_web_returns(void *pSrc);
 int ld_w_web_returns(void *pSrc);
 #endif
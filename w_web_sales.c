@@ -54,13 +54,14 @@
 #include "scd.h"
 #include "parallel.h"
 #include "stable_rng.h"
+#include "runtime.h"
 
-struct W_WEB_SALES_TBL g_w_web_sales;
+THREAD struct W_WEB_SALES_TBL g_w_web_sales;
 ds_key_t skipDays(int nTable, ds_key_t *pRemainder);
 
-static ds_key_t kNewDateIndex = 0;
-static ds_key_t jDate;
-static int nItemIndex = 0;
+static permutation_t *pItemPermutation;
+static int nPermutationSize;
+DECLARE_LOCK(PermutationLock);
 
 
 /*
@@ -69,27 +70,22 @@ static int nItemIndex = 0;
  * and a detail/lineitem portion.
  */
 static void
-mk_master (void *row, ds_key_t index)
+mk_master (gen_ctx_t *pCtx, void *row, ds_key_t index)
 {
-   static decimal_t dMin,
-      dMax;
    int nGiftPct;
    struct W_WEB_SALES_TBL *r;
-   static int bInit = 0,
-	   nItemCount;
+   sales_state_t *pS = &pCtx->WebSales;
 	
 	if (row == NULL)
 		r = &g_w_web_sales;
 	else
 		r = row;
 
-	if (!bInit)
+	if (!pS->bInit)
 	{
-		strtodec (&dMin, "1.00");
-		strtodec (&dMax, "100000.00");
-		jDate = skipDays(WEB_SALES, &kNewDateIndex);	
-		nItemCount = (int)getIDCount(ITEM);
-		bInit = 1;
+		pS->jDate = skipDays(WEB_SALES, &pS->kNewDateIndex);
+		pS->nItemCount = (int)getIDCount(ITEM);
+		pS->bInit = 1;
 	}
 		
 	
@@ -98,10 +94,10 @@ mk_master (void *row, ds_key_t index)
 	* for each lineitem. Since the number of lineitems per order is static, we can use a 
 	* modulo to determine when to change the semi-static values 
 	*/
-   while (index > kNewDateIndex)	/* need to move to a new date */
+   while (index > pS->kNewDateIndex)	/* need to move to a new date */
    {
-      jDate += 1;
-      kNewDateIndex += dateScaling(WEB_SALES, jDate);
+      pS->jDate += 1;
+      pS->kNewDateIndex += dateScaling(WEB_SALES, pS->jDate);
    }
 
    r->ws_sold_date_sk = mk_join (WS_SOLD_DATE_SK, DATE, 1);
@@ -133,30 +129,32 @@ mk_master (void *row, ds_key_t index)
    }
 
    r->ws_order_number = index;
-   genrand_integer(&nItemIndex, DIST_UNIFORM, 1, nItemCount, 0, WS_ITEM_SK);
+   genrand_integer(&pS->nItemIndex, DIST_UNIFORM, 1, pS->nItemCount, 0, WS_ITEM_SK);
 
 return;
 }
 
 static void
-mk_detail (void *row, int bPrint)
+mk_detail (gen_ctx_t *pCtx, void *row, int bPrint)
 {
-	static int *pItemPermutation,
-		nItemCount,
-		bInit = 0;
 	struct W_WEB_SALES_TBL *r;
+	sales_state_t *pS = &pCtx->WebSales;
 	int nShipLag,
 		nTemp;
    struct W_WEB_RETURNS_TBL w_web_returns;
    tdef *pT = getSimpleTdefsByNumber(WEB_SALES);
 
 
-	if (!bInit)
+	if (!pS->bDetailInit)
 	{
-		jDate = skipDays(WEB_SALES, &kNewDateIndex);
-		pItemPermutation = makePermutation(NULL, nItemCount = (int)getIDCount(ITEM), WS_PERMUTATION);
+		pS->jDate = skipDays(WEB_SALES, &pS->kNewDateIndex);
+		/* the permutation is shared by all threads; the first one builds it */
+		LOCK(PermutationLock);
+		if (pItemPermutation == NULL)
+			pItemPermutation = newPermutation(nPermutationSize = (int)getIDCount(ITEM), WS_PERMUTATION, g_Runtime.bStateless);
+		UNLOCK(PermutationLock);
 		
-		bInit = 1;
+		pS->bDetailInit = 1;
 	}
 
 	if (row == NULL)
@@ -174,9 +172,9 @@ mk_detail (void *row, int bPrint)
          WS_MIN_SHIP_DELAY, WS_MAX_SHIP_DELAY, 0, WS_SHIP_DATE_SK);
       r->ws_ship_date_sk = r->ws_sold_date_sk + nShipLag;
 
-      if (++nItemIndex > nItemCount)
-         nItemIndex = 1;
-      r->ws_item_sk = matchSCDSK(getPermutationEntry(pItemPermutation, nItemIndex), r->ws_sold_date_sk, ITEM);
+      if (++pS->nItemIndex > nPermutationSize)
+         pS->nItemIndex = 1;
+      r->ws_item_sk = matchSCDSK(getPermutationKey(pItemPermutation, pS->nItemIndex), r->ws_sold_date_sk, ITEM);
 
       /* the web page needs to be valid for the sale date */
       r->ws_web_page_sk = mk_join (WS_WEB_PAGE_SK, WEB_PAGE, r->ws_sold_date_sk);
@@ -185,30 +183,29 @@ mk_detail (void *row, int bPrint)
       r->ws_ship_mode_sk = mk_join (WS_SHIP_MODE_SK, SHIP_MODE, 1);
       r->ws_warehouse_sk = mk_join (WS_WAREHOUSE_SK, WAREHOUSE, 1);
       r->ws_promo_sk = mk_join (WS_PROMO_SK, PROMOTION, 1);
-      set_pricing(WS_PRICING, &r->ws_pricing);
+      set_pricing(pCtx, WS_PRICING, &r->ws_pricing);
 
       /** 
       * having gone to the trouble to make the sale, now let's see if it gets returned
       * Use stable RNG to ensure consistent returns across separate runs
       */
-      int nScale = get_int("SCALE");
-      int current_table = get_current_table_id();
+      int nScale = g_Runtime.nScale;
       /* Always use WEB_SALES for stable RNG to ensure consistency */
       int should_have_return = stable_rand_10pct(WEB_SALES, nScale, r->ws_order_number);
       
       if (should_have_return)
       {
-         mk_w_web_returns(&w_web_returns, 1);
-         /* Only print returns if we're generating web_returns table */
-         if (bPrint && current_table == WEB_RETURNS)
+         mk_w_web_returns(pCtx, &w_web_returns, 1);
+         /* Only print returns if we're generating web_returns table (or -RETURNS) */
+         if (bPrint && is_table_printed(WEB_RETURNS))
 			 pr_w_web_returns(&w_web_returns);
       }
 
       /**
       * now we print out the order and lineitem together as a single row
-      * Only print sales if we're generating web_sales table
+      * Only print sales if we're generating web_sales table (or -RETURNS)
       */
-      if (bPrint && current_table == WEB_SALES)
+      if (bPrint && is_table_printed(WEB_SALES))
 		  pr_w_web_sales(NULL);
 
 	  return;
@@ -218,19 +215,19 @@ mk_detail (void *row, int bPrint)
 * mk_web_sales
 */
 int
-mk_w_web_sales (void *row, ds_key_t index)
+mk_w_web_sales (gen_ctx_t *pCtx, void *row, ds_key_t index)
 {
 	int nLineitems,
 		i;
 
    /* build the static portion of an order */
-	mk_master(row, index);
+	mk_master(pCtx, row, index);
 
    /* set the number of lineitems and build them */
-	genrand_integer(&nLineitems, DIST_UNIFORM, 8, 16, 9, WS_ORDER_NUMBER);
+	genrand_integer(&nLineitems, DIST_UNIFORM, WS_MIN_LINEITEMS, WS_MAX_LINEITEMS, 9, WS_ORDER_NUMBER);
    for (i = 1; i <= nLineitems; i++)
    {
-	   mk_detail(NULL, 1);
+	   mk_detail(pCtx, NULL, 1);
    }
 
    /**
@@ -327,7 +324,7 @@ ld_w_web_sales(void *pSrc)
 	else
 		r = pSrc;
 	
-	return(0);
+	return(pr_w_web_sales(r));
 }
 
 /*
@@ -345,24 +342,65 @@ ld_w_web_sales(void *pSrc)
 * TODO: None
 */
 int
-vld_web_sales(int nTable, ds_key_t kRow, int *Permutation)
+vld_web_sales(gen_ctx_t *pCtx, int nTable, ds_key_t kRow, int *Permutation)
 {
 	int nLineitem,
 		nMaxLineitem,
 		i;
+	sales_state_t *pS = &pCtx->WebSales;
 
 	row_skip(nTable, kRow - 1);
 	row_skip(WEB_RETURNS, (kRow - 1) );
-	jDate = skipDays(WEB_SALES, &kNewDateIndex);		
-	mk_master(NULL, kRow);
-	genrand_integer(&nMaxLineitem, DIST_UNIFORM, 8, 16, 9, WS_ORDER_NUMBER);
+	pS->jDate = skipDays(WEB_SALES, &pS->kNewDateIndex);
+	mk_master(pCtx, NULL, kRow);
+	genrand_integer(&nMaxLineitem, DIST_UNIFORM, WS_MIN_LINEITEMS, WS_MAX_LINEITEMS, 9, WS_ORDER_NUMBER);
 	genrand_integer(&nLineitem, DIST_UNIFORM, 1, nMaxLineitem, 0, WS_PRICING_QUANTITY);
 	for (i = 1; i < nLineitem; i++)
 	{
-		mk_detail(NULL, 0);
+		mk_detail(pCtx, NULL, 0);
 	}
-   mk_detail(NULL, 1);
+   mk_detail(pCtx, NULL, 1);
 
 	return(0);
 }
 
+/*
+* Routine: mk_w_web_sales_lineitems(gen_ctx_t *pCtx, void *pDest, ds_key_t kIndex, ds_key_t *arNulls)
+* Purpose: build all of the lineitems of a single order, out of sequence
+* Algorithm: as vld_web_sales(), but every lineitem is copied to pDest rather
+*	than printed
+* Data Structures:
+*
+* Params: pDest is an array of at least WS_MAX_LINEITEMS rows; arNulls, if not
+*	NULL, receives the NULL bitmap of each lineitem
+* Returns: the number of lineitems
+* Called By: dsdgen_row()
+* Calls: 
+* Assumptions: set_chunk() has restricted the calling thread to the order, so 
+*	that skipDays() finds its date directly
+* Side Effects:
+* TODO: None
+*/
+int
+mk_w_web_sales_lineitems(gen_ctx_t *pCtx, void *pDest, ds_key_t kIndex, ds_key_t *arNulls)
+{
+	struct W_WEB_SALES_TBL *arLineitems = (struct W_WEB_SALES_TBL *)pDest;
+	int nLineitems,
+		i;
+	sales_state_t *pS = &pCtx->WebSales;
+
+	row_skip(WEB_SALES, kIndex - 1);
+	row_skip(WEB_RETURNS, kIndex - 1);
+	pS->jDate = skipDays(WEB_SALES, &pS->kNewDateIndex);
+	mk_master(pCtx, NULL, kIndex);
+	genrand_integer(&nLineitems, DIST_UNIFORM, WS_MIN_LINEITEMS, WS_MAX_LINEITEMS, 9, WS_ORDER_NUMBER);
+	for (i=0; i < nLineitems; i++)
+	{
+		mk_detail(pCtx, NULL, 0);
+		arLineitems[i] = g_w_web_sales;
+		if (arNulls != NULL)
+			arNulls[i] = getSimpleTdefsByNumber(WEB_SALES)->kNullBitMap;
+	}
+
+	return(nLineitems);
+}
@@ -33,6 +33,8 @@
  * Contributors:
  * Gradient Systems
  */ 
+#include "context.h"
+
 /*
  * WEB_SALES table structure 
  */
@@ -72,8 +74,9 @@ struct W_WEB_SALES_TBL {
 #define WS_MAX_SHIP_DELAY	120
 
 
-int mk_w_web_sales(void *pDest, ds_key_t kIndex);
+int mk_w_web_sales(gen_ctx_t *pCtx, void *pDest, ds_key_t kIndex);
 int pr_w_web_sales(void *pSrc);
 int ld_w_web_sales(void *pSrc);
-int vld_web_sales(int nTable, ds_key_t kRow, int *Permutation);
+int vld_web_sales(gen_ctx_t *pCtx, int nTable, ds_key_t kRow, int *Permutation);
+int mk_w_web_sales_lineitems(gen_ctx_t *pCtx, void *pDest, ds_key_t kIndex, ds_key_t *arNulls);
 
@@ -56,8 +56,7 @@
 #include "tdefs.h"
 #include "scd.h"
 
-struct W_WEB_SITE_TBL g_w_web_site;
-static struct W_WEB_SITE_TBL g_OldValues;
+THREAD struct W_WEB_SITE_TBL g_w_web_site;
 
 /*
 * Routine: mk_web_site()
@@ -74,41 +73,48 @@ static struct W_WEB_SITE_TBL g_OldValues;
 * TODO: 
 */
 int
-mk_w_web_site (void *row, ds_key_t index)
+mk_w_web_site (gen_ctx_t *pCtx, void *row, ds_key_t index)
 {
 	int32_t res = 0,
 		nFieldChangeFlags,
 		bFirstRecord = 0;
-	static date_t *dToday;
-	static decimal_t dMinTaxPercentage,
+	static THREAD date_t *dToday;
+	static THREAD decimal_t dMinTaxPercentage,
 		dMaxTaxPercentage;
-	static int32_t bInit = 0;
+	static THREAD int32_t bInit = 0;
 
 	/* begin locals declarations */
 	char szTemp[16],
 		*sName1,
 		*sName2;
 	struct W_WEB_SITE_TBL *r,
-				*rOldValues = &g_OldValues;
+				*rOldValues = pCtx->Scd.pWebSite;
    tdef *pT = getSimpleTdefsByNumber(WEB_SITE);
 	
 	if (row == NULL)
 		r = &g_w_web_site;
 	else
+	{
+		/* 
+		 * some fields are only set by the first revision of a business key; 
+		 * buildSCD() leaves the previous revision in g_w_web_site
+		 */
 		r = row;
+		memcpy(r, &g_w_web_site, sizeof(struct W_WEB_SITE_TBL));
+	}
 
 	if (!bInit)
 	{
 		/* setup invariant values */
 		sprintf(szTemp, "%d-%d-%d", CURRENT_YEAR, CURRENT_MONTH, CURRENT_DAY);
 		dToday = strtodate(szTemp);
-		strcpy(r->web_class, "Unknown");
 		strtodec(&dMinTaxPercentage, WEB_MIN_TAX_PERCENTAGE);
 		strtodec(&dMaxTaxPercentage, WEB_MAX_TAX_PERCENTAGE);
 
 		bInit = 1;
 	}
 
+	strcpy(r->web_class, "Unknown");
 	nullSet(&pT->kNullBitMap, WEB_NULLS);
 	r->web_site_sk = index;
 
@@ -143,11 +149,11 @@ mk_w_web_site (void *row, ds_key_t index)
 	genrand_integer (&r->web_market_id, DIST_UNIFORM, 1, 6, 0, WEB_MARKET_ID);
 	changeSCD(SCD_INT, &r->web_market_id, &rOldValues->web_market_id,  &nFieldChangeFlags,  bFirstRecord);
 
-	gen_text (r->web_market_class, 20, RS_WEB_MARKET_CLASS,
+	gen_text (pCtx, r->web_market_class, 20, RS_WEB_MARKET_CLASS,
 		WEB_MARKET_CLASS);
 	changeSCD(SCD_CHAR, &r->web_market_class, &rOldValues->web_market_class,  &nFieldChangeFlags,  bFirstRecord);
 
-	gen_text (r->web_market_desc, 20, RS_WEB_MARKET_DESC,
+	gen_text (pCtx, r->web_market_desc, 20, RS_WEB_MARKET_DESC,
 		WEB_MARKET_DESC);
 	changeSCD(SCD_CHAR, &r->web_market_desc, &rOldValues->web_market_desc,  &nFieldChangeFlags,  bFirstRecord);
 
@@ -270,6 +276,6 @@ ld_w_web_site(void *pSrc)
 	else
 		r = pSrc;
 	
-	return(0);
+	return(pr_w_web_site(r));
 }
 
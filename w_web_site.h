@@ -37,6 +37,7 @@
 #define W_WEB_SITE_H
 
 #include "decimal.h"
+#include "context.h"
 
 #define WEB_MIN_TAX_PERCENTAGE	"0.00"
 #define WEB_MAX_TAX_PERCENTAGE	"0.12"
@@ -65,7 +66,7 @@ struct W_WEB_SITE_TBL {
 	decimal_t	web_tax_percentage;
 	};
 
-int mk_w_web_site(void *pDest, ds_key_t kIndex);
+int mk_w_web_site(gen_ctx_t *pCtx, void *pDest, ds_key_t kIndex);
 int pr_w_web_site(void *pSrc);
 int ld_w_web_site(void *pSrc);
 #endif